@@ -0,0 +1,84 @@
+#pragma once
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <elf.h>
+#include <unistd.h>
+
+namespace FEXCore::ELF {
+  // Finds the NT_GNU_BUILD_ID note in the contents of a PT_NOTE segment and returns its descriptor as hex.
+  // Returns an empty string if there is none, or if the notes run past the end of the segment before one is found.
+  [[maybe_unused]] static fextl::string ParseBuildIdNote(const uint8_t *Notes, size_t Size, size_t Alignment) {
+    // Elf32_Nhdr and Elf64_Nhdr have the same layout
+    size_t Offset = 0;
+    while (Offset + sizeof(Elf64_Nhdr) <= Size) {
+      Elf64_Nhdr Note;
+      memcpy(&Note, &Notes[Offset], sizeof(Note));
+
+      // The descriptor and the next note are aligned within the segment, with 8 byte alignment that leaves no
+      // padding between the 12 byte header and a 4 byte name
+      const size_t NameOffset = Offset + sizeof(Note);
+      const size_t DescOffset = FEXCore::AlignUp(NameOffset + Note.n_namesz, Alignment);
+      const size_t NextOffset = FEXCore::AlignUp(DescOffset + Note.n_descsz, Alignment);
+      if (DescOffset + Note.n_descsz > Size) {
+        break;
+      }
+
+      if (Note.n_type == NT_GNU_BUILD_ID && Note.n_namesz == 4 && memcmp(&Notes[NameOffset], "GNU", 4) == 0 &&
+          Note.n_descsz != 0) {
+        fextl::string BuildId;
+        for (size_t i = 0; i < Note.n_descsz; ++i) {
+          BuildId += fextl::fmt::format("{:02x}", Notes[DescOffset + i]);
+        }
+        return BuildId;
+      }
+
+      Offset = NextOffset;
+    }
+
+    return {};
+  }
+
+  // Reads the build-id from the program headers of an ELF file of the given class.
+  // Returns an empty string if the file has no build-id or its headers are truncated or malformed.
+  template<typename ElfEhdr, typename ElfPhdr>
+  static fextl::string GetBuildId(int fd) {
+    // Note segments are tiny, anything bigger isn't worth reading
+    constexpr size_t MaxNoteSegmentSize = 64 * 1024;
+
+    ElfEhdr Header;
+    if (pread(fd, &Header, sizeof(Header), 0) != sizeof(Header) ||
+        Header.e_phentsize != sizeof(ElfPhdr)) {
+      return {};
+    }
+
+    fextl::vector<ElfPhdr> ProgramHeaders(Header.e_phnum);
+    const ssize_t ProgramHeadersSize = sizeof(ElfPhdr) * ProgramHeaders.size();
+    if (pread(fd, ProgramHeaders.data(), ProgramHeadersSize, Header.e_phoff) != ProgramHeadersSize) {
+      return {};
+    }
+
+    for (const auto &Phdr : ProgramHeaders) {
+      if (Phdr.p_type != PT_NOTE || Phdr.p_filesz > MaxNoteSegmentSize) {
+        continue;
+      }
+
+      fextl::vector<uint8_t> Notes(Phdr.p_filesz);
+      if (pread(fd, Notes.data(), Notes.size(), Phdr.p_offset) != static_cast<ssize_t>(Notes.size())) {
+        continue;
+      }
+
+      auto BuildId = ParseBuildIdNote(Notes.data(), Notes.size(), Phdr.p_align == 8 ? 8 : 4);
+      if (!BuildId.empty()) {
+        return BuildId;
+      }
+    }
+
+    return {};
+  }
+}
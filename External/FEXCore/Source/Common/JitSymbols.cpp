@@ -1,11 +1,143 @@
 #include <FEXCore/fextl/fmt.h>
+#include <FEXHeaderUtils/Syscalls.h>
 
 #include "Common/JitSymbols.h"
 
+#include <algorithm>
+#include <cstring>
 #include <fcntl.h>
+#include <iterator>
+#include <sched.h>
+#include <time.h>
 #include <unistd.h>
+#ifndef _WIN32
+#include <elf.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#endif
 
 namespace FEXCore {
+namespace {
+  // Longer names get truncated
+  constexpr size_t MaxNameLength = 1024;
+
+  // Records written to the jitdump file, see tools/perf/Documentation/jitdump-specification.txt in the Linux tree.
+  struct JITDumpHeader {
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t TotalSize;
+    uint32_t ElfMach;
+    uint32_t Pad1;
+    uint32_t Pid;
+    uint64_t Timestamp;
+    uint64_t Flags;
+  };
+
+  struct JITDumpCodeLoad {
+    uint32_t Id;
+    uint32_t TotalSize;
+    uint64_t Timestamp;
+    uint32_t Pid;
+    uint32_t Tid;
+    uint64_t VMA;
+    uint64_t CodeAddr;
+    uint64_t CodeSize;
+    uint64_t CodeIndex;
+  };
+
+  constexpr uint32_t JITDUMP_MAGIC = 0x4A695444;
+  constexpr uint32_t JITDUMP_VERSION = 1;
+  constexpr uint32_t JIT_CODE_LOAD = 0;
+
+  // perf needs to be told to use the same clock with `perf record -k mono`
+  uint64_t GetTimestamp() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1'000'000'000ULL + ts.tv_nsec;
+  }
+
+  struct WritePart {
+    const void *Data;
+    size_t Size;
+  };
+
+  void WriteParts(int &fd, const WritePart *Parts, size_t NumParts) {
+#ifndef _WIN32
+    iovec iov[4];
+    for (size_t i = 0; i < NumParts; ++i) {
+      iov[i] = { const_cast<void*>(Parts[i].Data), Parts[i].Size };
+    }
+    // A single writev so records from other threads can't interleave with this one.
+    auto Result = writev(fd, iov, NumParts);
+#else
+    auto Result = write(fd, Parts[0].Data, Parts[0].Size);
+#endif
+    if (Result == -1 && errno == EBADF) {
+      fd = -1;
+    }
+  }
+
+  void FlushStream(int &fd, JITSymbolBuffer::Stream *Stream) {
+    if (Stream->Offset && fd != -1) {
+      auto Result = write(fd, Stream->Data, Stream->Offset);
+      if (Result == -1 && errno == EBADF) {
+        fd = -1;
+      }
+    }
+
+    Stream->Offset = 0;
+    Stream->LastWrite = std::chrono::steady_clock::now();
+  }
+
+  class ScopedBufferLock final {
+  public:
+    explicit ScopedBufferLock(JITSymbolBuffer *Buffer)
+      : Buffer {Buffer} {
+      if (Buffer) {
+        while (Buffer->Lock.test_and_set(std::memory_order_acquire)) {
+          sched_yield();
+        }
+      }
+    }
+
+    ~ScopedBufferLock() {
+      if (Buffer) {
+        Buffer->Lock.clear(std::memory_order_release);
+      }
+    }
+
+  private:
+    JITSymbolBuffer *Buffer;
+  };
+
+  // Appends a record to the thread's buffer, falling back to writing it directly if there's no buffer or it doesn't fit.
+  void AppendRecord(int &fd, JITSymbolBuffer::Stream *Stream, const WritePart *Parts, size_t NumParts) {
+    size_t TotalSize = 0;
+    for (size_t i = 0; i < NumParts; ++i) {
+      TotalSize += Parts[i].Size;
+    }
+
+    if (Stream && TotalSize > JITSymbolBuffer::BUFFER_SIZE - Stream->Offset) {
+      FlushStream(fd, Stream);
+    }
+
+    if (!Stream || TotalSize > JITSymbolBuffer::BUFFER_SIZE) {
+      WriteParts(fd, Parts, NumParts);
+      return;
+    }
+
+    for (size_t i = 0; i < NumParts; ++i) {
+      memcpy(&Stream->Data[Stream->Offset], Parts[i].Data, Parts[i].Size);
+      Stream->Offset += Parts[i].Size;
+    }
+
+    if (Stream->Offset >= JITSymbolBuffer::FLUSH_THRESHOLD ||
+        std::chrono::steady_clock::now() - Stream->LastWrite >= JITSymbolBuffer::MAXIMUM_AGE) {
+      FlushStream(fd, Stream);
+    }
+  }
+}
+
   JITSymbols::JITSymbols() {
   }
 
@@ -13,77 +145,198 @@ namespace FEXCore {
     if (fd != -1) {
       close(fd);
     }
+
+    if (DumpFD != -1) {
+      close(DumpFD);
+    }
   }
 
-  void JITSymbols::InitFile() {
+  void JITSymbols::InitFile(bool JITDump) {
     // We can't use FILE here since we must be robust against forking processes closing our FD from under us.
 #ifdef __ANDROID__
     // Android simpleperf looks in /data/local/tmp instead of /tmp
-    const auto PerfMap = fextl::fmt::format("/data/local/tmp/perf-{}.map", getpid());
+    constexpr std::string_view PerfDirectory = "/data/local/tmp";
 #else
-    const auto PerfMap = fextl::fmt::format("/tmp/perf-{}.map", getpid());
+    constexpr std::string_view PerfDirectory = "/tmp";
 #endif
+    const auto PerfMap = fextl::fmt::format("{}/perf-{}.map", PerfDirectory, getpid());
     fd = open(PerfMap.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_APPEND, 0644);
+
+#ifndef _WIN32
+    if (!JITDump) {
+      return;
+    }
+
+    const auto DumpFile = fextl::fmt::format("{}/jit-{}.dump", PerfDirectory, getpid());
+    DumpFD = open(DumpFile.c_str(), O_CREAT | O_TRUNC | O_RDWR | O_APPEND, 0644);
+    if (DumpFD == -1) {
+      return;
+    }
+
+    const JITDumpHeader Header {
+      .Magic = JITDUMP_MAGIC,
+      .Version = JITDUMP_VERSION,
+      .TotalSize = sizeof(JITDumpHeader),
+#ifdef _M_ARM_64
+      .ElfMach = EM_AARCH64,
+#else
+      .ElfMach = EM_X86_64,
+#endif
+      .Pad1 = 0,
+      .Pid = static_cast<uint32_t>(getpid()),
+      .Timestamp = GetTimestamp(),
+      .Flags = 0,
+    };
+
+    if (write(DumpFD, &Header, sizeof(Header)) != sizeof(Header)) {
+      close(DumpFD);
+      DumpFD = -1;
+      return;
+    }
+
+    // perf record only picks up the jitdump file through an executable mapping of it.
+    // The mapping is left in place for the lifetime of the process.
+    if (mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, DumpFD, 0) == MAP_FAILED) {
+      close(DumpFD);
+      DumpFD = -1;
+    }
+#endif
   }
 
-  void JITSymbols::Register(const void *HostAddr, uint64_t GuestAddr, uint32_t CodeSize) {
-    if (fd == -1) return;
+  template<typename... Args>
+  void JITSymbols::RegisterFormatted(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, fmt::format_string<Args...> Format, Args&&... args) {
+    char Name[MaxNameLength];
+    const auto Result = fmt::format_to_n(Name, sizeof(Name), Format, std::forward<Args>(args)...);
+    const std::string_view NameView (Name, std::min<size_t>(Result.size, sizeof(Name)));
+
+    ScopedBufferLock lk(Buffer);
+    if (Buffer) {
+      Buffer->Pending.store(true, std::memory_order_relaxed);
+    }
 
+    if (fd != -1) {
+      WritePerfMap(Buffer, HostAddr, CodeSize, NameView);
+    }
+
+    if (DumpFD != -1) {
+      WriteJITDump(Buffer, HostAddr, CodeSize, NameView);
+    }
+  }
+
+  void JITSymbols::WritePerfMap(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name) {
     // Linux perf format is very straightforward
     // `<HostPtr> <Size> <Name>\n`
-    const auto Buffer = fextl::fmt::format("{} {:x} JIT_0x{:x}_{}\n", HostAddr, CodeSize, GuestAddr, HostAddr);
-    auto Result = write(fd, Buffer.c_str(), Buffer.size());
-    if (Result == -1 && errno == EBADF) {
-      fd = -1;
-    }
+    char Line[MaxNameLength + 64];
+    const auto Result = fmt::format_to_n(Line, sizeof(Line) - 1, "{} {:x} {}", HostAddr, CodeSize, Name);
+    const size_t Length = std::min<size_t>(Result.size, sizeof(Line) - 1);
+    Line[Length] = '\n';
+
+    const WritePart Parts[] = {{Line, Length + 1}};
+    AppendRecord(fd, Buffer ? &Buffer->PerfMap : nullptr, Parts, std::size(Parts));
+  }
+
+  void JITSymbols::WriteJITDump(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name) {
+    const JITDumpCodeLoad Record {
+      .Id = JIT_CODE_LOAD,
+      .TotalSize = static_cast<uint32_t>(sizeof(JITDumpCodeLoad) + Name.size() + 1 + CodeSize),
+      .Timestamp = GetTimestamp(),
+      .Pid = static_cast<uint32_t>(getpid()),
+      .Tid = static_cast<uint32_t>(FHU::Syscalls::gettid()),
+      .VMA = reinterpret_cast<uint64_t>(HostAddr),
+      .CodeAddr = reinterpret_cast<uint64_t>(HostAddr),
+      .CodeSize = CodeSize,
+      .CodeIndex = DumpCodeIndex.fetch_add(1, std::memory_order_relaxed),
+    };
+
+    // perf inject copies the code out of the record to build an ELF image for each symbol
+    const char Terminator = '\0';
+    const WritePart Parts[] = {
+      {&Record, sizeof(Record)},
+      {Name.data(), Name.size()},
+      {&Terminator, 1},
+      {HostAddr, CodeSize},
+    };
+    AppendRecord(DumpFD, Buffer ? &Buffer->JITDump : nullptr, Parts, std::size(Parts));
   }
 
-  void JITSymbols::Register(const void *HostAddr, uint32_t CodeSize, std::string_view Name) {
+  void JITSymbols::Register(JITSymbolBuffer *Buffer, const void *HostAddr, uint64_t GuestAddr, uint32_t CodeSize) {
     if (fd == -1) return;
 
-    // Linux perf format is very straightforward
-    // `<HostPtr> <Size> <Name>\n`
-    const auto Buffer = fextl::fmt::format("{} {:x} {}_{}\n", HostAddr, CodeSize, Name, HostAddr);
-    auto Result = write(fd, Buffer.c_str(), Buffer.size());
-    if (Result == -1 && errno == EBADF) {
-      fd = -1;
-    }
+    RegisterFormatted(Buffer, HostAddr, CodeSize, "JIT_0x{:x}_{}", GuestAddr, HostAddr);
   }
 
-  void JITSymbols::Register(const void *HostAddr, uint32_t CodeSize, std::string_view Name, uintptr_t Offset) {
+  void JITSymbols::Register(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name) {
     if (fd == -1) return;
 
-    // Linux perf format is very straightforward
-    // `<HostPtr> <Size> <Name>\n`
-    const auto Buffer = fextl::fmt::format("{} {:x} {}+0x{:x} ({})\n", HostAddr, CodeSize, Name, Offset, HostAddr);
-    auto Result = write(fd, Buffer.c_str(), Buffer.size());
-    if (Result == -1 && errno == EBADF) {
-      fd = -1;
-    }
+    RegisterFormatted(Buffer, HostAddr, CodeSize, "{}_{}", Name, HostAddr);
   }
 
-  void JITSymbols::RegisterNamedRegion(const void *HostAddr, uint32_t CodeSize, std::string_view Name) {
+  void JITSymbols::Register(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name, uintptr_t Offset) {
     if (fd == -1) return;
 
-    // Linux perf format is very straightforward
-    // `<HostPtr> <Size> <Name>\n`
-    const auto Buffer = fextl::fmt::format("{} {:x} {}\n", HostAddr, CodeSize, Name);
-    auto Result = write(fd, Buffer.c_str(), Buffer.size());
-    if (Result == -1 && errno == EBADF) {
-      fd = -1;
-    }
+    RegisterFormatted(Buffer, HostAddr, CodeSize, "{}+0x{:x} ({})", Name, Offset, HostAddr);
+  }
+
+  void JITSymbols::Register(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name, std::string_view Symbol, uintptr_t SymbolOffset) {
+    if (fd == -1) return;
+
+    RegisterFormatted(Buffer, HostAddr, CodeSize, "{}+0x{:x} [{}] ({})", Symbol, SymbolOffset, Name, HostAddr);
+  }
+
+  void JITSymbols::RegisterNamedRegion(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name) {
+    if (fd == -1) return;
+
+    RegisterFormatted(Buffer, HostAddr, CodeSize, "{}", Name);
   }
 
   void JITSymbols::RegisterJITSpace(const void *HostAddr, uint32_t CodeSize) {
     if (fd == -1) return;
 
-    // Linux perf format is very straightforward
-    // `<HostPtr> <Size> <Name>\n`
-    const auto Buffer = fextl::fmt::format("{} {:x} FEXJIT\n", HostAddr, CodeSize);
-    auto Result = write(fd, Buffer.c_str(), Buffer.size());
-    if (Result == -1 && errno == EBADF) {
-      fd = -1;
+    // Only goes to the perf map, the JIT space has no code to dump yet
+    WritePerfMap(nullptr, HostAddr, CodeSize, "FEXJIT");
+  }
+
+  void JITSymbols::Flush(JITSymbolBuffer *Buffer) {
+    ScopedBufferLock lk(Buffer);
+    FlushStream(fd, &Buffer->PerfMap);
+    FlushStream(DumpFD, &Buffer->JITDump);
+    Buffer->Pending.store(false, std::memory_order_relaxed);
+  }
+
+  void JITSymbols::TryFlush(JITSymbolBuffer *Buffer) {
+    // The interrupted thread may be in the middle of appending a record
+    if (Buffer->Lock.test_and_set(std::memory_order_acquire)) {
+      return;
     }
+
+    FlushStream(fd, &Buffer->PerfMap);
+    FlushStream(DumpFD, &Buffer->JITDump);
+    Buffer->Pending.store(false, std::memory_order_relaxed);
+    Buffer->Lock.clear(std::memory_order_release);
+  }
+
+  void JITSymbols::FlushIfStale(JITSymbolBuffer *Buffer) {
+    if (!Buffer->Pending.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    // Appending only checks the age when the next record comes in, which may be never
+    ScopedBufferLock lk(Buffer);
+    const auto Now = std::chrono::steady_clock::now();
+    if (Now - Buffer->PerfMap.LastWrite >= JITSymbolBuffer::MAXIMUM_AGE ||
+        Now - Buffer->JITDump.LastWrite >= JITSymbolBuffer::MAXIMUM_AGE) {
+      FlushStream(fd, &Buffer->PerfMap);
+      FlushStream(DumpFD, &Buffer->JITDump);
+      Buffer->Pending.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  void JITSymbols::DiscardAfterFork(JITSymbolBuffer *Buffer) {
+    // Another thread may have been flushing it during the fork, that thread doesn't exist in the child
+    Buffer->Lock.clear(std::memory_order_release);
+    Buffer->PerfMap.Offset = 0;
+    Buffer->JITDump.Offset = 0;
+    Buffer->Pending.store(false, std::memory_order_relaxed);
   }
 
 } // namespace FEXCore
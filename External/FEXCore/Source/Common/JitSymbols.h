@@ -1,24 +1,71 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <memory>
 #include <string_view>
 
+#include <fmt/format.h>
+
 namespace FEXCore {
+// Per-thread buffer for symbol records.
+// Batches the records of many blocks in to a single write instead of a syscall per block.
+struct JITSymbolBuffer {
+  static constexpr size_t BUFFER_SIZE = 16384;
+  // Flushes once the buffer is filled past this point
+  static constexpr size_t FLUSH_THRESHOLD = BUFFER_SIZE - 4096;
+  // Flushes at least this often so profilers see the symbols of long running threads
+  static constexpr std::chrono::seconds MAXIMUM_AGE {1};
+
+  struct Stream {
+    std::chrono::steady_clock::time_point LastWrite{};
+    size_t Offset{};
+    char Data[BUFFER_SIZE];
+  };
+
+  Stream PerfMap;
+  Stream JITDump;
+  // Records are waiting in either stream
+  std::atomic<bool> Pending{};
+  // Held while the buffer is written to, other threads flush it on exec and crashes
+  std::atomic_flag Lock = ATOMIC_FLAG_INIT;
+};
+
 class JITSymbols final {
 public:
   JITSymbols();
   ~JITSymbols();
 
-  void InitFile();
-  void Register(const void *HostAddr, uint64_t GuestAddr, uint32_t CodeSize);
-  void Register(const void *HostAddr, uint32_t CodeSize, std::string_view Name);
-  void Register(const void *HostAddr, uint32_t CodeSize, std::string_view Name, uintptr_t Offset);
-  void RegisterNamedRegion(const void *HostAddr, uint32_t CodeSize, std::string_view Name);
+  void InitFile(bool JITDump);
+
+  // Buffer can be nullptr, in which case the record is written immediately
+  void Register(JITSymbolBuffer *Buffer, const void *HostAddr, uint64_t GuestAddr, uint32_t CodeSize);
+  void Register(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name);
+  void Register(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name, uintptr_t Offset);
+  void Register(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name, std::string_view Symbol, uintptr_t SymbolOffset);
+  void RegisterNamedRegion(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name);
   void RegisterJITSpace(const void *HostAddr, uint32_t CodeSize);
 
+  // Writes out everything the thread has buffered
+  void Flush(JITSymbolBuffer *Buffer);
+  // Same as Flush but gives up if the buffer is in use, for signal handlers
+  void TryFlush(JITSymbolBuffer *Buffer);
+  // Flushes records that are older than MAXIMUM_AGE, cheap when nothing is buffered
+  void FlushIfStale(JITSymbolBuffer *Buffer);
+  // The records in a forked child's buffer belong to the parent, which still writes them out
+  void DiscardAfterFork(JITSymbolBuffer *Buffer);
+
 private:
   int fd{-1};
+  // perf jitdump file, -1 if disabled
+  int DumpFD{-1};
+  std::atomic<uint64_t> DumpCodeIndex{};
+
+  template<typename... Args>
+  void RegisterFormatted(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, fmt::format_string<Args...> Format, Args&&... args);
+  void WritePerfMap(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name);
+  void WriteJITDump(JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name);
 };
 }
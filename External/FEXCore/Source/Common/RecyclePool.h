@@ -0,0 +1,82 @@
+#pragma once
+
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace FEXCore {
+
+// Keeps up to `MaxEntries` allocations that are expensive to recreate, shared between threads.
+// Only ever try-locked so a thread that died holding it across a fork can't deadlock the child.
+// A contended pool acts as if it were full when recycling and empty when taking.
+template<typename T, size_t MaxEntries>
+class RecyclePool final {
+public:
+  /**
+   * @brief Hands an entry to the pool
+   *
+   * @return false if the pool is full or contended, `Entry` is left untouched and the caller needs to free it
+   */
+  bool Recycle(T &&Entry) {
+    std::unique_lock lk(Mutex, std::try_to_lock);
+    if (!lk.owns_lock() || Entries.size() >= MaxEntries) {
+      return false;
+    }
+
+    Entries.emplace_back(std::move(Entry));
+    return true;
+  }
+
+  /**
+   * @brief Takes the first entry that `Pred` accepts out of the pool
+   *
+   * @return std::nullopt if no entry was accepted or the pool is contended
+   */
+  template<typename Predicate>
+  std::optional<T> Take(Predicate Pred) {
+    std::unique_lock lk(Mutex, std::try_to_lock);
+    if (!lk.owns_lock()) {
+      return std::nullopt;
+    }
+
+    auto It = std::find_if(Entries.begin(), Entries.end(), Pred);
+    if (It == Entries.end()) {
+      return std::nullopt;
+    }
+
+    std::optional<T> Entry {std::move(*It)};
+    Entries.erase(It);
+    return Entry;
+  }
+
+  std::optional<T> Take() {
+    return Take([](const T&) { return true; });
+  }
+
+  /**
+   * @brief Empties the pool, handing every entry to `Free`
+   *
+   * Only safe once nothing else can use the pool.
+   */
+  template<typename FreeFunc>
+  void Clear(FreeFunc Free) {
+    for (auto &Entry : Entries) {
+      Free(Entry);
+    }
+    Entries.clear();
+  }
+
+  size_t Size() const {
+    return Entries.size();
+  }
+
+private:
+  std::mutex Mutex;
+  fextl::vector<T> Entries;
+};
+
+}
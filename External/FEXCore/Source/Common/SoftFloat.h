@@ -5,6 +5,7 @@
 #include <FEXCore/fextl/sstream.h>
 #include <FEXCore/fextl/string.h>
 
+#include <bit>
 #include <cmath>
 #include <cstring>
 #include <stdint.h>
@@ -61,6 +62,144 @@ struct FEX_PACKED X80SoftFloat {
     return string.str();
   }
 
+  // Fast paths for the common case of normal operands under the default x87 control word.
+  // The exact result is computed with 128-bit integer arithmetic then rounded the same way SoftFloat rounds it.
+  // Anything else (zeroes, denormals, unnormals, infinities, NaNs, results that over or underflow,
+  // non-default rounding or precision control) is left to SoftFloat.
+  // Exception flags aren't raised, nothing consumes softfloat_exceptionFlags.
+  // The transcendental ops (FSIN, FYL2X and the like) don't have one. They go through libm at LIBRARY_PRECISION,
+  // which doesn't match x87 bit for bit, so there is no reference a faster approximation could be checked against.
+  static bool IsFastPathNormal(X80SoftFloat const &val) {
+    // Requiring the explicit integer bit also excludes unnormals
+    return val.Exponent != 0 && val.Exponent != 0x7FFF && (val.Significand >> 63);
+  }
+
+  static bool CanUseFastPath(X80SoftFloat const &lhs, X80SoftFloat const &rhs) {
+    return softfloat_roundingMode == softfloat_round_near_even &&
+           extF80_roundingPrecision == 80 &&
+           IsFastPathNormal(lhs) && IsFastPathNormal(rhs);
+  }
+
+  // Rounds Significand with the bits below it in Extra to nearest even.
+  // Returns false if the result isn't a normal number.
+  static bool FastPathRoundAndPack(uint16_t Sign, int32_t Exponent, uint64_t Significand, uint64_t Extra, X80SoftFloat *Result) {
+    if (Exponent <= 0 || Exponent >= 0x7FFF) {
+      return false;
+    }
+
+    constexpr uint64_t Half = 1ULL << 63;
+    if (Extra > Half || (Extra == Half && (Significand & 1))) {
+      ++Significand;
+      if (Significand == 0) {
+        // Rounded up to the next power of two
+        Significand = Half;
+        ++Exponent;
+        if (Exponent >= 0x7FFF) {
+          return false;
+        }
+      }
+    }
+
+    *Result = X80SoftFloat(Sign, Exponent, Significand);
+    return true;
+  }
+
+  static bool FastPathAdd(X80SoftFloat const &lhs, X80SoftFloat const &rhs, bool Subtract, X80SoftFloat *Result) {
+    if (!CanUseFastPath(lhs, rhs)) {
+      return false;
+    }
+
+    const uint16_t RHSSign = rhs.Sign ^ Subtract;
+
+    // Order by magnitude so the larger operand is the one being aligned against
+    const bool Swap = rhs.Exponent > lhs.Exponent || (rhs.Exponent == lhs.Exponent && rhs.Significand > lhs.Significand);
+    X80SoftFloat const &Large = Swap ? rhs : lhs;
+    X80SoftFloat const &Small = Swap ? lhs : rhs;
+    const uint16_t Sign = Swap ? RHSSign : lhs.Sign;
+
+    // Beyond this the smaller operand doesn't fit in the 128-bit window and would need a sticky bit
+    const uint32_t ExponentDiff = Large.Exponent - Small.Exponent;
+    if (ExponentDiff > 63) {
+      return false;
+    }
+
+    // Leading bit of the larger operand lands at bit 126, leaving room for the carry out
+    const unsigned __int128 LargeSig = static_cast<unsigned __int128>(Large.Significand) << 63;
+    const unsigned __int128 SmallSig = (static_cast<unsigned __int128>(Small.Significand) << 63) >> ExponentDiff;
+
+    if (lhs.Sign == RHSSign) {
+      const unsigned __int128 Sum = LargeSig + SmallSig;
+      if (Sum >> 127) {
+        return FastPathRoundAndPack(Sign, Large.Exponent + 1, static_cast<uint64_t>(Sum >> 64), static_cast<uint64_t>(Sum), Result);
+      }
+
+      return FastPathRoundAndPack(Sign, Large.Exponent, static_cast<uint64_t>(Sum >> 63), static_cast<uint64_t>(Sum << 1), Result);
+    }
+
+    if (LargeSig == SmallSig) {
+      // Exact cancellation, the sign of the zero depends on the rounding mode
+      return false;
+    }
+
+    unsigned __int128 Diff = LargeSig - SmallSig;
+    const uint64_t High = Diff >> 64;
+    const int LeadingZeros = High ? std::countl_zero(High) : 64 + std::countl_zero(static_cast<uint64_t>(Diff));
+
+    // Normalize the leading bit back to bit 126, this is exact since it only shifts left
+    const int Shift = LeadingZeros - 1;
+    Diff <<= Shift;
+    return FastPathRoundAndPack(Sign, static_cast<int32_t>(Large.Exponent) - Shift, static_cast<uint64_t>(Diff >> 63), static_cast<uint64_t>(Diff << 1), Result);
+  }
+
+  static bool FastPathMul(X80SoftFloat const &lhs, X80SoftFloat const &rhs, X80SoftFloat *Result) {
+    if (!CanUseFastPath(lhs, rhs)) {
+      return false;
+    }
+
+    const uint16_t Sign = lhs.Sign ^ rhs.Sign;
+    const int32_t Exponent = static_cast<int32_t>(lhs.Exponent) + rhs.Exponent - 0x3FFF;
+
+    // Product of two normalized significands is in [2^126, 2^128)
+    const unsigned __int128 Product = static_cast<unsigned __int128>(lhs.Significand) * rhs.Significand;
+    if (Product >> 127) {
+      return FastPathRoundAndPack(Sign, Exponent + 1, static_cast<uint64_t>(Product >> 64), static_cast<uint64_t>(Product), Result);
+    }
+
+    return FastPathRoundAndPack(Sign, Exponent, static_cast<uint64_t>(Product >> 63), static_cast<uint64_t>(Product << 1), Result);
+  }
+
+  static bool FastPathDiv(X80SoftFloat const &lhs, X80SoftFloat const &rhs, X80SoftFloat *Result) {
+    if (!CanUseFastPath(lhs, rhs)) {
+      return false;
+    }
+
+    constexpr uint64_t Half = 1ULL << 63;
+    const uint16_t Sign = lhs.Sign ^ rhs.Sign;
+    int32_t Exponent = static_cast<int32_t>(lhs.Exponent) - rhs.Exponent + 0x3FFF;
+
+    // Quotient of two normalized significands scaled by 2^64 is in (2^63, 2^65)
+    const unsigned __int128 Dividend = static_cast<unsigned __int128>(lhs.Significand) << 64;
+    unsigned __int128 Quotient = Dividend / rhs.Significand;
+    const uint64_t Remainder = Dividend % rhs.Significand;
+
+    uint64_t Extra;
+    if (Quotient >> 64) {
+      // Lowest quotient bit is the rounding bit and the remainder is sticky
+      Extra = (static_cast<uint64_t>(Quotient) << 63) | (Remainder != 0);
+      Quotient >>= 1;
+    }
+    else {
+      // Twice the remainder against the divisor gives the rounding bit
+      const unsigned __int128 TwiceRemainder = static_cast<unsigned __int128>(Remainder) << 1;
+      Extra = TwiceRemainder > rhs.Significand ? Half + 1 :
+              TwiceRemainder == rhs.Significand ? Half :
+              (Remainder != 0);
+      --Exponent;
+    }
+
+    return FastPathRoundAndPack(Sign, Exponent, static_cast<uint64_t>(Quotient), Extra, Result);
+  }
+
   // Ops
   static X80SoftFloat FADD(X80SoftFloat const &lhs, X80SoftFloat const &rhs) {
 #ifdef DEBUG_X86_FLOAT
@@ -79,6 +218,11 @@ struct FEX_PACKED X80SoftFloat {
 
     return Result;
 #else
+    X80SoftFloat Result;
+    if (FastPathAdd(lhs, rhs, false, &Result)) {
+      return Result;
+    }
+
     return extF80_add(lhs, rhs);
 #endif
   }
@@ -100,6 +244,11 @@ struct FEX_PACKED X80SoftFloat {
 
     return Result;
 #else
+    X80SoftFloat Result;
+    if (FastPathAdd(lhs, rhs, true, &Result)) {
+      return Result;
+    }
+
     return extF80_sub(lhs, rhs);
 #endif
   }
@@ -121,6 +270,11 @@ struct FEX_PACKED X80SoftFloat {
 
     return Result;
 #else
+    X80SoftFloat Result;
+    if (FastPathMul(lhs, rhs, &Result)) {
+      return Result;
+    }
+
     return extF80_mul(lhs, rhs);
 #endif
   }
@@ -142,6 +296,11 @@ struct FEX_PACKED X80SoftFloat {
 
     return Result;
 #else
+    X80SoftFloat Result;
+    if (FastPathDiv(lhs, rhs, &Result)) {
+      return Result;
+    }
+
     return extF80_div(lhs, rhs);
 #endif
   }
@@ -360,6 +360,20 @@ namespace DefaultValues {
       }
     }
 
+    if (FEXCore::Config::Exists(FEXCore::Config::CONFIG_INTERPRETERTIERTHRESHOLD)) {
+      FEX_CONFIG_OPT(Core, CORE);
+
+#ifdef INTERPRETER_ENABLED
+      constexpr bool InterpreterAvailable = true;
+#else
+      constexpr bool InterpreterAvailable = false;
+#endif
+      if (!InterpreterAvailable || Core() != FEXCore::Config::CONFIG_IRJIT) {
+        // The interpreter tier only exists underneath the JIT
+        FEXCore::Config::Erase(FEXCore::Config::CONFIG_INTERPRETERTIERTHRESHOLD);
+      }
+    }
+
     fextl::string ContainerPrefix { FindContainerPrefix() };
     auto ExpandPathIfExists = [&ContainerPrefix](FEXCore::Config::ConfigOption Config, fextl::string PathName) {
       auto NewPath = ExpandPath(ContainerPrefix, PathName);
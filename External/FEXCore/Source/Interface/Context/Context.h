@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/JitSymbols.h"
+#include "Common/RecyclePool.h"
 #include "Interface/Core/CPUID.h"
 #include "Interface/Core/X86HelperGen.h"
 #include "Interface/Core/ObjectCache/ObjectCacheService.h"
@@ -37,6 +38,7 @@ namespace FEXCore {
 class CodeLoader;
 class ThunkHandler;
 class GdbServer;
+class LookupCache;
 
 namespace CodeSerialize {
   class CodeObjectSerializeService;
@@ -59,6 +61,7 @@ struct SourcecodeMap;
 namespace FEXCore::IR {
   class RegisterAllocationData;
   class IRListView;
+  class PassManager;
 namespace Validation {
   class IRValidation;
 }
@@ -164,7 +167,7 @@ namespace FEXCore::Context {
       FEXCore::CPUID::XCRResults RunXCRFunction(uint32_t Function) override;
       FEXCore::CPUID::FunctionResults RunCPUIDFunctionName(uint32_t Function, uint32_t Leaf, uint32_t CPU) override;
 
-      FEXCore::IR::AOTIRCacheEntry *LoadAOTIRCacheEntry(const fextl::string& Name) override;
+      FEXCore::IR::AOTIRCacheEntry *LoadAOTIRCacheEntry(const fextl::string& Name, int fd) override;
       void UnloadAOTIRCacheEntry(FEXCore::IR::AOTIRCacheEntry *Entry) override;
 
       void SetAOTIRLoader(std::function<int(const fextl::string&)> CacheReader) override {
@@ -213,6 +216,7 @@ namespace FEXCore::Context {
       bool ValidateIRarser { false };
 
       FEX_CONFIG_OPT(Multiblock, MULTIBLOCK);
+      FEX_CONFIG_OPT(MultiblockEdgeThreshold, MULTIBLOCKEDGETHRESHOLD);
       FEX_CONFIG_OPT(SingleStepConfig, SINGLESTEP);
       FEX_CONFIG_OPT(GdbServer, GDBSERVER);
       FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
@@ -225,6 +229,7 @@ namespace FEXCore::Context {
       FEX_CONFIG_OPT(AOTIRLoad, AOTIRLOAD);
       FEX_CONFIG_OPT(SMCChecks, SMCCHECKS);
       FEX_CONFIG_OPT(Core, CORE);
+      FEX_CONFIG_OPT(InterpreterTierThreshold, INTERPRETERTIERTHRESHOLD);
       FEX_CONFIG_OPT(MaxInstPerBlock, MAXINST);
       FEX_CONFIG_OPT(RootFSPath, ROOTFS);
       FEX_CONFIG_OPT(ThunkHostLibsPath, THUNKHOSTLIBS);
@@ -235,7 +240,9 @@ namespace FEXCore::Context {
       FEX_CONFIG_OPT(GlobalJITNaming, GLOBALJITNAMING);
       FEX_CONFIG_OPT(LibraryJITNaming, LIBRARYJITNAMING);
       FEX_CONFIG_OPT(BlockJITNaming, BLOCKJITNAMING);
+      FEX_CONFIG_OPT(JITDump, JITDUMP);
       FEX_CONFIG_OPT(GDBSymbols, GDBSYMBOLS);
+      FEX_CONFIG_OPT(JITStatsFile, JITSTATSFILE);
       FEX_CONFIG_OPT(ParanoidTSO, PARANOIDTSO);
       FEX_CONFIG_OPT(CacheObjectCodeCompilation, CACHEOBJECTCODECOMPILATION);
       FEX_CONFIG_OPT(x87ReducedPrecision, X87REDUCEDPRECISION);
@@ -279,6 +286,21 @@ namespace FEXCore::Context {
 
     bool IsPaused() const { return !Running; }
     void WaitForThreadsToRun();
+
+    // Exited threads hand their code buffers back to the context so new threads can reuse the mappings.
+    /**
+     * @brief Takes a recycled code buffer of at least `Size` bytes
+     *
+     * @return true if `Buffer` was filled with a recycled buffer
+     */
+    bool TakeRecycledCodeBuffer(size_t Size, FEXCore::CPU::CPUBackend::CodeBuffer *Buffer);
+    /**
+     * @brief Hands a code buffer back to the context
+     *
+     * @return false if the buffer wasn't kept and the caller needs to free it
+     */
+    bool RecycleCodeBuffer(FEXCore::CPU::CPUBackend::CodeBuffer Buffer);
+
     void Stop(bool IgnoreCurrentThread);
     void WaitForIdle();
     void SignalThread(FEXCore::Core::InternalThreadState *Thread, FEXCore::Core::SignalEvent Event);
@@ -293,6 +315,14 @@ namespace FEXCore::Context {
     template<auto Fn>
     static uint64_t ThreadExitFunctionLink(FEXCore::Core::CpuStateFrame *Frame, uint64_t *record) {
       auto Thread = Frame->Thread;
+
+      if (static_cast<ContextImpl*>(Thread->CTX)->MultiblockEdgeProfileThreshold) {
+        // Exits of regions that are still being profiled stay unlinked so every taken edge is counted
+        if (auto HostCode = ProfileMultiblockExit(Frame, record)) {
+          return HostCode;
+        }
+      }
+
       ScopedDeferredSignalWithForkableSharedLock lk(static_cast<ContextImpl*>(Thread->CTX)->CodeInvalidationMutex, Thread);
 
       return Fn(Frame, record);
@@ -309,6 +339,23 @@ namespace FEXCore::Context {
       ThreadRemoveCodeEntry(Thread, GuestRIP);
     }
 
+    /**
+     * @brief Counts an exit taken out of a multiblock region that is having its branch targets profiled
+     *
+     * Once no new hot target has shown up for a while the region is removed, so it gets recompiled with its hot targets.
+     * Must be called from owning thread
+     *
+     * @return Where to continue without linking the exit, or 0 if the exit can be linked
+     */
+    static uint64_t ProfileMultiblockExit(FEXCore::Core::CpuStateFrame *Frame, uint64_t *record);
+
+    // Entries that never run in the interpreter tier, custom IR and the callback return trampoline
+    bool RequiresJIT(uint64_t GuestRIP);
+
+    // Called by the interpreter tier once a block has run enough times to be worth JIT compiling
+    // Must be called from owning thread
+    static void PromoteInterpretedBlock(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP);
+
     void RemoveCustomIREntrypoint(uintptr_t Entrypoint);
 
     struct GenerateIRResult {
@@ -318,8 +365,11 @@ namespace FEXCore::Context {
       uint64_t TotalInstructionsLength;
       uint64_t StartAddr;
       uint64_t Length;
+      // Only measured when JIT module stats are being collected
+      uint64_t FrontendMicroseconds;
+      uint64_t PassMicroseconds;
     };
-    [[nodiscard]] GenerateIRResult GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo);
+    [[nodiscard]] GenerateIRResult GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, FEXCore::IR::PassManager *Passes);
 
     struct CompileCodeResult {
       void* CompiledCode;
@@ -352,6 +402,20 @@ namespace FEXCore::Context {
 
     FEXCore::JITSymbols Symbols;
 
+    // Writes out symbols that threads have buffered for longer than JITSymbolBuffer::MAXIMUM_AGE.
+    // A thread that stopped compiling or is blocked would otherwise keep its last symbols forever.
+    // Only runs when symbols are enabled.
+    fextl::unique_ptr<FEXCore::Threads::Thread> SymbolFlushThread;
+    // Heap allocated so the child of a fork can abandon the one the dead flush thread was waiting on
+    fextl::unique_ptr<Event> SymbolFlushWake;
+    std::atomic<bool> SymbolFlushShuttingDown{};
+    // Held while flushing and across fork, so a fork never copies ThreadCreationMutex or a buffer locked by the flush thread
+    std::mutex SymbolFlushMutex;
+
+    void StartSymbolFlushThread();
+    void StopSymbolFlushThread();
+    void SymbolFlushThreadFunc();
+
     void GetVDSOSigReturn(VDSOSigReturn *VDSOPointers) override {
       if (VDSOPointers->VDSO_kernel_sigreturn == nullptr) {
         VDSOPointers->VDSO_kernel_sigreturn = reinterpret_cast<void*>(X86CodeGen.sigreturn_32);
@@ -381,6 +445,22 @@ namespace FEXCore::Context {
 
     bool ExitOnHLTEnabled() const { return ExitOnHLT; }
 
+    void EnableCompileTimeStats() override { CompileTimeStatsEnabled = true; }
+
+    void WriteJITModuleStats() override;
+
+    void FlushJITSymbols(bool Blocking) override;
+
+    JITCodeStats GetJITCodeStats() const override {
+      return {
+        .BlocksCompiled = CodeStats.BlocksCompiled.load(std::memory_order_relaxed),
+        .GuestInstructions = CodeStats.GuestInstructions.load(std::memory_order_relaxed),
+        .GuestBytes = CodeStats.GuestBytes.load(std::memory_order_relaxed),
+        .HostCodeBytes = CodeStats.HostCodeBytes.load(std::memory_order_relaxed),
+        .CompileNanoseconds = CodeStats.CompileNanoseconds.load(std::memory_order_relaxed),
+      };
+    }
+
   protected:
     void ClearCodeCache(FEXCore::Core::InternalThreadState *Thread);
 
@@ -414,6 +494,11 @@ namespace FEXCore::Context {
      */
     void InitializeCompiler(FEXCore::Core::InternalThreadState* Thread);
 
+    /**
+     * @brief Keeps the thread's lookup cache for a future thread before the thread object is deleted
+     */
+    void RecycleThreadState(FEXCore::Core::InternalThreadState* Thread);
+
     void WaitForIdleWithTimeout();
 
     void NotifyPause();
@@ -425,6 +510,12 @@ namespace FEXCore::Context {
     fextl::unique_ptr<GdbServer> DebugServer;
 
     IR::AOTIRCaptureCache IRCaptureCache;
+
+    // Per-thread JIT allocations recycled from exited threads.
+    constexpr static size_t MAX_RECYCLED_THREAD_STATE = 16;
+    RecyclePool<FEXCore::CPU::CPUBackend::CodeBuffer, MAX_RECYCLED_THREAD_STATE> RecycledCodeBuffers;
+    RecyclePool<fextl::unique_ptr<FEXCore::LookupCache>, MAX_RECYCLED_THREAD_STATE> RecycledLookupCaches;
+
     fextl::unique_ptr<FEXCore::CodeSerialize::CodeObjectSerializeService> CodeObjectCacheService;
 
     bool StartPaused = false;
@@ -432,6 +523,44 @@ namespace FEXCore::Context {
     bool SupportsHardwareTSO = false;
     bool AtomicTSOEmulationEnabled = true;
     bool ExitOnHLT = false;
+
+    struct {
+      std::atomic<uint64_t> BlocksCompiled{};
+      std::atomic<uint64_t> GuestInstructions{};
+      std::atomic<uint64_t> GuestBytes{};
+      std::atomic<uint64_t> HostCodeBytes{};
+      std::atomic<uint64_t> CompileNanoseconds{};
+    } CodeStats;
+
+    // Per guest module compilation statistics, keyed by the module's filename.
+    // Only collected when JITStatsFile is set.
+    struct JITModuleStats {
+      uint64_t BlocksCompiled;
+      uint64_t GuestInstructions;
+      uint64_t GuestBytes;
+      uint64_t IRNodes;
+      uint64_t SpillSlots;
+      uint64_t HostCodeBytes;
+      uint64_t FrontendMicroseconds;
+      uint64_t PassMicroseconds;
+      uint64_t CodegenMicroseconds;
+      uint64_t AOTIRHits;
+      uint64_t ObjectCacheHits;
+    };
+
+    // Cold blocks run in the interpreter before being JIT compiled
+    bool InterpreterTierEnabled{};
+
+    // Number of times a multiblock region exit needs to be taken to join the region, 0 when regions aren't profiled
+    uint32_t MultiblockEdgeProfileThreshold{};
+
+    bool JITModuleStatsEnabled{};
+    bool CompileTimeStatsEnabled{};
+    std::mutex JITModuleStatsMutex;
+    fextl::unordered_map<fextl::string, JITModuleStats> ModuleStats;
+    std::atomic<uint64_t> CodeInvalidations{};
+
+    fextl::string GetJITStatsModule(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP);
     FEX_CONFIG_OPT(AppFilename, APP_FILENAME);
 
     std::shared_mutex CustomIRMutex;
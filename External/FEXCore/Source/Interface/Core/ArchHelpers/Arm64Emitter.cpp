@@ -182,6 +182,8 @@ Arm64Emitter::~Arm64Emitter() {
 void Arm64Emitter::LoadConstant(ARMEmitter::Size s, ARMEmitter::Register Reg, uint64_t Constant, bool NOPPad) {
   bool Is64Bit = s == ARMEmitter::Size::i64Bit;
   int Segments = Is64Bit ? 4 : 2;
+  // Padded to the requested size so a relocation can replace the constant with any other
+  const int PaddedSegments = Segments;
 
   if (Is64Bit && ((~Constant)>> 16) == 0) {
     movn(s, Reg, (~Constant) & 0xFFFF);
@@ -265,7 +267,7 @@ void Arm64Emitter::LoadConstant(ARMEmitter::Size s, ARMEmitter::Register Reg, ui
   }
 
   if (NOPPad) {
-    for (int i = NumMoves; i < Segments; ++i) {
+    for (int i = NumMoves; i < PaddedSegments; ++i) {
       nop();
     }
   }
@@ -497,12 +499,12 @@ void Arm64Emitter::FillStaticRegs(bool FPRs, uint32_t GPRFillMask, uint32_t FPRF
   }
 }
 
-void Arm64Emitter::PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg) {
+void Arm64Emitter::PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg, bool FPRs) {
   const auto CanUseSVE = EmitterCTX->HostFeatures.SupportsAVX;
   const auto GPRSize = (ConfiguredDynamicRegisterBase.size() + 1) * Core::CPUState::GPR_REG_SIZE;
   const auto FPRRegSize = CanUseSVE ? Core::CPUState::XMM_AVX_REG_SIZE
                                     : Core::CPUState::XMM_SSE_REG_SIZE;
-  const auto FPRSize = GeneralFPRegisters.size() * FPRRegSize;
+  const auto FPRSize = FPRs ? GeneralFPRegisters.size() * FPRRegSize : 0;
   const uint64_t SPOffset = AlignUp(GPRSize + FPRSize, 16);
 
   sub(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, SPOffset);
@@ -510,7 +512,10 @@ void Arm64Emitter::PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg) {
   // rsp capable move
   add(ARMEmitter::Size::i64Bit, TmpReg, ARMEmitter::Reg::rsp, 0);
 
-  if (CanUseSVE) {
+  if (!FPRs) {
+    // Nothing to do
+  }
+  else if (CanUseSVE) {
     for (size_t i = 0; i < GeneralFPRegisters.size(); i += 4) {
       const auto Reg1 = GeneralFPRegisters[i];
       const auto Reg2 = GeneralFPRegisters[i + 1];
@@ -539,10 +544,13 @@ void Arm64Emitter::PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg) {
   str(ARMEmitter::XReg::lr, TmpReg, 0);
 }
 
-void Arm64Emitter::PopDynamicRegsAndLR() {
+void Arm64Emitter::PopDynamicRegsAndLR(bool FPRs) {
   const auto CanUseSVE = EmitterCTX->HostFeatures.SupportsAVX;
 
-  if (CanUseSVE) {
+  if (!FPRs) {
+    // Nothing to do
+  }
+  else if (CanUseSVE) {
     for (size_t i = 0; i < GeneralFPRegisters.size(); i += 4) {
       const auto Reg1 = GeneralFPRegisters[i];
       const auto Reg2 = GeneralFPRegisters[i + 1];
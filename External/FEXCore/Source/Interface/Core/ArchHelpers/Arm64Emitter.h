@@ -99,8 +99,9 @@ protected:
   // We can't guarantee only the lower 64bits are used so flush everything
   static constexpr uint32_t CALLER_FPR_MASK = ~0U;
 
-  void PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg);
-  void PopDynamicRegsAndLR();
+  // FPRs can be skipped when the callee is known to not touch any vector registers.
+  void PushDynamicRegsAndLR(FEXCore::ARMEmitter::Register TmpReg, bool FPRs = true);
+  void PopDynamicRegsAndLR(bool FPRs = true);
 
   void PushCalleeSavedRegisters();
   void PopCalleeSavedRegisters();
@@ -10,8 +10,11 @@ CPUBackend::CPUBackend(FEXCore::Core::InternalThreadState *ThreadState, size_t I
     : ThreadState(ThreadState), InitialCodeSize(InitialCodeSize), MaxCodeSize(MaxCodeSize) {}
 
 CPUBackend::~CPUBackend() {
+  auto CTX = static_cast<Context::ContextImpl*>(ThreadState->CTX);
   for (auto CodeBuffer : CodeBuffers) {
-    FreeCodeBuffer(CodeBuffer);
+    if (!CTX->RecycleCodeBuffer(CodeBuffer)) {
+      FreeCodeBuffer(CodeBuffer);
+    }
   }
   CodeBuffers.clear();
 }
@@ -56,6 +59,11 @@ auto CPUBackend::GetEmptyCodeBuffer() -> CodeBuffer * {
 
 auto CPUBackend::AllocateNewCodeBuffer(size_t Size) -> CodeBuffer {
   CodeBuffer Buffer;
+  if (static_cast<Context::ContextImpl*>(ThreadState->CTX)->TakeRecycledCodeBuffer(Size, &Buffer)) {
+    // Already registered for JIT naming when it was first allocated.
+    return Buffer;
+  }
+
   Buffer.Size = Size;
   Buffer.Ptr = static_cast<uint8_t *>(
       FEXCore::Allocator::VirtualAlloc(Buffer.Size, true));
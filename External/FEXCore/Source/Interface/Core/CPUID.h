@@ -54,6 +54,18 @@ public:
     return Function_Reserved(Leaf);
   }
 
+  // Returns true if the results of the function only depend on the function and leaf for the lifetime of the process.
+  // These can be folded in to the generated code instead of calling the handler.
+  bool DoesFunctionReportConstantData(uint32_t Function) const {
+    if (Function == 0x1AU) {
+      // Hybrid information reports if the current CPU is big or little
+      return !Hybrid;
+    }
+
+    // Per-CPU product name
+    return Function < 0x8000'0002U || Function > 0x8000'0004U;
+  }
+
   FEXCore::CPUID::FunctionResults RunFunctionName(uint32_t Function, uint32_t Leaf, uint32_t CPU) {
     if (Function == 0x8000'0002U)
       return Function_8000_0002h(Leaf, CPU % PerCPUData.size());
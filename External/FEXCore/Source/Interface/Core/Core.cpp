@@ -43,6 +43,7 @@ $end_info$
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/IR/RegisterAllocationData.h>
 #include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/AllocatorHooks.h>
 #include <FEXCore/Utils/Event.h>
 #include <FEXCore/Utils/File.h>
 #include <FEXCore/Utils/LogManager.h>
@@ -152,11 +153,14 @@ namespace FEXCore::Context {
         Config.GlobalJITNaming() ||
         Config.LibraryJITNaming()) {
       // Only initialize symbols file if enabled. Ensures we don't pollute /tmp with empty files.
-      Symbols.InitFile();
+      Symbols.InitFile(Config.JITDump());
+      StartSymbolFlushThread();
     }
 
     // Track atomic TSO emulation configuration.
     UpdateAtomicTSOEmulationConfig();
+
+    JITModuleStatsEnabled = !Config.JITStatsFile().empty();
   }
 
   ContextImpl::~ContextImpl() {
@@ -164,6 +168,8 @@ namespace FEXCore::Context {
       DestroyThread(ParentThread);
     }
 
+    StopSymbolFlushThread();
+
     {
       if (CodeObjectCacheService) {
         CodeObjectCacheService->Shutdown();
@@ -176,10 +182,19 @@ namespace FEXCore::Context {
       }
 
       for (auto &Thread : Threads) {
+        if (Thread->SymbolBuffer) {
+          Symbols.Flush(Thread->SymbolBuffer.get());
+        }
         delete Thread;
       }
       Threads.clear();
     }
+
+    // Nothing can recycle any more, release what the exited threads left behind.
+    RecycledCodeBuffers.Clear([](auto &Buffer) {
+      FEXCore::Allocator::VirtualFree(Buffer.Ptr, Buffer.Size);
+    });
+    RecycledLookupCaches.Clear([](auto &) {});
   }
 
   uint64_t ContextImpl::RestoreRIPFromHostPC(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) {
@@ -248,6 +263,22 @@ namespace FEXCore::Context {
 
     DispatcherConfig.StaticRegisterAllocation = Config.StaticRegisterAllocation && BackendFeatures.SupportsStaticRegisterAllocation;
 
+#ifdef INTERPRETER_ENABLED
+    // Config loading already rejected other cores if the tier is enabled
+    // AOT IR capture needs the JIT pipeline's IR for every block, so it always bypasses the tier
+    InterpreterTierEnabled = Config.Core == FEXCore::Config::CONFIG_IRJIT &&
+                             Config.InterpreterTierThreshold() != 0 &&
+                             !Config.AOTIRCapture() && !Config.AOTIRGenerate();
+#endif
+
+    // Only the JIT backends emit the region entry in their exit stubs for the linker to count against
+    // The AOTIR and object caches keep a region as it was first compiled, which would skip the profiled recompile
+    if (Config.Core == FEXCore::Config::CONFIG_IRJIT && Config.Multiblock &&
+        !Config.AOTIRCapture() && !Config.AOTIRGenerate() && !Config.AOTIRLoad() &&
+        Config.CacheObjectCodeCompilation() == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE) {
+      MultiblockEdgeProfileThreshold = Config.MultiblockEdgeThreshold();
+    }
+
 #if JIT_ARM64
     Dispatcher = FEXCore::CPU::Dispatcher::CreateArm64(this, DispatcherConfig);
 #elif JIT_X86_64
@@ -556,8 +587,16 @@ namespace FEXCore::Context {
   void ContextImpl::InitializeCompiler(FEXCore::Core::InternalThreadState* Thread) {
     Thread->OpDispatcher = fextl::make_unique<FEXCore::IR::OpDispatchBuilder>(this);
     Thread->OpDispatcher->SetMultiblock(Config.Multiblock);
-    Thread->LookupCache = fextl::make_unique<FEXCore::LookupCache>(this);
+    if (auto LookupCache = RecycledLookupCaches.Take()) {
+      Thread->LookupCache = std::move(*LookupCache);
+    }
+    else {
+      Thread->LookupCache = fextl::make_unique<FEXCore::LookupCache>(this);
+    }
     Thread->FrontendDecoder = fextl::make_unique<FEXCore::Frontend::Decoder>(this);
+    if (Config.BlockJITNaming() || Config.LibraryJITNaming()) {
+      Thread->SymbolBuffer = fextl::make_unique<FEXCore::JITSymbolBuffer>();
+    }
     Thread->PassManager = fextl::make_unique<FEXCore::IR::PassManager>();
     Thread->PassManager->RegisterExitHandler([this]() {
         Stop(false /* Ignore current thread */);
@@ -595,6 +634,20 @@ namespace FEXCore::Context {
       ERROR_AND_DIE_FMT("FEXCore has been compiled without a viable JIT core");
 #endif
 
+#ifdef INTERPRETER_ENABLED
+      if (InterpreterTierEnabled) {
+        // The interpreter can't consume inline constants or register allocated IR, so it gets its own pipeline
+        Thread->InterpreterPassManager = fextl::make_unique<FEXCore::IR::PassManager>();
+        Thread->InterpreterPassManager->RegisterExitHandler([this]() {
+            Stop(false /* Ignore current thread */);
+        });
+        Thread->InterpreterPassManager->AddDefaultPasses(this, false, false);
+        Thread->InterpreterPassManager->AddDefaultValidationPasses();
+        Thread->InterpreterPassManager->RegisterSyscallHandler(SyscallHandler);
+
+        Thread->InterpreterBackend = FEXCore::CPU::CreateInterpreterTierCore(this, Thread, Config.InterpreterTierThreshold());
+      }
+#endif
       break;
     case FEXCore::Config::CONFIG_CUSTOM:
       Thread->CPUBackend = CustomCPUFactory(this, Thread);
@@ -649,16 +702,57 @@ namespace FEXCore::Context {
       Thread->ExecutionThread->detach();
     }
 
+    if (Thread->SymbolBuffer) {
+      Symbols.Flush(Thread->SymbolBuffer.get());
+    }
+
     FEXCore::Allocator::VirtualFree(reinterpret_cast<void*>(Thread->CurrentFrame->State.DeferredSignalFaultAddress), 4096);
+    RecycleThreadState(Thread);
     delete Thread;
   }
 
+  void ContextImpl::RecycleThreadState(FEXCore::Core::InternalThreadState *Thread) {
+    if (!Thread->LookupCache) {
+      return;
+    }
+
+    // Reset before it's pooled, another thread can take it straight away
+    Thread->LookupCache->Reset();
+    RecycledLookupCaches.Recycle(std::move(Thread->LookupCache));
+  }
+
+  bool ContextImpl::TakeRecycledCodeBuffer(size_t Size, FEXCore::CPU::CPUBackend::CodeBuffer *Buffer) {
+    auto Recycled = RecycledCodeBuffers.Take([Size](auto &Recycled) {
+      return Recycled.Size >= Size;
+    });
+
+    if (!Recycled) {
+      return false;
+    }
+
+    *Buffer = *Recycled;
+    return true;
+  }
+
+  bool ContextImpl::RecycleCodeBuffer(FEXCore::CPU::CPUBackend::CodeBuffer Buffer) {
+    // Give the pages back to the kernel, the mapping is what's expensive to recreate.
+    // Done before it's pooled, another thread can take it and emit code into it straight away.
+    FEXCore::Allocator::VirtualDontNeed(Buffer.Ptr, Buffer.Size);
+    return RecycledCodeBuffers.Recycle(std::move(Buffer));
+  }
+
 #ifndef _WIN32
   void ContextImpl::UnlockAfterFork(FEXCore::Core::InternalThreadState *LiveThread, bool Child) {
     Allocator::UnlockAfterFork(LiveThread, Child);
 
+    SymbolFlushMutex.unlock();
+
     if (Child) {
       CodeInvalidationMutex.StealAndDropActiveLocks();
+      IRCaptureCache.AbandonCaptureAfterFork();
+      if (LiveThread->SymbolBuffer) {
+        Symbols.DiscardAfterFork(LiveThread->SymbolBuffer.get());
+      }
     }
     else {
       CodeInvalidationMutex.unlock();
@@ -701,9 +795,18 @@ namespace FEXCore::Context {
 
     // Clean up dead stacks
     FEXCore::Threads::Thread::CleanupAfterFork();
+
+    // The flush thread didn't survive the fork. Started again once the dead stacks are gone so its new stack isn't one of them.
+    if (SymbolFlushThread) {
+      // Destroying the old event could wait forever on the dead thread
+      (void)SymbolFlushWake.release();
+      SymbolFlushThread.reset();
+      StartSymbolFlushThread();
+    }
   }
 
   void ContextImpl::LockBeforeFork(FEXCore::Core::InternalThreadState *Thread) {
+    SymbolFlushMutex.lock();
     CodeInvalidationMutex.lock();
     Allocator::LockBeforeFork(Thread);
   }
@@ -725,6 +828,11 @@ namespace FEXCore::Context {
 
     Thread->LookupCache->ClearCache();
     Thread->CPUBackend->ClearCache();
+    if (Thread->InterpreterBackend) {
+      Thread->InterpreterBackend->ClearCache();
+    }
+    Thread->HotBlocks.clear();
+    Thread->RegionProfiles.clear();
     Thread->DebugStore.clear();
   }
 
@@ -779,7 +887,7 @@ namespace FEXCore::Context {
     }
   }
 
-  ContextImpl::GenerateIRResult ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo) {
+  ContextImpl::GenerateIRResult ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, FEXCore::IR::PassManager *Passes) {
     FEXCORE_PROFILE_SCOPED("GenerateIR");
 
     Thread->OpDispatcher->ReownOrClaimBuffer();
@@ -788,6 +896,7 @@ namespace FEXCore::Context {
     uint64_t TotalInstructions {0};
     uint64_t TotalInstructionsLength {0};
 
+    const auto FrontendStart = JITModuleStatsEnabled ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
 
     std::shared_lock lk(CustomIRMutex);
 
@@ -804,12 +913,71 @@ namespace FEXCore::Context {
 
       bool HadDispatchError {false};
 
+      // The interpreter tier counts entries of whole regions, so its regions leave out all of their branch targets.
+      // Every branch then enters a region of its own, which lets loops in the middle of a function prove hot.
+      const bool TierRegion = Thread->InterpreterPassManager && Passes == Thread->InterpreterPassManager.get();
+
+      // Profiled regions start out without any of their branch targets and are recompiled once with the hot ones
+      // Exits of the interpreter tier don't carry the region entry, so only regions compiled for the JIT are profiled
+      const bool ProfileRegion = MultiblockEdgeProfileThreshold && !TierRegion;
+      FEXCore::Core::MultiblockRegionProfile *Profile {};
+      fextl::set<uint64_t> HotTargets;
+      fextl::set<uint64_t> SideExitTargets;
+      if (TierRegion) {
+        Thread->FrontendDecoder->SetBranchProfile(&HotTargets, nullptr);
+      }
+      else if (ProfileRegion) {
+        auto Region = Thread->RegionProfiles.find(GuestRIP);
+        if (Region != Thread->RegionProfiles.end()) {
+          Profile = &Region->second;
+        }
+
+        if (Profile && Profile->Formed) {
+          // Follows the hot targets of the hot targets' own regions as well, so hot paths are compiled as one trace
+          fextl::vector<uint64_t> Worklist(Profile->HotTargets.begin(), Profile->HotTargets.end());
+          while (!Worklist.empty()) {
+            const uint64_t Target = Worklist.back();
+            Worklist.pop_back();
+
+            if (!HotTargets.insert(Target).second) {
+              continue;
+            }
+
+            auto TargetProfile = Thread->RegionProfiles.find(Target);
+            if (TargetProfile != Thread->RegionProfiles.end()) {
+              Worklist.insert(Worklist.end(), TargetProfile->second.HotTargets.begin(), TargetProfile->second.HotTargets.end());
+            }
+          }
+        }
+
+        Thread->FrontendDecoder->SetBranchProfile(&HotTargets, Profile && Profile->Formed ? nullptr : &SideExitTargets);
+      }
+
       Thread->FrontendDecoder->DecodeInstructionsAtEntry(GuestCode, GuestRIP, [Thread](uint64_t BlockEntry, uint64_t Start, uint64_t Length) {
         if (Thread->LookupCache->AddBlockExecutableRange(BlockEntry, Start, Length)) {
           static_cast<ContextImpl*>(Thread->CTX)->SyscallHandler->MarkGuestExecutableRange(Thread, Start, Length);
         }
       });
 
+      if (TierRegion) {
+        Thread->FrontendDecoder->SetBranchProfile(nullptr, nullptr);
+      }
+      else if (ProfileRegion) {
+        Thread->FrontendDecoder->SetBranchProfile(nullptr, nullptr);
+
+        // Regions without side exits have nothing to profile and don't get an entry
+        if (!SideExitTargets.empty()) {
+          if (!Profile) {
+            Profile = &Thread->RegionProfiles[GuestRIP];
+          }
+
+          // Counts are kept when the region is recompiled before it has formed
+          for (auto Target : SideExitTargets) {
+            Profile->SideExits.try_emplace(Target, 0);
+          }
+        }
+      }
+
       auto CodeBlocks = Thread->FrontendDecoder->GetDecodedBlocks();
 
       Thread->OpDispatcher->BeginFunction(GuestRIP, CodeBlocks);
@@ -836,6 +1004,10 @@ namespace FEXCore::Context {
           DecodedInfo = &Block.DecodedInstructions[i];
           bool IsLocked = DecodedInfo->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_LOCK;
 
+          if (Thread->OpDispatcher->CanFault(TableInfo, DecodedInfo)) {
+            Thread->OpDispatcher->StoreNZCV();
+          }
+
           if (ExtendedDebugInfo || Thread->OpDispatcher->CanHaveSideEffects(TableInfo, DecodedInfo)) {
             Thread->OpDispatcher->_GuestOpcode(Block.Entry + BlockInstructionsLength - GuestRIP);
           }
@@ -920,6 +1092,12 @@ namespace FEXCore::Context {
 
     IR::IREmitter *IREmitter = Thread->OpDispatcher.get();
 
+    uint64_t FrontendMicroseconds {};
+    uint64_t PassMicroseconds {};
+    if (JITModuleStatsEnabled) {
+      FrontendMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - FrontendStart).count();
+    }
+
     auto ShouldDump = static_cast<ContextImpl*>(Thread->CTX)->Config.DumpIR() != "no" || Thread->OpDispatcher->ShouldDumpIR();
     // Debug
     {
@@ -933,16 +1111,23 @@ namespace FEXCore::Context {
     }
 
     // Run the passmanager over the IR from the dispatcher
-    Thread->PassManager->Run(IREmitter);
+    if (JITModuleStatsEnabled) {
+      const auto PassStart = std::chrono::steady_clock::now();
+      Passes->Run(IREmitter);
+      PassMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - PassStart).count();
+    }
+    else {
+      Passes->Run(IREmitter);
+    }
 
     // Debug
     {
       if (ShouldDump) {
-        IRDumper(Thread, IREmitter, GuestRIP, Thread->PassManager->HasPass("RA") ? Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA")->GetAllocationData() : nullptr);
+        IRDumper(Thread, IREmitter, GuestRIP, Passes->HasPass("RA") ? Passes->GetPass<IR::RegisterAllocationPass>("RA")->GetAllocationData() : nullptr);
       }
     }
 
-    auto RAData = Thread->PassManager->HasPass("RA") ? Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA")->PullAllocationData() : nullptr;
+    auto RAData = Passes->HasPass("RA") ? Passes->GetPass<IR::RegisterAllocationPass>("RA")->PullAllocationData() : nullptr;
     auto IRList = IREmitter->CreateIRCopy();
 
     IREmitter->DelayedDisownBuffer();
@@ -954,9 +1139,167 @@ namespace FEXCore::Context {
       .TotalInstructionsLength = TotalInstructionsLength,
       .StartAddr = Thread->FrontendDecoder->DecodedMinAddress,
       .Length = Thread->FrontendDecoder->DecodedMaxAddress - Thread->FrontendDecoder->DecodedMinAddress,
+      .FrontendMicroseconds = FrontendMicroseconds,
+      .PassMicroseconds = PassMicroseconds,
     };
   }
 
+  fextl::string ContextImpl::GetJITStatsModule(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) {
+    // Code that isn't backed by a file mapping (JITs, anonymous memory) is lumped together
+    auto AOTIRCacheEntry = SyscallHandler->LookupAOTIRCacheEntry(Thread, GuestRIP);
+    if (AOTIRCacheEntry.Entry) {
+      return AOTIRCacheEntry.Entry->Filename;
+    }
+
+    return "<anonymous>";
+  }
+
+  void ContextImpl::StartSymbolFlushThread() {
+    SymbolFlushWake = fextl::make_unique<Event>();
+
+    // Guest signals are never delivered to this thread
+    uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+    SymbolFlushThread = FEXCore::Threads::Thread::Create([](void *Arg) -> void* {
+      static_cast<ContextImpl*>(Arg)->SymbolFlushThreadFunc();
+      return nullptr;
+    }, this);
+    FEXCore::Threads::SetSignalMask(OldMask);
+  }
+
+  void ContextImpl::StopSymbolFlushThread() {
+    if (!SymbolFlushThread) {
+      return;
+    }
+
+    SymbolFlushShuttingDown = true;
+    SymbolFlushWake->NotifyAll();
+
+    if (SymbolFlushThread->joinable()) {
+      SymbolFlushThread->join(nullptr);
+    }
+    SymbolFlushThread.reset();
+  }
+
+  void ContextImpl::SymbolFlushThreadFunc() {
+    FEXCore::Threads::SetThreadName("JITSymbolFlush\0");
+
+    while (!SymbolFlushShuttingDown.load()) {
+      SymbolFlushWake->WaitFor(JITSymbolBuffer::MAXIMUM_AGE);
+
+      std::scoped_lock lk(SymbolFlushMutex, ThreadCreationMutex);
+      for (auto &Thread : Threads) {
+        if (Thread->SymbolBuffer) {
+          Symbols.FlushIfStale(Thread->SymbolBuffer.get());
+        }
+      }
+    }
+  }
+
+  void ContextImpl::FlushJITSymbols(bool Blocking) {
+    std::unique_lock lk(ThreadCreationMutex, std::defer_lock);
+    if (Blocking) {
+      lk.lock();
+    } else if (!lk.try_lock()) {
+      return;
+    }
+
+    for (auto &Thread : Threads) {
+      if (!Thread->SymbolBuffer) {
+        continue;
+      }
+
+      if (Blocking) {
+        Symbols.Flush(Thread->SymbolBuffer.get());
+      } else {
+        Symbols.TryFlush(Thread->SymbolBuffer.get());
+      }
+    }
+  }
+
+  void ContextImpl::WriteJITModuleStats() {
+    if (!JITModuleStatsEnabled) {
+      return;
+    }
+
+    // Forked and exec'd guests all write their stats on exit, `{pid}` gives each process its own file
+    auto Filename = Config.JITStatsFile();
+    constexpr std::string_view PIDPlaceholder = "{pid}";
+    const auto PID = fextl::fmt::format("{}", ::getpid());
+    for (size_t Pos = Filename.find(PIDPlaceholder); Pos != fextl::string::npos; Pos = Filename.find(PIDPlaceholder, Pos + PID.size())) {
+      Filename.replace(Pos, PIDPlaceholder.size(), PID);
+    }
+
+    FEXCore::File::File FD(Filename.c_str(),
+      FEXCore::File::FileModes::WRITE |
+      FEXCore::File::FileModes::CREATE |
+      FEXCore::File::FileModes::TRUNCATE);
+
+    if (!FD.IsValid()) {
+      LogMan::Msg::EFmt("Couldn't open JIT stats file: {}", Filename);
+      return;
+    }
+
+    std::lock_guard lk(JITModuleStatsMutex);
+
+    // Sort by module so the output is stable between runs
+    fextl::vector<std::pair<fextl::string, JITModuleStats>> SortedStats(ModuleStats.begin(), ModuleStats.end());
+    std::sort(SortedStats.begin(), SortedStats.end(), [](auto const &a, auto const &b) {
+      return a.first < b.first;
+    });
+
+    fextl::fmt::print(FD, "{{\n  \"CodeInvalidations\": {},\n  \"Modules\": {{", CodeInvalidations.load(std::memory_order_relaxed));
+
+    bool First = true;
+    for (auto const &[Module, Stats] : SortedStats) {
+      // Filenames are the only strings that need escaping
+      fextl::string Escaped;
+      for (char c : Module) {
+        if (c == '"' || c == '\\') {
+          Escaped += '\\';
+          Escaped += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+          Escaped += fextl::fmt::format("\\u{:04x}", static_cast<uint32_t>(c));
+        }
+        else {
+          Escaped += c;
+        }
+      }
+
+      fextl::fmt::print(FD,
+        "{}\n    \"{}\": {{\n"
+        "      \"BlocksCompiled\": {},\n"
+        "      \"GuestInstructions\": {},\n"
+        "      \"GuestBytes\": {},\n"
+        "      \"IRNodes\": {},\n"
+        "      \"SpillSlots\": {},\n"
+        "      \"HostCodeBytes\": {},\n"
+        "      \"FrontendMicroseconds\": {},\n"
+        "      \"PassMicroseconds\": {},\n"
+        "      \"CodegenMicroseconds\": {},\n"
+        "      \"AOTIRHits\": {},\n"
+        "      \"ObjectCacheHits\": {}\n"
+        "    }}",
+        First ? "" : ",", Escaped,
+        Stats.BlocksCompiled, Stats.GuestInstructions, Stats.GuestBytes,
+        Stats.IRNodes, Stats.SpillSlots, Stats.HostCodeBytes,
+        Stats.FrontendMicroseconds, Stats.PassMicroseconds, Stats.CodegenMicroseconds,
+        Stats.AOTIRHits, Stats.ObjectCacheHits);
+      First = false;
+    }
+
+    fextl::fmt::print(FD, "\n  }}\n}}\n");
+  }
+
+  // Relocated blocks never went through the backend, rebuild what the JIT naming and GDB symbols need from the cached code.
+  // No relocations are attached, which keeps the block from being serialized again.
+  static FEXCore::Core::DebugData *CreateRelocatedDebugData(const CodeSerialize::CodeObjectFileSection *CodeObject) {
+    auto DebugData = new FEXCore::Core::DebugData();
+    DebugData->HostCodeSize = CodeObject->HostCodeSize;
+    DebugData->HostCodeEntryOffset = CodeObject->HostCodeEntryOffset;
+    return DebugData;
+  }
+
   ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) {
     FEXCore::IR::IRListView *IRList {};
     FEXCore::Core::DebugData *DebugData {};
@@ -971,10 +1314,16 @@ namespace FEXCore::Context {
       if (CodeCacheEntry) {
         auto CompiledCode = Thread->CPUBackend->RelocateJITObjectCode(GuestRIP, CodeCacheEntry);
         if (CompiledCode) {
+          if (JITModuleStatsEnabled) {
+            auto Module = GetJITStatsModule(Thread, GuestRIP);
+            std::lock_guard lk(JITModuleStatsMutex);
+            ++ModuleStats[Module].ObjectCacheHits;
+          }
+
           return {
               .CompiledCode = CompiledCode,
               .IRData = nullptr,    // No IR data generated
-              .DebugData = nullptr, // nullptr here ensures that code serialization doesn't occur on from cache read
+              .DebugData = CreateRelocatedDebugData(CodeCacheEntry),
               .RAData = nullptr,    // No RA data generated
               .GeneratedIR = false, // nullptr here ensures IR cache mechanisms won't run
               .StartAddr = 0,       // Unused
@@ -994,7 +1343,7 @@ namespace FEXCore::Context {
 
     // AOT IR bookkeeping and cache
     {
-      auto [IRCopy, RACopy, DebugDataCopy, _StartAddr, _Length, _GeneratedIR] = IRCaptureCache.PreGenerateIRFetch(Thread, GuestRIP, IRList);
+      auto [IRCopy, RACopy, DebugDataCopy, HostCodeEntry, _StartAddr, _Length, _GeneratedIR] = IRCaptureCache.PreGenerateIRFetch(Thread, GuestRIP, IRList);
       if (_GeneratedIR) {
         // Setup pointers to internal structures
         IRList = IRCopy;
@@ -1004,11 +1353,66 @@ namespace FEXCore::Context {
         Length = _Length;
         GeneratedIR = _GeneratedIR;
       }
+
+      if (HostCodeEntry) {
+        // The cache has the host code for the IR, only the per process values need to be relocated
+        const CodeSerialize::CodeObjectFileSection CodeObject {
+          .Serialized = true,
+          .Invalid = false,
+          .Data = nullptr,
+          .HostCode = HostCodeEntry->GetHostCode(),
+          .HostCodeSize = HostCodeEntry->HostCodeSize,
+          .HostCodeEntryOffset = HostCodeEntry->HostCodeEntryOffset,
+          .NumRelocations = HostCodeEntry->NumRelocations,
+          .Relocations = HostCodeEntry->GetRelocations(),
+        };
+
+        auto CompiledCode = Thread->CPUBackend->RelocateJITObjectCode(GuestRIP, &CodeObject);
+        if (CompiledCode) {
+          if (JITModuleStatsEnabled) {
+            auto Module = GetJITStatsModule(Thread, GuestRIP);
+            std::lock_guard lk(JITModuleStatsMutex);
+            ++ModuleStats[Module].ObjectCacheHits;
+          }
+
+          // The IR points in to the cache file, nothing needs to be freed
+          return {
+              .CompiledCode = CompiledCode,
+              .IRData = nullptr,
+              .DebugData = CreateRelocatedDebugData(&CodeObject),
+              .RAData = nullptr,
+              .GeneratedIR = false,
+              .StartAddr = 0,
+              .Length = 0,
+          };
+        }
+
+        // Fall back to compiling the cached IR
+        RAData = HostCodeEntry->GetRAData()->CreateCopy();
+        DebugData = new FEXCore::Core::DebugData();
+      }
     }
 
+    uint64_t GuestInstructions {};
+    uint64_t GuestInstructionsLength {};
+    uint64_t FrontendMicroseconds {};
+    uint64_t PassMicroseconds {};
+    const bool AOTIRHit = IRList != nullptr;
+
+    // Blocks without cached code run in the interpreter tier until they have proven hot
+    const bool InterpreterTier = !AOTIRHit && Thread->InterpreterBackend && !Thread->HotBlocks.contains(GuestRIP) &&
+                                 !RequiresJIT(GuestRIP);
+
+    const auto CompileStart = CompileTimeStatsEnabled ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
     if (IRList == nullptr) {
       // Generate IR + Meta Info
-      auto [IRCopy, RACopy, TotalInstructions, TotalInstructionsLength, _StartAddr, _Length] = GenerateIR(Thread, GuestRIP, Config.GDBSymbols());
+      auto Passes = InterpreterTier ? Thread->InterpreterPassManager.get() : Thread->PassManager.get();
+      auto [IRCopy, RACopy, TotalInstructions, TotalInstructionsLength, _StartAddr, _Length, _FrontendMicroseconds, _PassMicroseconds] = GenerateIR(Thread, GuestRIP, Config.GDBSymbols(), Passes);
+      GuestInstructions = TotalInstructions;
+      GuestInstructionsLength = TotalInstructionsLength;
+      FrontendMicroseconds = _FrontendMicroseconds;
+      PassMicroseconds = _PassMicroseconds;
 
       // Setup pointers to internal structures
       IRList = IRCopy;
@@ -1024,12 +1428,65 @@ namespace FEXCore::Context {
     if (IRList == nullptr) {
       return {};
     }
+
+    if (InterpreterTier) {
+      auto CompiledCode = Thread->InterpreterBackend->CompileCode(GuestRIP, IRList, DebugData, nullptr, GetGdbServerStatus()).BlockEntry;
+
+      // The interpreter serialized its own copy of the IR.
+      // Nothing is handed to the IR or object caches since they only hold JIT compiled blocks.
+      delete DebugData;
+      if (IRList->IsCopy()) delete IRList;
+
+      return {
+        .CompiledCode = CompiledCode,
+        .IRData = nullptr,
+        .DebugData = nullptr,
+        .RAData = nullptr,
+        .GeneratedIR = false,
+        .StartAddr = 0,
+        .Length = 0,
+      };
+    }
+
     // Attempt to get the CPU backend to compile this code
+    // FEX currently throws away the CPUBackend::CompiledCode object other than the entrypoint
+    // In the future with code caching getting wired up, we will pass the rest of the data forward.
+    // TODO: Pass the data forward when code caching is wired up to this.
+    const auto CodegenStart = JITModuleStatsEnabled ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+    auto CompiledCode = Thread->CPUBackend->CompileCode(GuestRIP, IRList, DebugData, RAData.get(), GetGdbServerStatus()).BlockEntry;
+
+    if (GuestInstructions) {
+      CodeStats.BlocksCompiled.fetch_add(1, std::memory_order_relaxed);
+      CodeStats.GuestInstructions.fetch_add(GuestInstructions, std::memory_order_relaxed);
+      CodeStats.GuestBytes.fetch_add(GuestInstructionsLength, std::memory_order_relaxed);
+      CodeStats.HostCodeBytes.fetch_add(DebugData->HostCodeSize, std::memory_order_relaxed);
+
+      if (CompileTimeStatsEnabled) {
+        CodeStats.CompileNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - CompileStart).count(), std::memory_order_relaxed);
+      }
+    }
+
+    if (JITModuleStatsEnabled) {
+      const uint64_t CodegenMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - CodegenStart).count();
+
+      auto Module = GetJITStatsModule(Thread, GuestRIP);
+
+      std::lock_guard lk(JITModuleStatsMutex);
+      auto &Stats = ModuleStats[Module];
+      ++Stats.BlocksCompiled;
+      Stats.GuestInstructions += GuestInstructions;
+      Stats.GuestBytes += GuestInstructionsLength;
+      Stats.IRNodes += IRList->GetSSACount();
+      Stats.SpillSlots += RAData ? RAData->SpillSlots() : 0;
+      Stats.HostCodeBytes += DebugData ? DebugData->HostCodeSize : 0;
+      Stats.FrontendMicroseconds += FrontendMicroseconds;
+      Stats.PassMicroseconds += PassMicroseconds;
+      Stats.CodegenMicroseconds += CodegenMicroseconds;
+      Stats.AOTIRHits += AOTIRHit;
+    }
+
     return {
-      // FEX currently throws away the CPUBackend::CompiledCode object other than the entrypoint
-      // In the future with code caching getting wired up, we will pass the rest of the data forward.
-      // TODO: Pass the data forward when code caching is wired up to this.
-      .CompiledCode = Thread->CPUBackend->CompileCode(GuestRIP, IRList, DebugData, RAData.get(), GetGdbServerStatus()).BlockEntry,
+      .CompiledCode = CompiledCode,
       .IRData = IRList,
       .DebugData = DebugData,
       .RAData = std::move(RAData),
@@ -1089,47 +1546,35 @@ namespace FEXCore::Context {
       if (DebugData) {
         auto GuestRIPLookup = SyscallHandler->LookupAOTIRCacheEntry(Thread, GuestRIP);
 
+        auto RegisterBlock = [&](const void *HostAddr, uint32_t HostCodeSize) {
+          auto SymbolBuffer = Thread->SymbolBuffer.get();
+          if (!GuestRIPLookup.Entry) {
+            Symbols.Register(SymbolBuffer, HostAddr, GuestRIP, HostCodeSize);
+            return;
+          }
+
+          const auto FileOffset = GuestRIP - GuestRIPLookup.VAFileStart;
+          const auto SymbolMap = GuestRIPLookup.Entry->SymbolMap.get();
+          const auto Symbol = SymbolMap ? SymbolMap->FindSymbolMapping(FileOffset) : nullptr;
+          if (Symbol) {
+            Symbols.Register(SymbolBuffer, HostAddr, HostCodeSize, GuestRIPLookup.Entry->Filename, Symbol->Name, FileOffset - Symbol->FileGuestBegin);
+          } else {
+            Symbols.Register(SymbolBuffer, HostAddr, HostCodeSize, GuestRIPLookup.Entry->Filename, FileOffset);
+          }
+        };
+
         if (DebugData->Subblocks.size()) {
           for (auto& Subblock: DebugData->Subblocks) {
-            auto BlockBasePtr = FragmentBasePtr + Subblock.HostCodeOffset;
-            if (GuestRIPLookup.Entry) {
-              Symbols.Register(BlockBasePtr, DebugData->HostCodeSize, GuestRIPLookup.Entry->Filename, GuestRIP - GuestRIPLookup.VAFileStart);
-            } else {
-              Symbols.Register(BlockBasePtr, GuestRIP, Subblock.HostCodeSize);
-            }
+            RegisterBlock(FragmentBasePtr + Subblock.HostCodeOffset, Subblock.HostCodeSize);
           }
         } else {
-          if (GuestRIPLookup.Entry) {
-            Symbols.Register(FragmentBasePtr, DebugData->HostCodeSize, GuestRIPLookup.Entry->Filename, GuestRIP - GuestRIPLookup.VAFileStart);
-        } else {
-          Symbols.Register(FragmentBasePtr, GuestRIP, DebugData->HostCodeSize);
-          }
+          RegisterBlock(FragmentBasePtr, DebugData->HostCodeSize);
         }
       }
     }
 
-    // Tell the object cache service to serialize the code if enabled
-    if (CodeObjectCacheService &&
-        Config.CacheObjectCodeCompilation == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_READWRITE &&
-        DebugData) {
-      CodeObjectCacheService->AsyncAddSerializationJob(fextl::make_unique<CodeSerialize::AsyncJobHandler::SerializationJobData>(
-        CodeSerialize::AsyncJobHandler::SerializationJobData {
-          .GuestRIP = GuestRIP,
-          .GuestCodeLength = Length,
-          .GuestCodeHash = 0,
-          .HostCodeBegin = CodePtr,
-          .HostCodeLength = DebugData->HostCodeSize,
-          .HostCodeHash = 0,
-          .ThreadJobRefCount = &Thread->ObjectCacheRefCounter,
-          .Relocations = std::move(*DebugData->Relocations),
-        }
-      ));
-    }
-
-    // Clear any relocations that might have been generated
-    Thread->CPUBackend->ClearRelocations();
-
-    if (IRCaptureCache.PostCompileCode(
+    // The AOTIR capture copies the host code and its relocations in to the cache with the IR
+    const bool EarlyExit = IRCaptureCache.PostCompileCode(
         Thread,
         CodePtr,
         GuestRIP,
@@ -1138,8 +1583,17 @@ namespace FEXCore::Context {
         std::move(RAData),
         IRList,
         DebugData,
-        GeneratedIR)) {
-      // Early exit
+        GeneratedIR);
+
+    // Only generated IR hands its debug data over to the caches, relocated blocks only needed it for naming
+    if (!GeneratedIR) {
+      delete DebugData;
+    }
+
+    // Clear any relocations that might have been generated
+    Thread->CPUBackend->ClearRelocations();
+
+    if (EarlyExit) {
       return (uintptr_t)CodePtr;
     }
 
@@ -1241,6 +1695,7 @@ namespace FEXCore::Context {
     ScopedPotentialDeferredSignalWithForkableUniqueLock lk(CodeInvalidationMutex, Thread);
 
     InvalidateGuestCodeRangeInternal(this, Start, Length);
+    CodeInvalidations.fetch_add(1, std::memory_order_relaxed);
   }
 
   void ContextImpl::InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, std::function<void(uint64_t start, uint64_t Length)> CallAfter) {
@@ -1250,6 +1705,7 @@ namespace FEXCore::Context {
     ScopedPotentialDeferredSignalWithForkableUniqueLock lk(CodeInvalidationMutex, Thread);
 
     InvalidateGuestCodeRangeInternal(this, Start, Length);
+    CodeInvalidations.fetch_add(1, std::memory_order_relaxed);
     CallAfter(Start, Length);
   }
 
@@ -1287,6 +1743,89 @@ namespace FEXCore::Context {
 
     Thread->DebugStore.erase(GuestRIP);
     Thread->LookupCache->Erase(GuestRIP);
+    // Invalidated code might have changed, it has to prove hot again
+    Thread->HotBlocks.erase(GuestRIP);
+    // Same for the branches taken out of it
+    Thread->RegionProfiles.erase(GuestRIP);
+  }
+
+  void ContextImpl::PromoteInterpretedBlock(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP) {
+    auto Thread = Frame->Thread;
+
+    ScopedDeferredSignalWithForkableUniqueLock lk(static_cast<ContextImpl*>(Thread->CTX)->CodeInvalidationMutex, Thread);
+
+    // The dispatcher misses on the next lookup and compiles the block with the JIT
+    ThreadRemoveCodeEntry(Thread, GuestRIP);
+    Thread->HotBlocks.insert(GuestRIP);
+  }
+
+  bool ContextImpl::RequiresJIT(uint64_t GuestRIP) {
+    // Only the x86 dispatcher gives the interpreter a way to return from a callback
+    if (GuestRIP == X86CodeGen.CallbackReturn) {
+      return true;
+    }
+
+    std::shared_lock lk(CustomIRMutex);
+    return CustomIRHandlers.contains(GuestRIP);
+  }
+
+  uint64_t ContextImpl::ProfileMultiblockExit(FEXCore::Core::CpuStateFrame *Frame, uint64_t *record) {
+    auto Thread = Frame->Thread;
+    auto CTX = static_cast<ContextImpl*>(Thread->CTX);
+    const uint64_t GuestRIP = record[1];
+    const uint64_t RegionEntry = record[2];
+
+    const auto ContinueAt = [Frame, Thread, GuestRIP]() -> uint64_t {
+      if (auto HostCode = Thread->LookupCache->FindBlock(GuestRIP)) {
+        return HostCode;
+      }
+
+      Frame->State.rip = GuestRIP;
+      return Frame->Pointers.Common.DispatcherLoopTop;
+    };
+
+    {
+      // The profile allocates and invalidation from other threads erases it, both need signals deferred and the lock held
+      ScopedDeferredSignalWithForkableSharedLock lk(CTX->CodeInvalidationMutex, Thread);
+
+      auto Region = Thread->RegionProfiles.find(RegionEntry);
+      if (Region == Thread->RegionProfiles.end() || Region->second.Formed) {
+        return 0;
+      }
+
+      auto &Profile = Region->second;
+      auto Exit = Profile.SideExits.find(GuestRIP);
+      if (Exit == Profile.SideExits.end()) {
+        // Targets outside of the multiblock range never join the region
+        return 0;
+      }
+
+      const uint32_t Threshold = CTX->MultiblockEdgeProfileThreshold;
+      if (++Exit->second == Threshold) {
+        Profile.HotTargets.insert(GuestRIP);
+        Profile.ExitsSinceNewHotTarget = 0;
+      }
+      else if (++Profile.ExitsSinceNewHotTarget >= Threshold && !Profile.HotTargets.empty()) {
+        Profile.Formed = true;
+      }
+
+      if (!Profile.Formed) {
+        return ContinueAt();
+      }
+    }
+
+    // The hot targets have settled, the dispatcher misses on the next lookup and recompiles the region with them
+    ScopedDeferredSignalWithForkableUniqueLock lk(CTX->CodeInvalidationMutex, Thread);
+
+    // Removing the entry drops its profile, which has to survive for the recompile.
+    // If the region was invalidated while the lock was dropped the profile is already gone and profiling starts over.
+    auto Profile = Thread->RegionProfiles.extract(RegionEntry);
+    ThreadRemoveCodeEntry(Thread, RegionEntry);
+    if (Profile) {
+      Thread->RegionProfiles.insert(std::move(Profile));
+    }
+
+    return ContinueAt();
   }
 
   CustomIRResult ContextImpl::AddCustomIREntrypoint(uintptr_t Entrypoint, std::function<void(uintptr_t Entrypoint, FEXCore::IR::IREmitter *)> Handler, void *Creator, void *Data) {
@@ -1321,8 +1860,8 @@ namespace FEXCore::Context {
     return Result;
   }
 
-  IR::AOTIRCacheEntry *ContextImpl::LoadAOTIRCacheEntry(const fextl::string &filename) {
-    auto rv = IRCaptureCache.LoadAOTIRCacheEntry(filename);
+  IR::AOTIRCacheEntry *ContextImpl::LoadAOTIRCacheEntry(const fextl::string &filename, int fd) {
+    auto rv = IRCaptureCache.LoadAOTIRCacheEntry(filename, fd);
     if (DebugServer) {
       DebugServer->AlertLibrariesChanged();
     }
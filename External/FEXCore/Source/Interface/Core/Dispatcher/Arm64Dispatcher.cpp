@@ -187,6 +187,21 @@ void Arm64Dispatcher::EmitDispatcher() {
     ret();
   }
 
+  if (config.StaticRegisterAllocation) {
+    // The interpreter tier runs cold blocks from the guest state in memory.
+    // Entered from an interpreter trampoline with the block's serialized IR in x1.
+    InterpreterEntrySpillSRAAddress = GetCursorAddress<uint64_t>();
+    SpillStaticRegs(TMP1);
+
+    mov(ARMEmitter::XReg::x0, STATE);
+    ldr(ARMEmitter::XReg::x3, STATE_PTR(CpuStateFrame, Pointers.Interpreter.FragmentExecuter));
+    blr(ARMEmitter::Reg::r3);
+
+    // The interpreted block may have changed any of the guest state
+    ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.DispatcherLoopTopFillSRA));
+    br(ARMEmitter::Reg::r0);
+  }
+
   {
     ExitFunctionLinkerAddress = GetCursorAddress<uint64_t>();
     if (config.StaticRegisterAllocation)
@@ -213,10 +228,16 @@ void Arm64Dispatcher::EmitDispatcher() {
     subs(ARMEmitter::Size::i64Bit, ARMEmitter::XReg::x1, ARMEmitter::XReg::x1, 1);
     str(ARMEmitter::XReg::x1, STATE, offsetof(FEXCore::Core::CPUState, DeferredSignalRefCount));
 
+    ARMEmitter::ForwardLabel AfterStore;
+    // Skip the deferred fault address if the refcount isn't zero
+    cbnz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, &AfterStore);
+
     // Trigger segfault if any deferred signals are pending
     ldr(ARMEmitter::XReg::x1, STATE, offsetof(FEXCore::Core::CPUState, DeferredSignalFaultAddress));
     str(ARMEmitter::XReg::zr, ARMEmitter::XReg::x1, 0);
 
+    Bind(&AfterStore);
+
     br(ARMEmitter::Reg::r0);
   }
 
@@ -249,10 +270,16 @@ void Arm64Dispatcher::EmitDispatcher() {
     subs(ARMEmitter::Size::i64Bit, ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, 1);
     str(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CPUState, DeferredSignalRefCount));
 
+    ARMEmitter::ForwardLabel AfterStore;
+    // Skip the deferred fault address if the refcount isn't zero
+    cbnz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, &AfterStore);
+
     // Trigger segfault if any deferred signals are pending
     ldr(TMP1, STATE, offsetof(FEXCore::Core::CPUState, DeferredSignalFaultAddress));
     str(ARMEmitter::XReg::zr, TMP1, 0);
 
+    Bind(&AfterStore);
+
     b(&LoopTop);
   }
 
@@ -496,7 +523,7 @@ void Arm64Dispatcher::EmitDispatcher() {
 
   if (CTX->Config.BlockJITNaming()) {
     fextl::string Name = fextl::fmt::format("Dispatch_{}", FHU::Syscalls::gettid());
-    CTX->Symbols.Register(reinterpret_cast<void*>(DispatchPtr), End - reinterpret_cast<uint64_t>(DispatchPtr), Name);
+    CTX->Symbols.Register(nullptr, reinterpret_cast<void*>(DispatchPtr), End - reinterpret_cast<uint64_t>(DispatchPtr), Name);
   }
   if (CTX->Config.GlobalJITNaming()) {
     CTX->Symbols.RegisterJITSpace(reinterpret_cast<void*>(DispatchPtr), End - reinterpret_cast<uint64_t>(DispatchPtr));
@@ -559,11 +586,28 @@ size_t Arm64Dispatcher::GenerateGDBPauseCheck(uint8_t *CodeBuffer, uint64_t Gues
 }
 
 size_t Arm64Dispatcher::GenerateInterpreterTrampoline(uint8_t *CodeBuffer) {
-  LOGMAN_THROW_AA_FMT(!config.StaticRegisterAllocation, "GenerateInterpreterTrampoline dispatcher does not support SRA");
-
   FEXCore::ARMEmitter::Emitter emit{CodeBuffer, MaxInterpreterTrampolineSize};
   ARMEmitter::ForwardLabel InlineIRData;
 
+  if (config.StaticRegisterAllocation) {
+    // Only the interpreter tier gets here with SRA, JIT blocks can link to these directly.
+    // The dispatcher spills the SRA before interpreting and fills it afterwards.
+    ARMEmitter::ForwardLabel l_InterpreterEntry;
+
+    emit.adr(ARMEmitter::Reg::r1, &InlineIRData);
+    emit.ldr(ARMEmitter::XReg::x3, &l_InterpreterEntry);
+    emit.br(ARMEmitter::Reg::r3);
+
+    emit.Bind(&l_InterpreterEntry);
+    emit.dc64(InterpreterEntrySpillSRAAddress);
+
+    emit.Bind(&InlineIRData);
+
+    auto UsedBytes = emit.GetCursorOffset();
+    emit.ClearICache(CodeBuffer, UsedBytes);
+    return UsedBytes;
+  }
+
   emit.mov(ARMEmitter::XReg::x0, STATE);
   emit.adr(ARMEmitter::Reg::r1, &InlineIRData);
 
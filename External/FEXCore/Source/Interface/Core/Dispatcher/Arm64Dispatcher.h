@@ -51,6 +51,9 @@ class Arm64Dispatcher final : public Dispatcher, public Arm64Emitter {
   }
 
   private:
+    // Interpreted blocks are entered through this when the JIT uses static register allocation
+    uint64_t InterpreterEntrySpillSRAAddress{};
+
     // Long division helpers
     uint64_t LUDIVHandlerAddress{};
     uint64_t LDIVHandlerAddress{};
@@ -1025,17 +1025,10 @@ void Decoder::BranchTargetInMultiblockRange() {
       MaxCondBranchBackwards = std::min(MaxCondBranchBackwards, TargetRIP);
 
       // If we are conditional then a target can be the instruction past the conditional instruction
-      uint64_t FallthroughRIP = DecodeInst->PC + DecodeInst->InstSize;
-      if (HasBlocks.find(FallthroughRIP) == HasBlocks.end() &&
-          BlocksToDecode.find(FallthroughRIP) == BlocksToDecode.end()) {
-        BlocksToDecode.emplace(FallthroughRIP);
-      }
+      AddMultiblockTarget(DecodeInst->PC + DecodeInst->InstSize);
     }
 
-    if (HasBlocks.find(TargetRIP) == HasBlocks.end() &&
-        BlocksToDecode.find(TargetRIP) == BlocksToDecode.end()) {
-      BlocksToDecode.emplace(TargetRIP);
-    }
+    AddMultiblockTarget(TargetRIP);
   } else {
     if (ExternalBranches) {
       ExternalBranches->insert(TargetRIP);
@@ -1043,6 +1036,23 @@ void Decoder::BranchTargetInMultiblockRange() {
   }
 }
 
+void Decoder::AddMultiblockTarget(uint64_t TargetRIP) {
+  if (HasBlocks.find(TargetRIP) != HasBlocks.end() ||
+      BlocksToDecode.find(TargetRIP) != BlocksToDecode.end()) {
+    return;
+  }
+
+  // With a branch profile only the targets that were taken often enough join the function
+  if (HotTargets && HotTargets->find(TargetRIP) == HotTargets->end()) {
+    if (SideExitTargets) {
+      SideExitTargets->insert(TargetRIP);
+    }
+    return;
+  }
+
+  BlocksToDecode.emplace(TargetRIP);
+}
+
 bool Decoder::BranchTargetCanContinue(bool FinalInstruction) const {
   if (FinalInstruction) {
     return false;
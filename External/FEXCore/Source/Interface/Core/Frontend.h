@@ -40,6 +40,17 @@ public:
   void SetSectionMaxAddress(uint64_t v) { SectionMaxAddress = v; }
   void SetExternalBranches(fextl::set<uint64_t> *v) { ExternalBranches = v; }
 
+  /**
+   * @brief Limits multiblock discovery to profiled branch targets
+   *
+   * In range targets that aren't in Hot are left out of the function and recorded in SideExits instead.
+   * Both are cleared with nullptr, which decodes every in range target again.
+   */
+  void SetBranchProfile(fextl::set<uint64_t> const *Hot, fextl::set<uint64_t> *SideExits) {
+    HotTargets = Hot;
+    SideExitTargets = SideExits;
+  }
+
   void DelayedDisownBuffer() {
     PoolObject.DelayedDisownBuffer();
   }
@@ -59,6 +70,7 @@ private:
   bool DecodeInstruction(uint64_t PC);
 
   void BranchTargetInMultiblockRange();
+  void AddMultiblockTarget(uint64_t TargetRIP);
   bool BranchTargetCanContinue(bool FinalInstruction) const;
 
   uint8_t ReadByte();
@@ -94,6 +106,8 @@ private:
   fextl::set<uint64_t> BlocksToDecode;
   fextl::set<uint64_t> HasBlocks;
   fextl::set<uint64_t> *ExternalBranches {nullptr};
+  fextl::set<uint64_t> const *HotTargets {nullptr};
+  fextl::set<uint64_t> *SideExitTargets {nullptr};
 
   // ModRM rm decoding
   using DecodeModRMPtr = void (FEXCore::Frontend::Decoder::*)(X86Tables::DecodedOperand *Operand, X86Tables::ModRMDecoded ModRM);
@@ -369,79 +369,71 @@ DEF_OP(AESImc) {
   memcpy(GDP, &Tmp, sizeof(Tmp));
 }
 
-DEF_OP(AESEnc) {
-  auto Op = IROp->C<IR::IROp_VAESEnc>();
+DEF_OP(AESEncRound) {
+  auto Op = IROp->C<IR::IROp_VAESEncRound>();
   auto Src1 = *GetSrc<__uint128_t*>(Data->SSAData, Op->State);
   auto Src2 = *GetSrc<__uint128_t*>(Data->SSAData, Op->Key);
 
   // Pseudo-code
-  // STATE = Src1
-  // RoundKey = Src2
+  // STATE = Src1 XOR Src2
   // STATE = ShiftRows(STATE)
   // STATE = SubBytes(STATE)
   // STATE = MixColumns(STATE)
-  // Dst = STATE XOR RoundKey
-  __uint128_t Tmp{};
-  Tmp = AES::ShiftRows(reinterpret_cast<uint8_t*>(&Src1));
+  // Dst = STATE
+  __uint128_t Tmp = Src1 ^ Src2;
+  Tmp = AES::ShiftRows(reinterpret_cast<uint8_t*>(&Tmp));
   Tmp = AES::SubBytes(reinterpret_cast<uint8_t*>(&Tmp), 16);
   Tmp = AES::MixColumns(reinterpret_cast<uint8_t*>(&Tmp));
-  Tmp = Tmp ^ Src2;
   memcpy(GDP, &Tmp, sizeof(Tmp));
 }
 
-DEF_OP(AESEncLast) {
-  auto Op = IROp->C<IR::IROp_VAESEncLast>();
+DEF_OP(AESEncLastRound) {
+  auto Op = IROp->C<IR::IROp_VAESEncLastRound>();
   auto Src1 = *GetSrc<__uint128_t*>(Data->SSAData, Op->State);
   auto Src2 = *GetSrc<__uint128_t*>(Data->SSAData, Op->Key);
 
   // Pseudo-code
-  // STATE = Src1
-  // RoundKey = Src2
+  // STATE = Src1 XOR Src2
   // STATE = ShiftRows(STATE)
   // STATE = SubBytes(STATE)
-  // Dst = STATE XOR RoundKey
-  __uint128_t Tmp{};
-  Tmp = AES::ShiftRows(reinterpret_cast<uint8_t*>(&Src1));
+  // Dst = STATE
+  __uint128_t Tmp = Src1 ^ Src2;
+  Tmp = AES::ShiftRows(reinterpret_cast<uint8_t*>(&Tmp));
   Tmp = AES::SubBytes(reinterpret_cast<uint8_t*>(&Tmp), 16);
-  Tmp = Tmp ^ Src2;
   memcpy(GDP, &Tmp, sizeof(Tmp));
 }
 
-DEF_OP(AESDec) {
-  auto Op = IROp->C<IR::IROp_VAESDec>();
+DEF_OP(AESDecRound) {
+  auto Op = IROp->C<IR::IROp_VAESDecRound>();
   auto Src1 = *GetSrc<__uint128_t*>(Data->SSAData, Op->State);
   auto Src2 = *GetSrc<__uint128_t*>(Data->SSAData, Op->Key);
 
   // Pseudo-code
-  // STATE = Src1
-  // RoundKey = Src2
+  // STATE = Src1 XOR Src2
   // STATE = InvShiftRows(STATE)
   // STATE = InvSubBytes(STATE)
   // STATE = InvMixColumns(STATE)
-  // Dst = STATE XOR RoundKey
-  __uint128_t Tmp{};
-  Tmp = AES::InvShiftRows(reinterpret_cast<uint8_t*>(&Src1));
+  // Dst = STATE
+  __uint128_t Tmp = Src1 ^ Src2;
+  Tmp = AES::InvShiftRows(reinterpret_cast<uint8_t*>(&Tmp));
   Tmp = AES::InvSubBytes(reinterpret_cast<uint8_t*>(&Tmp));
   Tmp = AES::InvMixColumns(reinterpret_cast<uint8_t*>(&Tmp));
-  Tmp = Tmp ^ Src2;
   memcpy(GDP, &Tmp, sizeof(Tmp));
 }
 
-DEF_OP(AESDecLast) {
-  auto Op = IROp->C<IR::IROp_VAESDecLast>();
+DEF_OP(AESDecLastRound) {
+  auto Op = IROp->C<IR::IROp_VAESDecLastRound>();
   auto Src1 = *GetSrc<__uint128_t*>(Data->SSAData, Op->State);
   auto Src2 = *GetSrc<__uint128_t*>(Data->SSAData, Op->Key);
 
   // Pseudo-code
-  // STATE = Src1
-  // RoundKey = Src2
+  // STATE = Src1 XOR Src2
   // STATE = InvShiftRows(STATE)
   // STATE = InvSubBytes(STATE)
-  // Dst = STATE XOR RoundKey
-  __uint128_t Tmp{};
-  Tmp = AES::InvShiftRows(reinterpret_cast<uint8_t*>(&Src1));
+  // Dst = STATE
+  __uint128_t Tmp = Src1 ^ Src2;
+  Tmp = AES::InvShiftRows(reinterpret_cast<uint8_t*>(&Tmp));
   Tmp = AES::InvSubBytes(reinterpret_cast<uint8_t*>(&Tmp));
-  Tmp = Tmp ^ Src2;
   memcpy(GDP, &Tmp, sizeof(Tmp));
 }
 
@@ -19,7 +19,8 @@ using DestMapType = fextl::vector<uint32_t>;
 class InterpreterCore final : public CPUBackend {
 public:
   explicit InterpreterCore(Dispatcher *Dispatch,
-                           FEXCore::Core::InternalThreadState *Thread);
+                           FEXCore::Core::InternalThreadState *Thread,
+                           uint32_t TierThreshold = 0);
 
   [[nodiscard]] fextl::string GetName() override { return "Interpreter"; }
 
@@ -39,6 +40,8 @@ public:
 private:
   size_t BufferUsed;
   Dispatcher *Dispatch;
+  // When non-zero this is the interpreter tier and blocks are promoted to the JIT after this many executions.
+  uint32_t TierThreshold;
 };
 
 template<typename T>
@@ -34,14 +34,20 @@ namespace FEXCore::IR {
 
 namespace FEXCore::CPU {
 
-InterpreterCore::InterpreterCore(Dispatcher *Dispatcher, FEXCore::Core::InternalThreadState *Thread)
+InterpreterCore::InterpreterCore(Dispatcher *Dispatcher, FEXCore::Core::InternalThreadState *Thread, uint32_t TierThreshold)
   : CPUBackend(Thread, INITIAL_CODE_SIZE, MAX_CODE_SIZE)
   , Dispatch(Dispatcher)
+  , TierThreshold {TierThreshold}
   {
 
   auto &Interpreter = Thread->CurrentFrame->Pointers.Interpreter;
 
-  Interpreter.FragmentExecuter = reinterpret_cast<uint64_t>(&InterpreterOps::InterpretIR);
+  if (TierThreshold) {
+    Interpreter.FragmentExecuter = reinterpret_cast<uint64_t>(&InterpreterOps::InterpretTieredIR);
+  }
+  else {
+    Interpreter.FragmentExecuter = reinterpret_cast<uint64_t>(&InterpreterOps::InterpretIR);
+  }
 
   ClearCache();
 }
@@ -49,7 +55,8 @@ InterpreterCore::InterpreterCore(Dispatcher *Dispatcher, FEXCore::Core::Internal
 CPUBackend::CompiledCode InterpreterCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRListView const *IR, [[maybe_unused]] FEXCore::Core::DebugData *DebugData, FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled) {
 
   const auto IRSize = AlignUp(IR->GetInlineSize(), 16);
-  const auto MaxSize = IRSize + Dispatcher::MaxInterpreterTrampolineSize + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
+  const auto HeaderSize = TierThreshold ? sizeof(InterpreterOps::TieredFragmentHeader) : 0;
+  const auto MaxSize = IRSize + HeaderSize + Dispatcher::MaxInterpreterTrampolineSize + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
 
   if ((BufferUsed + MaxSize) > CurrentCodeBuffer->Size) {
     static_cast<Context::ContextImpl*>(ThreadState->CTX)->ClearCodeCache(ThreadState);
@@ -72,6 +79,13 @@ CPUBackend::CompiledCode InterpreterCore::CompileCode(uint64_t Entry, [[maybe_un
   DestBuffer += TrampolineSize;
   BufferUsed += TrampolineSize;
 
+  if (TierThreshold) {
+    auto Header = reinterpret_cast<InterpreterOps::TieredFragmentHeader*>(DestBuffer);
+    Header->Entry = Entry;
+    Header->ExecutionsRemaining = TierThreshold;
+    DestBuffer += HeaderSize;
+    BufferUsed += HeaderSize;
+  }
 
   IR->Serialize(DestBuffer);
   DestBuffer += IRSize;
@@ -92,6 +106,10 @@ fextl::unique_ptr<CPUBackend> CreateInterpreterCore(FEXCore::Context::ContextImp
   return fextl::make_unique<InterpreterCore>(ctx->Dispatcher.get(), Thread);
 }
 
+fextl::unique_ptr<CPUBackend> CreateInterpreterTierCore(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::InternalThreadState *Thread, uint32_t TierThreshold) {
+  return fextl::make_unique<InterpreterCore>(ctx->Dispatcher.get(), Thread, TierThreshold);
+}
+
 CPUBackendFeatures GetInterpreterBackendFeatures() {
   return CPUBackendFeatures { };
 }
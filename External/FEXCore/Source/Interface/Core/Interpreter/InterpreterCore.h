@@ -17,6 +17,9 @@ struct DispatcherConfig;
 
 [[nodiscard]] fextl::unique_ptr<CPUBackend> CreateInterpreterCore(FEXCore::Context::ContextImpl *ctx,
                                                                 FEXCore::Core::InternalThreadState *Thread);
+[[nodiscard]] fextl::unique_ptr<CPUBackend> CreateInterpreterTierCore(FEXCore::Context::ContextImpl *ctx,
+                                                                    FEXCore::Core::InternalThreadState *Thread,
+                                                                    uint32_t TierThreshold);
 void InitializeInterpreterSignalHandlers(FEXCore::Context::ContextImpl *CTX);
 CPUBackendFeatures GetInterpreterBackendFeatures();
 
@@ -274,10 +274,10 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
 
   // Encryption ops
   REGISTER_OP(VAESIMC,                AESImc);
-  REGISTER_OP(VAESENC,                AESEnc);
-  REGISTER_OP(VAESENCLAST,            AESEncLast);
-  REGISTER_OP(VAESDEC,                AESDec);
-  REGISTER_OP(VAESDECLAST,            AESDecLast);
+  REGISTER_OP(VAESENCROUND,           AESEncRound);
+  REGISTER_OP(VAESENCLASTROUND,       AESEncLastRound);
+  REGISTER_OP(VAESDECROUND,           AESDecRound);
+  REGISTER_OP(VAESDECLASTROUND,       AESDecLastRound);
   REGISTER_OP(VAESKEYGENASSIST,       AESKeyGenAssist);
   REGISTER_OP(CRC32,                  CRC32);
   REGISTER_OP(PCLMUL,                 PCLMUL);
@@ -330,6 +330,15 @@ void InterpreterOps::Op_Unhandled(FEXCore::IR::IROp_Header *IROp, IROpData *Data
 void InterpreterOps::Op_NoOp(FEXCore::IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node) {
 }
 
+void InterpreterOps::InterpretTieredIR(FEXCore::Core::CpuStateFrame *Frame, TieredFragmentHeader *Header) {
+  InterpretIR(Frame, reinterpret_cast<FEXCore::IR::IRListView const*>(Header + 1));
+
+  // Once the block has proven hot, remove it so the next dispatch JIT compiles it
+  if (Header->ExecutionsRemaining != 0 && --Header->ExecutionsRemaining == 0) {
+    Context::ContextImpl::PromoteInterpretedBlock(Frame, Header->Entry);
+  }
+}
+
 void InterpreterOps::InterpretIR(FEXCore::Core::CpuStateFrame *Frame, FEXCore::IR::IRListView const *CurrentIR) {
   volatile void *StackEntry = alloca(0);
 
@@ -50,6 +50,15 @@ namespace FEXCore::CPU {
 
     public:
       static void InterpretIR(FEXCore::Core::CpuStateFrame *Frame, FEXCore::IR::IRListView const *IR);
+
+      // Prefixes the serialized IR of blocks in the interpreter tier.
+      struct TieredFragmentHeader {
+        uint64_t Entry;
+        // Executions left before the block is handed to the JIT.
+        uint32_t ExecutionsRemaining;
+        uint32_t Pad;
+      };
+      static void InterpretTieredIR(FEXCore::Core::CpuStateFrame *Frame, TieredFragmentHeader *Header);
       static void FillFallbackIndexPointers(uint64_t *Info);
       static bool GetFallbackHandler(IR::IROp_Header const *IROp, FallbackInfo *Info);
 
@@ -300,10 +309,10 @@ namespace FEXCore::CPU {
 
   ///< Encryption ops
   DEF_OP(AESImc);
-  DEF_OP(AESEnc);
-  DEF_OP(AESEncLast);
-  DEF_OP(AESDec);
-  DEF_OP(AESDecLast);
+  DEF_OP(AESEncRound);
+  DEF_OP(AESEncLastRound);
+  DEF_OP(AESDecRound);
+  DEF_OP(AESDecLastRound);
   DEF_OP(AESKeyGenAssist);
   DEF_OP(CRC32);
   DEF_OP(PCLMUL);
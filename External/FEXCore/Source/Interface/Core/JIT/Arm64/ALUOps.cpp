@@ -50,6 +50,11 @@ DEF_OP(EntrypointOffset) {
     Mask = 0xFFFF'FFFFULL;
   }
 
+  if (CTX->Config.CacheObjectCodeCompilation()) {
+    InsertGuestRIPMove(Dst, Op->Offset, OpSize);
+    return;
+  }
+
   LoadConstant(ARMEmitter::Size::i64Bit, Dst, Constant & Mask);
 }
 
@@ -6,8 +6,11 @@ $end_info$
 */
 #include "Interface/Context/Context.h"
 #include "Interface/Core/JIT/Arm64/JITClass.h"
+#include "Interface/Core/ObjectCache/ObjectCacheService.h"
 #include "Interface/HLE/Thunks/Thunks.h"
 
+#include <cstring>
+
 namespace FEXCore::CPU {
 
 uint64_t Arm64JITCore::GetNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol Op) {
@@ -65,19 +68,34 @@ void Arm64JITCore::PlaceNamedSymbolLiteral(NamedSymbolLiteralPair &Lit) {
   Relocations.emplace_back(Lit.MoveABI);
 }
 
-void Arm64JITCore::InsertGuestRIPMove(ARMEmitter::Register Reg, uint64_t Constant) {
+void Arm64JITCore::InsertGuestRIPMove(ARMEmitter::Register Reg, uint64_t GuestEntryOffset, uint8_t OpSize) {
   Relocation MoveABI{};
   MoveABI.GuestRIPMove.Header.Type = FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE;
   // Offset is the offset from the entrypoint of the block
   auto CurrentCursor = GetCursorAddress<uint8_t *>();
   MoveABI.GuestRIPMove.Offset = CurrentCursor - CodeData.BlockBegin;
-  MoveABI.GuestRIPMove.GuestRIP = Constant;
+  MoveABI.GuestRIPMove.GuestEntryOffset = GuestEntryOffset;
+  MoveABI.GuestRIPMove.OpSize = OpSize;
   MoveABI.GuestRIPMove.RegisterIndex = Reg.Idx();
 
+  const uint64_t Constant = GetRelocatedGuestRIP(Entry, GuestEntryOffset, OpSize);
   LoadConstant(ARMEmitter::Size::i64Bit, Reg, Constant, EmitterCTX->Config.CacheObjectCodeCompilation());
   Relocations.emplace_back(MoveABI);
 }
 
+void Arm64JITCore::PlaceGuestRIPLiteral(uint64_t GuestEntryOffset, uint8_t OpSize) {
+  Relocation MoveABI{};
+  MoveABI.GuestRIPLiteral.Header.Type = FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL;
+  // Offset is the offset from the entrypoint of the block
+  auto CurrentCursor = GetCursorAddress<uint8_t *>();
+  MoveABI.GuestRIPLiteral.Offset = CurrentCursor - CodeData.BlockBegin;
+  MoveABI.GuestRIPLiteral.GuestEntryOffset = GuestEntryOffset;
+  MoveABI.GuestRIPLiteral.OpSize = OpSize;
+
+  dc64(GetRelocatedGuestRIP(Entry, GuestEntryOffset, OpSize));
+  Relocations.emplace_back(MoveABI);
+}
+
 bool Arm64JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uint64_t CursorEntry, size_t NumRelocations, const char* EntryRelocations) {
   size_t DataIndex{};
   for (size_t j = 0; j < NumRelocations; ++j) {
@@ -109,12 +127,7 @@ bool Arm64JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uin
         break;
       }
       case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE: {
-        // XXX: Reenable once the JIT Object Cache is upstream
-        // XXX: Should spin the relocation list, create a list of guest RIP moves, and ask for them all once, reduces lock contention.
-        uint64_t Pointer = ~0ULL; // EmitterCTX->JITObjectCache->FindRelocatedRIP(Reloc->GuestRIPMove.GuestRIP);
-        if (Pointer == ~0ULL) {
-          return false;
-        }
+        uint64_t Pointer = GetRelocatedGuestRIP(GuestEntry, Reloc->GuestRIPMove.GuestEntryOffset, Reloc->GuestRIPMove.OpSize);
 
         // Relocation occurs at the cursorEntry + offset relative to that cursor.
         SetCursorOffset(CursorEntry + Reloc->GuestRIPMove.Offset);
@@ -122,10 +135,48 @@ bool Arm64JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uin
         DataIndex += sizeof(Reloc->GuestRIPMove);
         break;
       }
+      case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL: {
+        uint64_t Pointer = GetRelocatedGuestRIP(GuestEntry, Reloc->GuestRIPLiteral.GuestEntryOffset, Reloc->GuestRIPLiteral.OpSize);
+
+        // Relocation occurs at the cursorEntry + offset relative to that cursor.
+        SetCursorOffset(CursorEntry + Reloc->GuestRIPLiteral.Offset);
+        dc64(Pointer);
+        DataIndex += sizeof(Reloc->GuestRIPLiteral);
+        break;
+      }
+      default:
+        return false;
     }
   }
 
   return true;
 }
+
+void *Arm64JITCore::RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) {
+  if ((GetCursorOffset() + SerializationData->HostCodeSize) > CurrentCodeBuffer->Size) {
+    CTX->ClearCodeCache(ThreadState);
+  }
+
+  const auto CursorBegin = GetCursorOffset();
+  auto BlockBegin = GetCursorAddress<uint8_t *>();
+  memcpy(BlockBegin, SerializationData->HostCode, SerializationData->HostCodeSize);
+
+  if (!ApplyRelocations(Entry, reinterpret_cast<uint64_t>(BlockBegin), CursorBegin,
+                        SerializationData->NumRelocations, SerializationData->Relocations)) {
+    // The caller falls back to compiling the block, which overwrites the copy
+    SetCursorOffset(CursorBegin);
+    return nullptr;
+  }
+
+  // RIP reconstruction needs the RIP the block is mapped at now
+  auto CodeHeader = reinterpret_cast<CPUBackend::JITCodeHeader *>(BlockBegin);
+  auto JITBlockTail = reinterpret_cast<CPUBackend::JITCodeTail *>(BlockBegin + CodeHeader->OffsetToBlockTail);
+  JITBlockTail->RIP = Entry;
+
+  SetCursorOffset(CursorBegin + SerializationData->HostCodeSize);
+  ClearICache(BlockBegin, CodeHeader->OffsetToBlockTail);
+
+  return BlockBegin + SerializationData->HostCodeEntryOffset;
+}
 }
 
@@ -51,7 +51,18 @@ DEF_OP(ExitFunction) {
 
   uint64_t NewRIP;
 
-  if (IsInlineConstant(Op->NewRIP, &NewRIP) || IsInlineEntrypointOffset(Op->NewRIP, &NewRIP)) {
+  if (CTX->Config.CacheObjectCodeCompilation() && IsInlineEntrypointOffset(Op->NewRIP, nullptr)) {
+    // Same layout as below, with both literals relocated when the code is loaded from the cache
+    auto OpHeader = IR->GetOp<IR::IROp_Header>(Op->NewRIP);
+    auto Lit = InsertNamedSymbolLiteral(FEXCore::CPU::RelocNamedSymbolLiteral::NamedSymbol::SYMBOL_LITERAL_EXITFUNCTION_LINKER);
+
+    ldr(ARMEmitter::XReg::x0, &Lit.Loc);
+    blr(ARMEmitter::Reg::r0);
+
+    PlaceNamedSymbolLiteral(Lit);
+    PlaceGuestRIPLiteral(OpHeader->C<IR::IROp_InlineEntrypointOffset>()->Offset, OpHeader->Size);
+
+  } else if (IsInlineConstant(Op->NewRIP, &NewRIP) || IsInlineEntrypointOffset(Op->NewRIP, &NewRIP)) {
     ARMEmitter::ForwardLabel l_BranchHost;
     ARMEmitter::ForwardLabel l_BranchGuest;
 
@@ -62,6 +73,10 @@ DEF_OP(ExitFunction) {
     dc64(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
     Bind(&l_BranchGuest);
     dc64(NewRIP);
+    if (CTX->MultiblockEdgeProfileThreshold) {
+      // Region entry for the linker to count the taken edge against
+      dc64(Entry);
+    }
 
   } else {
 
@@ -158,31 +173,35 @@ DEF_OP(CondJump) {
 }
 
 DEF_OP(Syscall) {
-  PushDynamicRegsAndLR(TMP1);
-  SpillStaticRegs(TMP1); // spill to ctx before ra64 spill
-  ldr(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturningStackLocation));
-  add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::XReg::x0, 0);
-  PopCalleeSavedRegisters();
+  auto Op = IROp->C<IR::IROp_Syscall>();
+  FEXCore::IR::SyscallFlags Flags = Op->Flags;
 
+  constexpr auto DirectCallFlags = FEXCore::IR::SyscallFlags::NOSYNCSTATEONENTRY | FEXCore::IR::SyscallFlags::DIRECTCALL;
+  if ((Flags & DirectCallFlags) != DirectCallFlags) {
+    // The handler may inspect or modify the full guest state, or the syscall isn't one measured to gain from a direct call.
+    // Leave the JIT and let the frontend handle the syscall with everything synced.
+    PushDynamicRegsAndLR(TMP1);
+    SpillStaticRegs(TMP1); // spill to ctx before ra64 spill
+    ldr(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturningStackLocation));
+    add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::XReg::x0, 0);
+    PopCalleeSavedRegisters();
+
+    ret();
+    return;
+  }
 
-  ret();
-#if 0
-  auto Op = IROp->C<IR::IROp_Syscall>();
+  // Handlers that have declared they don't need the guest state synced on entry are called directly.
   // Arguments are passed as follows:
   // X0: SyscallHandler
   // X1: ThreadState
   // X2: Pointer to SyscallArguments
-
-  FEXCore::IR::SyscallFlags Flags = Op->Flags;
   PushDynamicRegsAndLR(TMP1);
 
-  uint32_t GPRSpillMask = ~0U;
-  uint32_t FPRSpillMask = ~0U;
-  if ((Flags & FEXCore::IR::SyscallFlags::NOSYNCSTATEONENTRY) == FEXCore::IR::SyscallFlags::NOSYNCSTATEONENTRY) {
-    // Need to spill all caller saved registers still
-    GPRSpillMask = CALLER_GPR_MASK;
-    FPRSpillMask = CALLER_FPR_MASK;
-  }
+  // Many of these handlers block (futex, wait4, epoll_wait), and a signal arriving while blocked isn't in the code buffer.
+  // The signal handler then builds the guest frame from the context as-is, so spill the whole SRA rather than only the
+  // caller saved registers. This still avoids leaving the JIT and the dispatcher lookup on return.
+  const uint32_t GPRSpillMask = ~0U;
+  const uint32_t FPRSpillMask = ~0U;
 
   SpillStaticRegs(TMP1, true, GPRSpillMask, FPRSpillMask);
 
@@ -231,7 +250,6 @@ DEF_OP(Syscall) {
       mov(ARMEmitter::Size::i64Bit, GetReg(Node), ARMEmitter::Reg::r0);
     }
   }
-#endif
 }
 
 DEF_OP(InlineSyscall) {
@@ -338,23 +356,34 @@ DEF_OP(Thunk) {
   // X0: CTX
   // X1: Args (from guest stack)
 
-  SpillStaticRegs(TMP1); // spill to ctx before ra64 spill
+  auto ThunkHandler = static_cast<Context::ContextImpl*>(ThreadState->CTX)->ThunkHandler.get();
 
-  PushDynamicRegsAndLR(TMP1);
+  // GPR-only leaf thunks (vDSO clock reads) don't look at the guest state and never clobber vector registers.
+  // Only the caller saved GPRs need to survive the call, which avoids spilling and filling every XMM/YMM register.
+  const bool GPROnly = ThunkHandler->IsGPROnlyThunk(Op->ThunkNameHash);
+  const uint32_t GPRSpillMask = GPROnly ? CALLER_GPR_MASK : ~0U;
+
+  SpillStaticRegs(TMP1, !GPROnly, GPRSpillMask); // spill to ctx before ra64 spill
+
+  PushDynamicRegsAndLR(TMP1, !GPROnly);
 
   mov(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, GetReg(Op->ArgPtr.ID()));
 
-  auto thunkFn = static_cast<Context::ContextImpl*>(ThreadState->CTX)->ThunkHandler->LookupThunk(Op->ThunkNameHash);
-  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r2, (uintptr_t)thunkFn);
+  if (CTX->Config.CacheObjectCodeCompilation()) {
+    InsertNamedThunkRelocation(ARMEmitter::Reg::r2, Op->ThunkNameHash);
+  } else {
+    auto thunkFn = ThunkHandler->LookupThunk(Op->ThunkNameHash);
+    LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r2, (uintptr_t)thunkFn);
+  }
 #ifdef VIXL_SIMULATOR
   GenerateIndirectRuntimeCall<void, void*, void*>(ARMEmitter::Reg::r2);
 #else
   blr(ARMEmitter::Reg::r2);
 #endif
 
-  PopDynamicRegsAndLR();
+  PopDynamicRegsAndLR(!GPROnly);
 
-  FillStaticRegs(); // load from ctx after ra64 refill
+  FillStaticRegs(!GPROnly, GPRSpillMask); // load from ctx after ra64 refill
 }
 
 DEF_OP(ValidateCode) {
@@ -364,7 +393,11 @@ DEF_OP(ValidateCode) {
   int idx = 0;
 
   LoadConstant(ARMEmitter::Size::i64Bit, GetReg(Node), 0);
-  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, Entry + Op->Offset);
+  if (CTX->Config.CacheObjectCodeCompilation()) {
+    InsertGuestRIPMove(ARMEmitter::Reg::r0, Op->Offset);
+  } else {
+    LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, Entry + Op->Offset);
+  }
   LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, 1);
 
   const auto Dst = GetReg(Node);
@@ -416,7 +449,11 @@ DEF_OP(ThreadRemoveCodeEntry) {
   SpillStaticRegs(TMP1);
 
   mov(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, STATE.R());
-  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, Entry);
+  if (CTX->Config.CacheObjectCodeCompilation()) {
+    InsertGuestRIPMove(ARMEmitter::Reg::r1, 0);
+  } else {
+    LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, Entry);
+  }
 
   ldr(ARMEmitter::XReg::x2, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.ThreadRemoveCodeEntryFromJIT));
 #ifdef VIXL_SIMULATOR
@@ -16,8 +16,10 @@ DEF_OP(AESImc) {
   aesimc(GetVReg(Node), GetVReg(Op->Vector.ID()));
 }
 
-DEF_OP(AESEnc) {
-  const auto Op = IROp->C<IR::IROp_VAESEnc>();
+// The round key goes in to AESE/AESD directly, with the pair kept adjacent so cores that fuse
+// AESE + AESMC and AESD + AESIMC do so.
+DEF_OP(AESEncRound) {
+  const auto Op = IROp->C<IR::IROp_VAESEncRound>();
   const auto OpSize = IROp->Size;
 
   const auto Dst = GetVReg(Node);
@@ -27,15 +29,22 @@ DEF_OP(AESEnc) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
-  eor(VTMP2.Q(), VTMP2.Q(), VTMP2.Q());
-  mov(VTMP1.Q(), State.Q());
-  aese(VTMP1, VTMP2);
-  aesmc(VTMP1, VTMP1);
-  eor(Dst.Q(), VTMP1.Q(), Key.Q());
+  if (Dst == Key) {
+    mov(VTMP1.Q(), State.Q());
+    aese(VTMP1, Key);
+    aesmc(Dst, VTMP1);
+  }
+  else {
+    if (Dst != State) {
+      mov(Dst.Q(), State.Q());
+    }
+    aese(Dst, Key);
+    aesmc(Dst, Dst);
+  }
 }
 
-DEF_OP(AESEncLast) {
-  const auto Op = IROp->C<IR::IROp_VAESEncLast>();
+DEF_OP(AESEncLastRound) {
+  const auto Op = IROp->C<IR::IROp_VAESEncLastRound>();
   const auto OpSize = IROp->Size;
 
   const auto Dst = GetVReg(Node);
@@ -45,14 +54,21 @@ DEF_OP(AESEncLast) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
-  eor(VTMP2.Q(), VTMP2.Q(), VTMP2.Q());
-  mov(VTMP1.Q(), State.Q());
-  aese(VTMP1, VTMP2);
-  eor(Dst.Q(), VTMP1.Q(), Key.Q());
+  if (Dst == Key) {
+    mov(VTMP1.Q(), State.Q());
+    aese(VTMP1, Key);
+    mov(Dst.Q(), VTMP1.Q());
+  }
+  else {
+    if (Dst != State) {
+      mov(Dst.Q(), State.Q());
+    }
+    aese(Dst, Key);
+  }
 }
 
-DEF_OP(AESDec) {
-  const auto Op = IROp->C<IR::IROp_VAESDec>();
+DEF_OP(AESDecRound) {
+  const auto Op = IROp->C<IR::IROp_VAESDecRound>();
   const auto OpSize = IROp->Size;
 
   const auto Dst = GetVReg(Node);
@@ -62,15 +78,22 @@ DEF_OP(AESDec) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
-  eor(VTMP2.Q(), VTMP2.Q(), VTMP2.Q());
-  mov(VTMP1.Q(), State.Q());
-  aesd(VTMP1, VTMP2);
-  aesimc(VTMP1, VTMP1);
-  eor(Dst.Q(), VTMP1.Q(), Key.Q());
+  if (Dst == Key) {
+    mov(VTMP1.Q(), State.Q());
+    aesd(VTMP1, Key);
+    aesimc(Dst, VTMP1);
+  }
+  else {
+    if (Dst != State) {
+      mov(Dst.Q(), State.Q());
+    }
+    aesd(Dst, Key);
+    aesimc(Dst, Dst);
+  }
 }
 
-DEF_OP(AESDecLast) {
-  const auto Op = IROp->C<IR::IROp_VAESDecLast>();
+DEF_OP(AESDecLastRound) {
+  const auto Op = IROp->C<IR::IROp_VAESDecLastRound>();
   const auto OpSize = IROp->Size;
 
   const auto Dst = GetVReg(Node);
@@ -80,10 +103,17 @@ DEF_OP(AESDecLast) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
-  eor(VTMP2.Q(), VTMP2.Q(), VTMP2.Q());
-  mov(VTMP1.Q(), State.Q());
-  aesd(VTMP1, VTMP2);
-  eor(Dst.Q(), VTMP1.Q(), Key.Q());
+  if (Dst == Key) {
+    mov(VTMP1.Q(), State.Q());
+    aesd(VTMP1, Key);
+    mov(Dst.Q(), VTMP1.Q());
+  }
+  else {
+    if (Dst != State) {
+      mov(Dst.Q(), State.Q());
+    }
+    aesd(Dst, Key);
+  }
 }
 
 DEF_OP(AESKeyGenAssist) {
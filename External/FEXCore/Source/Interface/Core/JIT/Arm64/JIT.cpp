@@ -758,7 +758,11 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
 #endif
 
 #ifndef NDEBUG
-  LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, Entry);
+  if (CTX->Config.CacheObjectCodeCompilation()) {
+    InsertGuestRIPMove(ARMEmitter::Reg::r0, 0);
+  } else {
+    LoadConstant(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, Entry);
+  }
 #endif
 
   // AAPCS64
@@ -930,10 +934,10 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
 
         // Encryption ops
         REGISTER_OP(VAESIMC,           AESImc);
-        REGISTER_OP(VAESENC,           AESEnc);
-        REGISTER_OP(VAESENCLAST,       AESEncLast);
-        REGISTER_OP(VAESDEC,           AESDec);
-        REGISTER_OP(VAESDECLAST,       AESDecLast);
+        REGISTER_OP(VAESENCROUND,      AESEncRound);
+        REGISTER_OP(VAESENCLASTROUND,  AESEncLastRound);
+        REGISTER_OP(VAESDECROUND,      AESDecRound);
+        REGISTER_OP(VAESDECLASTROUND,  AESDecLastRound);
         REGISTER_OP(VAESKEYGENASSIST,  AESKeyGenAssist);
         REGISTER_OP(CRC32,             CRC32);
         REGISTER_OP(PCLMUL,            PCLMUL);
@@ -1113,8 +1117,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
 
   // Put the block's RIP entry in the tail.
   // This will be used for RIP reconstruction in the future.
-  // TODO: This needs to be a data RIP relocation once code caching works.
-  //   Current relocation code doesn't support this feature yet.
+  // Cached code gets this rewritten by RelocateJITObjectCode.
   JITBlockTail->RIP = Entry;
 
   {
@@ -1150,6 +1153,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
 
   if (DebugData) {
     DebugData->HostCodeSize = CodeData.Size;
+    DebugData->HostCodeEntryOffset = CodeData.BlockEntry - CodeData.BlockBegin;
     DebugData->Relocations = &Relocations;
   }
 
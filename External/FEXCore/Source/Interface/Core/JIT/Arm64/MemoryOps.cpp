@@ -1701,6 +1701,28 @@ DEF_OP(MemSet) {
     ARMEmitter::BackwardLabel AgainInternal{};
     ARMEmitter::ForwardLabel DoneInternal{};
 
+    if (Direction == 1 && !Op->IsAtomic) {
+      // Store 32 bytes per iteration while there are enough elements, then let the element loop handle the tail.
+      // Only done for the non-TSO forward direction where element ordering isn't observable.
+      const uint32_t ElementsPerIteration = 32 / OpSize;
+      const auto SubEmitSize = OpSize == 8 ? ARMEmitter::SubRegSize::i64Bit :
+        OpSize == 4 ? ARMEmitter::SubRegSize::i32Bit :
+        OpSize == 2 ? ARMEmitter::SubRegSize::i16Bit : ARMEmitter::SubRegSize::i8Bit;
+      ARMEmitter::BackwardLabel AgainBulk{};
+      ARMEmitter::ForwardLabel SkipBulk{};
+
+      cmp(ARMEmitter::Size::i64Bit, TMP1, ElementsPerIteration);
+      b(ARMEmitter::Condition::CC_CC, &SkipBulk);
+      dup(SubEmitSize, VTMP1.Q(), Value);
+
+      Bind(&AgainBulk);
+      stp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP1.Q(), TMP2, 32);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, ElementsPerIteration);
+      cmp(ARMEmitter::Size::i64Bit, TMP1, ElementsPerIteration);
+      b(ARMEmitter::Condition::CC_CS, &AgainBulk);
+      Bind(&SkipBulk);
+    }
+
     // Early exit if zero count.
     cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
 
@@ -1945,6 +1967,29 @@ DEF_OP(MemCpy) {
     ARMEmitter::BackwardLabel AgainInternal{};
     ARMEmitter::ForwardLabel DoneInternal{};
 
+    if (Direction == 1 && !Op->IsAtomic) {
+      // Copy 32 bytes per iteration while there are enough elements, then let the element loop handle the tail.
+      // If the destination is less than 32 bytes ahead of the source then an element-wise copy
+      // replicates the leading bytes, which a bulk copy wouldn't, so stay on the element loop.
+      const uint32_t ElementsPerIteration = 32 / OpSize;
+      ARMEmitter::BackwardLabel AgainBulk{};
+      ARMEmitter::ForwardLabel SkipBulk{};
+
+      cmp(ARMEmitter::Size::i64Bit, TMP1, ElementsPerIteration);
+      b(ARMEmitter::Condition::CC_CC, &SkipBulk);
+      sub(TMP4, TMP2, TMP3);
+      cmp(ARMEmitter::Size::i64Bit, TMP4, 32);
+      b(ARMEmitter::Condition::CC_CC, &SkipBulk);
+
+      Bind(&AgainBulk);
+      ldp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP2.Q(), TMP3, 32);
+      stp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP2.Q(), TMP2, 32);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, ElementsPerIteration);
+      cmp(ARMEmitter::Size::i64Bit, TMP1, ElementsPerIteration);
+      b(ARMEmitter::Condition::CC_CS, &AgainBulk);
+      Bind(&SkipBulk);
+    }
+
     // Early exit if zero count.
     cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
 
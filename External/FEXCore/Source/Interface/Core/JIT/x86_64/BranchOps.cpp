@@ -79,6 +79,10 @@ DEF_OP(ExitFunction) {
     dq(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
     L(l_BranchGuest);
     dq(NewRIP);
+    if (CTX->MultiblockEdgeProfileThreshold) {
+      // Region entry for the linker to count the taken edge against
+      dq(Entry);
+    }
   } else {
     Xbyak::Reg RipReg = GetSrc<RA_64>(Op->NewRIP.ID());
 
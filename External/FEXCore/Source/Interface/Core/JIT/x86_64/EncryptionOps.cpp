@@ -19,68 +19,70 @@ DEF_OP(AESImc) {
   vaesimc(GetDst(Node), GetSrc(Op->Vector.ID()));
 }
 
-DEF_OP(AESEnc) {
-  const auto Op = IROp->C<IR::IROp_VAESEnc>();
+// The IR applies the round key before the round, so the key is added up front
+// and the x86 instruction is given a zero key.
+DEF_OP(AESEncRound) {
+  const auto Op = IROp->C<IR::IROp_VAESEncRound>();
   const auto OpSize = IROp->Size;
-  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
 
   const auto Dst = GetDst(Node);
   const auto Key = GetSrc(Op->Key.ID());
   const auto State = GetSrc(Op->State.ID());
 
-  if (Is256Bit) {
-    vaesenc(ToYMM(Dst), ToYMM(State), ToYMM(Key));
-  } else {
-    vaesenc(Dst, State, Key);
-  }
+  LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
+                      "Currently only supports 128-bit operations.");
+
+  vpxor(Dst, State, Key);
+  vpxor(xmm15, xmm15, xmm15);
+  vaesenc(Dst, Dst, xmm15);
 }
 
-DEF_OP(AESEncLast) {
-  const auto Op = IROp->C<IR::IROp_VAESEncLast>();
+DEF_OP(AESEncLastRound) {
+  const auto Op = IROp->C<IR::IROp_VAESEncLastRound>();
   const auto OpSize = IROp->Size;
-  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
 
   const auto Dst = GetDst(Node);
   const auto Key = GetSrc(Op->Key.ID());
   const auto State = GetSrc(Op->State.ID());
 
-  if (Is256Bit) {
-    vaesenclast(ToYMM(Dst), ToYMM(State), ToYMM(Key));
-  } else {
-    vaesenclast(Dst, State, Key);
-  }
+  LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
+                      "Currently only supports 128-bit operations.");
+
+  vpxor(Dst, State, Key);
+  vpxor(xmm15, xmm15, xmm15);
+  vaesenclast(Dst, Dst, xmm15);
 }
 
-DEF_OP(AESDec) {
-  const auto Op = IROp->C<IR::IROp_VAESDec>();
+DEF_OP(AESDecRound) {
+  const auto Op = IROp->C<IR::IROp_VAESDecRound>();
   const auto OpSize = IROp->Size;
-  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
 
   const auto Dst = GetDst(Node);
   const auto Key = GetSrc(Op->Key.ID());
   const auto State = GetSrc(Op->State.ID());
 
-  if (Is256Bit) {
-    vaesdec(ToYMM(Dst), ToYMM(State), ToYMM(Key));
-  } else {
-    vaesdec(Dst, State, Key);
-  }
+  LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
+                      "Currently only supports 128-bit operations.");
+
+  vpxor(Dst, State, Key);
+  vpxor(xmm15, xmm15, xmm15);
+  vaesdec(Dst, Dst, xmm15);
 }
 
-DEF_OP(AESDecLast) {
-  const auto Op = IROp->C<IR::IROp_VAESDecLast>();
+DEF_OP(AESDecLastRound) {
+  const auto Op = IROp->C<IR::IROp_VAESDecLastRound>();
   const auto OpSize = IROp->Size;
-  const auto Is256Bit = OpSize == Core::CPUState::XMM_AVX_REG_SIZE;
 
   const auto Dst = GetDst(Node);
   const auto Key = GetSrc(Op->Key.ID());
   const auto State = GetSrc(Op->State.ID());
 
-  if (Is256Bit) {
-    vaesdeclast(ToYMM(Dst), ToYMM(State), ToYMM(Key));
-  } else {
-    vaesdeclast(Dst, State, Key);
-  }
+  LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
+                      "Currently only supports 128-bit operations.");
+
+  vpxor(Dst, State, Key);
+  vpxor(xmm15, xmm15, xmm15);
+  vaesdeclast(Dst, Dst, xmm15);
 }
 
 DEF_OP(AESKeyGenAssist) {
@@ -148,10 +150,10 @@ DEF_OP(PCLMUL) {
 void X86JITCore::RegisterEncryptionHandlers() {
 #define REGISTER_OP(op, x) OpHandlers[FEXCore::IR::IROps::OP_##op] = &X86JITCore::Op_##x
   REGISTER_OP(VAESIMC,           AESImc);
-  REGISTER_OP(VAESENC,           AESEnc);
-  REGISTER_OP(VAESENCLAST,       AESEncLast);
-  REGISTER_OP(VAESDEC,           AESDec);
-  REGISTER_OP(VAESDECLAST,       AESDecLast);
+  REGISTER_OP(VAESENCROUND,      AESEncRound);
+  REGISTER_OP(VAESENCLASTROUND,  AESEncLastRound);
+  REGISTER_OP(VAESDECROUND,      AESDecRound);
+  REGISTER_OP(VAESDECLASTROUND,  AESDecLastRound);
   REGISTER_OP(VAESKEYGENASSIST,  AESKeyGenAssist);
   REGISTER_OP(CRC32,             CRC32);
   REGISTER_OP(PCLMUL,            PCLMUL);
@@ -856,6 +856,7 @@ CPUBackend::CompiledCode X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]
 
   if (DebugData) {
     DebugData->HostCodeSize = CodeData.Size;
+    DebugData->HostCodeEntryOffset = CodeData.BlockEntry - CodeData.BlockBegin;
     DebugData->Relocations = &Relocations;
   }
 
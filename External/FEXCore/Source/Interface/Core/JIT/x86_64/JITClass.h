@@ -100,9 +100,10 @@ private:
      * @brief Inserts a guest GPR move relocation
      *
      * @param Reg - The GPR to move the guest RIP in to
-     * @param Constant - The guest RIP that will be relocated
+     * @param GuestEntryOffset - Offset of the guest RIP from the block entry
+     * @param OpSize - 4 to truncate the guest RIP to 32-bit
      */
-    void InsertGuestRIPMove(Xbyak::Reg Reg, uint64_t Constant);
+    void InsertGuestRIPMove(Xbyak::Reg Reg, uint64_t GuestEntryOffset, uint8_t OpSize);
 
     /**
      * @brief Inserts a named symbol as a literal in memory
@@ -459,10 +460,10 @@ private:
 
   ///< Encryption ops
   DEF_OP(AESImc);
-  DEF_OP(AESEnc);
-  DEF_OP(AESEncLast);
-  DEF_OP(AESDec);
-  DEF_OP(AESDecLast);
+  DEF_OP(AESEncRound);
+  DEF_OP(AESEncLastRound);
+  DEF_OP(AESDecRound);
+  DEF_OP(AESDecLastRound);
   DEF_OP(AESKeyGenAssist);
   DEF_OP(CRC32);
   DEF_OP(PCLMUL);
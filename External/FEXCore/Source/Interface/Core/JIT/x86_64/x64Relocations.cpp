@@ -67,16 +67,19 @@ void X86JITCore::PlaceNamedSymbolLiteral(NamedSymbolLiteralPair &Lit) {
 }
 
 
-void X86JITCore::InsertGuestRIPMove(Xbyak::Reg Reg, uint64_t Constant) {
+void X86JITCore::InsertGuestRIPMove(Xbyak::Reg Reg, uint64_t GuestEntryOffset, uint8_t OpSize) {
   Relocation MoveABI{};
   MoveABI.GuestRIPMove.Header.Type = FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE;
 
   // Offset is the offset from the entrypoint of the block
   auto CurrentCursor = getSize();
   MoveABI.GuestRIPMove.Offset = CurrentCursor - CursorEntry;
-  MoveABI.GuestRIPMove.GuestRIP = Constant;
+  MoveABI.GuestRIPMove.GuestEntryOffset = GuestEntryOffset;
+  MoveABI.GuestRIPMove.OpSize = OpSize;
   MoveABI.GuestRIPMove.RegisterIndex = Reg.getIdx();
 
+  const uint64_t Constant = GetRelocatedGuestRIP(Entry, GuestEntryOffset, OpSize);
+
   if (CTX->Config.CacheObjectCodeCompilation()) {
     LoadConstantWithPadding(Reg, Constant);
   }
@@ -117,19 +120,18 @@ bool X86JITCore::ApplyRelocations(uint64_t GuestEntry, uint64_t CodeEntry, uint6
         DataIndex += sizeof(Reloc->NamedThunkMove);
         break;
       }
-      case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE:
-        // XXX: Reenable once the JIT Object Cache is upstream
-        // XXX: Should spin the relocation list, create a list of guest RIP moves, and ask for them all once, reduces lock contention.
-        uint64_t Pointer = ~0ULL; // EmitterCTX->JITObjectCache->FindRelocatedRIP(Reloc->GuestRIPMove.GuestRIP);
-        if (Pointer == ~0ULL) {
-          return false;
-        }
+      case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE: {
+        uint64_t Pointer = GetRelocatedGuestRIP(GuestEntry, Reloc->GuestRIPMove.GuestEntryOffset, Reloc->GuestRIPMove.OpSize);
 
         // Relocation occurs at the cursorEntry + offset relative to that cursor.
         setSize(CursorEntry + Reloc->GuestRIPMove.Offset);
         LoadConstantWithPadding(Xbyak::Reg64(Reloc->GuestRIPMove.RegisterIndex), Pointer);
         DataIndex += sizeof(Reloc->GuestRIPMove);
         break;
+      }
+      case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL:
+        // x86-64 host code isn't cached
+        return false;
     }
   }
 
@@ -77,5 +77,19 @@ void LookupCache::ClearCache() {
   BlockList.clear();
 }
 
+void LookupCache::Reset() {
+  std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+  FEXCore::Allocator::VirtualDontNeed(reinterpret_cast<void*>(PagePointer), TotalCacheSize);
+  AllocateOffset = 0;
+
+  // Drop every block link the previous thread allocated rather than leaving them in the MBR.
+  BlockLinks_mbr.release();
+  BlockLinks = BlockLinks_pma->new_object<BlockLinksMapType>();
+
+  BlockList.clear();
+  CodePages.clear();
+}
+
 }
 
@@ -149,6 +149,8 @@ public:
 
   void ClearCache();
   void ClearL2Cache();
+  // Returns the cache to its freshly constructed state so it can be handed to a new thread.
+  void Reset();
 
   uintptr_t GetL1Pointer() const { return L1Pointer; }
   uintptr_t GetPagePointer() const { return PagePointer; }
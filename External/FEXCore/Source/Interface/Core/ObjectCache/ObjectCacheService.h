@@ -26,6 +26,10 @@ namespace FEXCore::CodeSerialize {
     bool Invalid;
     const CodeSerializationData *Data;
     const char *HostCode;
+    // Size of the host code, from the block's code header to the end of its tail
+    uint64_t HostCodeSize;
+    // Offset of the block's entrypoint in to the host code
+    uint64_t HostCodeEntryOffset;
     uint64_t NumRelocations;
     const char *Relocations;
   };
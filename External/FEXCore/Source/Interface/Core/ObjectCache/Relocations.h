@@ -18,6 +18,10 @@ namespace FEXCore::CPU {
     // 64-bit mov on x86-64
     // Aligned to struct RelocGuestRIPMove
     RELOC_GUEST_RIP_MOVE,
+
+    // 8 byte literal in memory for a guest RIP
+    // Aligned to struct RelocGuestRIPLiteral
+    RELOC_GUEST_RIP_LITERAL,
   };
 
   struct RelocationTypeHeader final {
@@ -58,11 +62,27 @@ namespace FEXCore::CPU {
     // GPR index the constant is being moved to
     uint8_t RegisterIndex;
 
+    // Size of the guest RIP, 4 byte RIPs are truncated to 32-bit
+    uint8_t OpSize;
+
+    // Offset in to the code section to begin the relocation
+    uint64_t Offset{};
+
+    // Offset of the RIP from the guest entrypoint of the block
+    uint64_t GuestEntryOffset;
+  };
+
+  struct RelocGuestRIPLiteral final {
+    RelocationTypeHeader Header{};
+
+    // Size of the guest RIP, 4 byte RIPs are truncated to 32-bit
+    uint8_t OpSize;
+
     // Offset in to the code section to begin the relocation
     uint64_t Offset{};
 
-    // The unrelocated RIP that is being moved
-    uint64_t GuestRIP;
+    // Offset of the RIP from the guest entrypoint of the block
+    uint64_t GuestEntryOffset;
   };
 
   union Relocation {
@@ -74,5 +94,13 @@ namespace FEXCore::CPU {
     RelocNamedThunkMove NamedThunkMove;
 
     RelocGuestRIPMove GuestRIPMove;
+
+    RelocGuestRIPLiteral GuestRIPLiteral;
   };
+
+  // Guest RIPs are stored relative to the block entry so the code can be loaded wherever the guest maps the code next time
+  inline uint64_t GetRelocatedGuestRIP(uint64_t GuestEntry, uint64_t GuestEntryOffset, uint8_t OpSize) {
+    const uint64_t RIP = GuestEntry + GuestEntryOffset;
+    return OpSize == 4 ? (RIP & 0xFFFF'FFFFULL) : RIP;
+  }
 }
@@ -105,6 +105,8 @@ void OpDispatchBuilder::SyscallOp(OpcodeArgs) {
 
   // Calculate flags early.
   CalculateDeferredFlags();
+  // The syscall handler reads and may replace the flags in the context
+  FlushNZCV();
 
   const uint8_t GPRSize = CTX->GetGPRSize();
   auto NewRIP = GetRelocatedPC(Op, -Op->InstSize);
@@ -152,6 +154,7 @@ void OpDispatchBuilder::SyscallOp(OpcodeArgs) {
 void OpDispatchBuilder::ThunkOp(OpcodeArgs) {
   // Calculate flags early.
   CalculateDeferredFlags();
+  FlushNZCV();
 
   const uint8_t GPRSize = CTX->GetGPRSize();
   uint8_t *sha256 = (uint8_t *)(Op->PC + 2);
@@ -216,7 +219,7 @@ void OpDispatchBuilder::RETOp(OpcodeArgs) {
 
   // ABI Optimization: Flags don't survive calls or rets
   if (CTX->Config.ABILocalFlags) {
-    _InvalidateFlags(~0UL); // all flags
+    InvalidateFlags(~0UL); // all flags
     // Deferred flags are invalidated now
     InvalidateDeferredFlags();
   }
@@ -781,7 +784,7 @@ void OpDispatchBuilder::CALLOp(OpcodeArgs) {
 
   // ABI Optimization: Flags don't survive calls or rets
   if (CTX->Config.ABILocalFlags) {
-    _InvalidateFlags(~0UL); // all flags
+    InvalidateFlags(~0UL); // all flags
     // Deferred flags are invalidated now
     InvalidateDeferredFlags();
   }
@@ -1651,6 +1654,8 @@ void OpDispatchBuilder::MOVSegOp(OpcodeArgs) {
       case FEXCore::X86State::REG_RCX: // CS
       case FEXCore::X86State::REG_R9: // CS
         // CPL3 can't write to this
+        // The block carries on after the Break, so the flags need to be written for the signal here
+        StoreNZCV();
         _Break(FEXCore::IR::BreakDefinition {
             .ErrorRegister = 0,
             .Signal = SIGILL,
@@ -4685,6 +4690,8 @@ void OpDispatchBuilder::Finalize() {
   // Calculate flags early.
   // This usually doesn't emit any IR but in the case of hitting the block instruction limit it will
   CalculateDeferredFlags();
+  // The last block isn't left through SetCurrentCodeBlock
+  CodeBlockEnded();
   const uint8_t GPRSize = CTX->GetGPRSize();
 
   // Node 0 is invalid node
@@ -5244,6 +5251,7 @@ void OpDispatchBuilder::ResetWorkingList() {
   DecodeFailure = false;
   ShouldDump = false;
   CurrentCodeBlock = nullptr;
+  ResetNZCV();
 }
 
 void OpDispatchBuilder::UnhandledOp(OpcodeArgs) {
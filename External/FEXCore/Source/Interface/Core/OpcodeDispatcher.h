@@ -15,6 +15,8 @@
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <fmt/format.h>
 #include <stddef.h>
@@ -148,6 +150,20 @@ public:
     return CanHaveSideEffects;
   }
 
+  // Unlike CanHaveSideEffects this only counts operands that really are memory
+  static bool CanFault(FEXCore::X86Tables::X86InstInfo const* TableInfo, FEXCore::X86Tables::DecodedOp Op) {
+    if (TableInfo && TableInfo->Flags & X86Tables::InstFlags::FLAGS_DEBUG_MEM_ACCESS) {
+      // Implicit memory accesses, stack and string operations
+      return true;
+    }
+
+    auto IsMemory = [](X86Tables::DecodedOperand const &Operand) -> bool {
+      return Operand.IsGPRIndirect() || Operand.IsRIPRelative() || Operand.IsSIB();
+    };
+
+    return IsMemory(Op->Dest) || IsMemory(Op->Src[0]) || IsMemory(Op->Src[1]) || IsMemory(Op->Src[2]);
+  }
+
   OpDispatchBuilder(FEXCore::Context::ContextImpl *ctx);
   OpDispatchBuilder(FEXCore::Utils::IntrusivePooledAllocator &Allocator);
 
@@ -811,6 +827,13 @@ public:
 
   void SetMultiblock(bool _Multiblock) { Multiblock = _Multiblock; }
 
+  // Stops tracking flags that were invalidated and emits the InvalidateFlags op
+  void InvalidateFlags(uint64_t Flags);
+
+  // Writes CF, ZF, SF and OF set in the current block to the context, before an instruction that can fault.
+  // Signal frames are built from the context, so they see the flags of every instruction before the fault.
+  void StoreNZCV();
+
 private:
   enum class SelectionFlag {
     Nothing,  // must rely on x86 flags
@@ -833,6 +856,41 @@ private:
   OrderedNode* flagsOpDestSigned{};
   OrderedNode* flagsOpSrcSigned{};
 
+  /**
+   * @name CF, ZF, SF and OF tracking.
+   *
+   * These four flags live in the NZCV word in the context. Values set in the current block are tracked here,
+   * then written to the NZCV word with a single store when the block ends, the JIT calls out, or before an
+   * instruction that can fault.
+   * @{ */
+  // Indexed by the flag's NZCV bit - NZCV_OF_LOC, nullptr if not set in this block
+  std::array<OrderedNode*, 4> NZCVFlags{};
+  // The NZCV word loaded from or last stored to the context in this block
+  OrderedNode *CachedNZCV{};
+  // Bit per NZCVFlags entry that hasn't been written to the context yet
+  uint8_t NZCVDirty{};
+
+  static constexpr size_t NZCVFlagIndex(unsigned BitOffset) {
+    return Core::CPUState::GetNZCVBit(BitOffset) - X86State::NZCV_OF_LOC;
+  }
+
+  bool IsNZCVDirty() const {
+    return NZCVDirty != 0;
+  }
+
+  void ResetNZCV() {
+    NZCVFlags.fill(nullptr);
+    CachedNZCV = nullptr;
+    NZCVDirty = 0;
+  }
+
+  OrderedNode *LoadNZCV();
+  // Writes the tracked flags to the context and stops tracking them, before the JIT calls out
+  void FlushNZCV();
+  // The one place blocks end, the tracked flags are written in front of the op that ends the block
+  void CodeBlockEnded() override;
+  /**  @} */
+
   fextl::map<uint64_t, JumpTargetInfo> JumpTargets;
   bool HandledLock{false};
   bool DecodeFailure{false};
@@ -1042,18 +1100,21 @@ private:
 
   template<unsigned BitOffset>
   void SetRFLAG(OrderedNode *Value) {
-    flagsOp = SelectionFlag::Nothing;
-    _StoreFlag(Value, BitOffset);
+    SetRFLAG(Value, BitOffset);
   }
 
-  void SetRFLAG(OrderedNode *Value, unsigned BitOffset) {
-    flagsOp = SelectionFlag::Nothing;
-    _StoreFlag(Value, BitOffset);
-  }
+  void SetRFLAG(OrderedNode *Value, unsigned BitOffset);
+  OrderedNode *GetRFLAG(unsigned BitOffset);
 
-  OrderedNode *GetRFLAG(unsigned BitOffset) {
-    return _LoadFlag(BitOffset);
-  }
+  /**
+   * @name PF and AF are stored raw and only calculated when they are read.
+   *
+   * PF is the even parity of the bottom byte of the result.
+   * AF is bit 4 of `Src1 ^ Src2 ^ Result`.
+   * @{ */
+  void SetPFRaw(OrderedNode *Result);
+  void SetAFRaw(OrderedNode *Result);
+  /**  @} */
 
   OrderedNode *SelectCC(uint8_t OP, OrderedNode *TrueValue, OrderedNode *FalseValue);
 
@@ -278,10 +278,14 @@ void OpDispatchBuilder::VAESIMCOp(OpcodeArgs) {
   StoreResult(FPRClass, Op, Result, -1);
 }
 
+// x86 adds the round key at the end of a round while AArch64 adds it at the start.
+// Each round is emitted with a zero key followed by the x86 key XOR, ConstProp then folds
+// that XOR in to the key of the next round so a chain becomes back to back AESE + AESMC.
 void OpDispatchBuilder::AESEncOp(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
-  OrderedNode *Result = _VAESEnc(16, Dest, Src);
+  OrderedNode *Round = _VAESEncRound(16, Dest, _VectorZero(16));
+  OrderedNode *Result = _VXor(16, 1, Round, Src);
   StoreResult(FPRClass, Op, Result, -1);
 }
 
@@ -294,7 +298,8 @@ void OpDispatchBuilder::VAESEncOp(OpcodeArgs) {
 
   OrderedNode *State = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
   OrderedNode *Key = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
-  OrderedNode *Result = _VAESEnc(DstSize, State, Key);
+  OrderedNode *Round = _VAESEncRound(DstSize, State, _VectorZero(DstSize));
+  OrderedNode *Result = _VXor(DstSize, 1, Round, Key);
 
   if (Is128Bit) {
     Result = _VMov(16, Result);
@@ -305,7 +310,8 @@ void OpDispatchBuilder::VAESEncOp(OpcodeArgs) {
 void OpDispatchBuilder::AESEncLastOp(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
-  OrderedNode *Result = _VAESEncLast(16, Dest, Src);
+  OrderedNode *Round = _VAESEncLastRound(16, Dest, _VectorZero(16));
+  OrderedNode *Result = _VXor(16, 1, Round, Src);
   StoreResult(FPRClass, Op, Result, -1);
 }
 
@@ -318,7 +324,8 @@ void OpDispatchBuilder::VAESEncLastOp(OpcodeArgs) {
 
   OrderedNode *State = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
   OrderedNode *Key = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
-  OrderedNode *Result = _VAESEncLast(DstSize, State, Key);
+  OrderedNode *Round = _VAESEncLastRound(DstSize, State, _VectorZero(DstSize));
+  OrderedNode *Result = _VXor(DstSize, 1, Round, Key);
 
   if (Is128Bit) {
     Result = _VMov(16, Result);
@@ -329,7 +336,8 @@ void OpDispatchBuilder::VAESEncLastOp(OpcodeArgs) {
 void OpDispatchBuilder::AESDecOp(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
-  OrderedNode *Result = _VAESDec(16, Dest, Src);
+  OrderedNode *Round = _VAESDecRound(16, Dest, _VectorZero(16));
+  OrderedNode *Result = _VXor(16, 1, Round, Src);
   StoreResult(FPRClass, Op, Result, -1);
 }
 
@@ -342,7 +350,8 @@ void OpDispatchBuilder::VAESDecOp(OpcodeArgs) {
 
   OrderedNode *State = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
   OrderedNode *Key = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
-  OrderedNode *Result = _VAESDec(DstSize, State, Key);
+  OrderedNode *Round = _VAESDecRound(DstSize, State, _VectorZero(DstSize));
+  OrderedNode *Result = _VXor(DstSize, 1, Round, Key);
 
   if (Is128Bit) {
     Result = _VMov(16, Result);
@@ -353,7 +362,8 @@ void OpDispatchBuilder::VAESDecOp(OpcodeArgs) {
 void OpDispatchBuilder::AESDecLastOp(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
-  OrderedNode *Result = _VAESDecLast(16, Dest, Src);
+  OrderedNode *Round = _VAESDecLastRound(16, Dest, _VectorZero(16));
+  OrderedNode *Result = _VXor(16, 1, Round, Src);
   StoreResult(FPRClass, Op, Result, -1);
 }
 
@@ -366,7 +376,8 @@ void OpDispatchBuilder::VAESDecLastOp(OpcodeArgs) {
 
   OrderedNode *State = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
   OrderedNode *Key = LoadSource(FPRClass, Op, Op->Src[1], Op->Flags, -1);
-  OrderedNode *Result = _VAESDecLast(DstSize, State, Key);
+  OrderedNode *Round = _VAESDecLastRound(DstSize, State, _VectorZero(DstSize));
+  OrderedNode *Result = _VXor(DstSize, 1, Round, Key);
 
   if (Is128Bit) {
     Result = _VMov(16, Result);
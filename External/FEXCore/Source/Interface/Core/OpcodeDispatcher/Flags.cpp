@@ -14,6 +14,7 @@ $end_info$
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/IR/IR.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 
@@ -38,6 +39,147 @@ constexpr std::array<uint32_t, 17> FlagOffsets = {
   FEXCore::X86State::RFLAG_ID_LOC,
 };
 
+void OpDispatchBuilder::SetRFLAG(OrderedNode *Value, unsigned BitOffset) {
+  flagsOp = SelectionFlag::Nothing;
+
+  switch (BitOffset) {
+    case FEXCore::X86State::RFLAG_CF_LOC:
+    case FEXCore::X86State::RFLAG_ZF_LOC:
+    case FEXCore::X86State::RFLAG_SF_LOC:
+    case FEXCore::X86State::RFLAG_OF_LOC:
+      // Inserted in to the NZCV word when the block is left or before an instruction that can fault
+      NZCVFlags[NZCVFlagIndex(BitOffset)] = Value;
+      NZCVDirty |= 1U << NZCVFlagIndex(BitOffset);
+      break;
+    case FEXCore::X86State::RFLAG_PF_LOC:
+      // Any byte with odd parity means PF is clear
+      _StoreFlag(_Xor(Value, _Constant(1)), BitOffset);
+      break;
+    case FEXCore::X86State::RFLAG_AF_LOC:
+      _StoreFlag(_Lshl(Value, _Constant(4)), BitOffset);
+      break;
+    default:
+      _StoreFlag(Value, BitOffset);
+      break;
+  }
+}
+
+OrderedNode *OpDispatchBuilder::GetRFLAG(unsigned BitOffset) {
+  switch (BitOffset) {
+    case FEXCore::X86State::RFLAG_CF_LOC:
+    case FEXCore::X86State::RFLAG_ZF_LOC:
+    case FEXCore::X86State::RFLAG_SF_LOC:
+    case FEXCore::X86State::RFLAG_OF_LOC: {
+      if (auto Flag = NZCVFlags[NZCVFlagIndex(BitOffset)]) {
+        return Flag;
+      }
+
+      return _Bfe(4, 1, Core::CPUState::GetNZCVBit(BitOffset), LoadNZCV());
+    }
+    case FEXCore::X86State::RFLAG_PF_LOC: {
+      // Flipping any bit of the raw byte before the popcount gives us a set bottom bit for even parity.
+      // Only the bottom bit of the result is valid, the rest of the byte is garbage.
+      auto Flipped = _Xor(_LoadFlag(BitOffset), _Constant(1));
+
+      // Cast the input to a 32-bit FPR. Logically we only need 8-bit, but that would
+      // generate unwanted an ubfx instruction. VPopcount will ignore the upper bits anyway.
+      auto InputFPR = _VCastFromGPR(4, 4, Flipped);
+      auto Count = _VPopcount(1, 1, InputFPR);
+      return _VExtractToGPR(8, 1, Count, 0);
+    }
+    case FEXCore::X86State::RFLAG_AF_LOC:
+      return _Bfe(1, 4, _LoadFlag(BitOffset));
+    default:
+      return _LoadFlag(BitOffset);
+  }
+}
+
+void OpDispatchBuilder::SetPFRaw(OrderedNode *Result) {
+  flagsOp = SelectionFlag::Nothing;
+  _StoreFlag(Result, FEXCore::X86State::RFLAG_PF_LOC);
+}
+
+void OpDispatchBuilder::SetAFRaw(OrderedNode *Result) {
+  flagsOp = SelectionFlag::Nothing;
+  _StoreFlag(Result, FEXCore::X86State::RFLAG_AF_LOC);
+}
+
+OrderedNode *OpDispatchBuilder::LoadNZCV() {
+  if (!CachedNZCV) {
+    CachedNZCV = _LoadContext(4, GPRClass, offsetof(FEXCore::Core::CPUState, flags[FEXCore::X86State::FLAG_NZCV_OFFSET]));
+  }
+
+  return CachedNZCV;
+}
+
+void OpDispatchBuilder::StoreNZCV() {
+  if (!IsNZCVDirty()) {
+    return;
+  }
+
+  // Only need the old word if some of the flags weren't set since it was last loaded or stored
+  const bool AllSet = NZCVDirty == (1U << NZCVFlags.size()) - 1;
+  OrderedNode *NZCV = AllSet ? _Constant(0) : LoadNZCV();
+
+  for (size_t i = 0; i < NZCVFlags.size(); ++i) {
+    if (NZCVDirty & (1U << i)) {
+      NZCV = _Bfi(4, 1, X86State::NZCV_OF_LOC + i, NZCV, NZCVFlags[i]);
+    }
+  }
+
+  _StoreContext(4, GPRClass, NZCV, offsetof(FEXCore::Core::CPUState, flags[FEXCore::X86State::FLAG_NZCV_OFFSET]));
+
+  // A later store only needs to insert the flags set after this one
+  CachedNZCV = NZCV;
+  NZCVDirty = 0;
+}
+
+void OpDispatchBuilder::FlushNZCV() {
+  StoreNZCV();
+
+  // Whatever is after this point may have changed the word in the context, load it again if needed
+  ResetNZCV();
+}
+
+void OpDispatchBuilder::CodeBlockEnded() {
+  if (IsNZCVDirty()) {
+    auto LastOp = GetWriteCursor();
+
+    switch (GetOpType(LastOp)) {
+      case OP_JUMP:
+      case OP_CONDJUMP:
+      case OP_EXITFUNCTION:
+      case OP_BREAK:
+      case OP_CALLBACKRETURN: {
+        // The store goes between the block's last op and the ops before it
+        SetWriteCursor(LastOp->Header.Previous.GetNode(DualListData.ListBegin()));
+        StoreNZCV();
+        SetWriteCursor(LastOp);
+        break;
+      }
+      default:
+        // The block falls through to whatever continues it
+        StoreNZCV();
+        break;
+    }
+  }
+
+  // The next block loads the NZCV word again if it needs it
+  ResetNZCV();
+}
+
+void OpDispatchBuilder::InvalidateFlags(uint64_t Flags) {
+  // Dead flags don't need to be written back
+  for (const auto Flag : {X86State::RFLAG_CF_LOC, X86State::RFLAG_ZF_LOC, X86State::RFLAG_SF_LOC, X86State::RFLAG_OF_LOC}) {
+    if (Flags & (1ULL << Flag)) {
+      NZCVFlags[NZCVFlagIndex(Flag)] = nullptr;
+      NZCVDirty &= ~(1U << NZCVFlagIndex(Flag));
+    }
+  }
+
+  _InvalidateFlags(Flags);
+}
+
 void OpDispatchBuilder::SetPackedRFLAG(bool Lower8, OrderedNode *Src) {
   size_t NumFlags = FlagOffsets.size();
   if (Lower8) {
@@ -72,7 +214,7 @@ OrderedNode *OpDispatchBuilder::GetPackedRFLAG(uint32_t FlagsMask) {
 
     // Note that the Bfi only considers the bottom bit of the flag, the rest of
     // the byte is allowed to be garbage. PF relies on this.
-    OrderedNode *Flag = _LoadFlag(FlagOffset);
+    OrderedNode *Flag = GetRFLAG(FlagOffset);
     Original = _Bfi(4, 1, FlagOffset, Original, Flag);
   }
   return Original;
@@ -87,27 +229,15 @@ void OpDispatchBuilder::CalculateOF_Add(uint8_t SrcSize, OrderedNode *Res, Order
 }
 
 void OpDispatchBuilder::CalculatePFUncheckedABI(OrderedNode *Res) {
-  // We will use the bottom bit of the popcount, set if an odd number of bits are set.
-  // But the x86 parity flag is supposed to be set for an even number of bits.
-  // Simply invert any bit of the input GPR and that will invert the bottom bit of the
-  // output FPR.
-  auto Flipped = _Xor(Res, _Constant(1));
-
-  // Cast the input to a 32-bit FPR. Logically we only need 8-bit, but that would
-  // generate unwanted an ubfx instruction. VPopcount will ignore the upper bits anyway.
-  auto InputFPR = _VCastFromGPR(4, 4, Flipped);
-
-  // Store the popcount. When reading, only the bottom bit will be used.
-  auto Count = _VPopcount(1, 1, InputFPR);
-  auto Parity = _VExtractToGPR(8, 1, Count, 0);
-  SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(Parity);
+  // The parity is only calculated if PF is read, see GetRFLAG.
+  SetPFRaw(Res);
 }
 
 void OpDispatchBuilder::CalculatePF(OrderedNode *Res) {
   if (!CTX->Config.ABINoPF) {
     CalculatePFUncheckedABI(Res);
   } else {
-    _InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
+    InvalidateFlags(1UL << FEXCore::X86State::RFLAG_PF_LOC);
   }
 }
 
@@ -296,9 +426,8 @@ void OpDispatchBuilder::CalculateFlags_ADC(uint8_t SrcSize, OrderedNode *Res, Or
   auto One = _Constant(1);
   // AF
   {
-    OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
+    // AF is bit 4 of the raw value, only extracted if it is read
+    SetAFRaw(_Xor(_Xor(Src1, Src2), Res));
   }
 
   // SF
@@ -335,9 +464,8 @@ void OpDispatchBuilder::CalculateFlags_SBB(uint8_t SrcSize, OrderedNode *Res, Or
 
   // AF
   {
-    OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
+    // AF is bit 4 of the raw value, only extracted if it is read
+    SetAFRaw(_Xor(_Xor(Src1, Src2), Res));
   }
 
   // SF
@@ -381,9 +509,8 @@ void OpDispatchBuilder::CalculateFlags_SUB(uint8_t SrcSize, OrderedNode *Res, Or
 
   // AF
   {
-    OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
+    // AF is bit 4 of the raw value, only extracted if it is read
+    SetAFRaw(_Xor(_Xor(Src1, Src2), Res));
   }
 
   // SF
@@ -426,9 +553,8 @@ void OpDispatchBuilder::CalculateFlags_ADD(uint8_t SrcSize, OrderedNode *Res, Or
 
   // AF
   {
-    OrderedNode *AFRes = _Xor(_Xor(Src1, Src2), Res);
-    AFRes = _Bfe(1, 4, AFRes);
-    SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(AFRes);
+    // AF is bit 4 of the raw value, only extracted if it is read
+    SetAFRaw(_Xor(_Xor(Src1, Src2), Res));
   }
 
   // SF
@@ -958,7 +1084,7 @@ void OpDispatchBuilder::CalculateFlags_BEXTR(OrderedNode *Src) {
 
   // PF
   if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
+    InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
   } else {
     SetRFLAG<X86State::RFLAG_PF_LOC>(Zero);
   }
@@ -988,7 +1114,7 @@ void OpDispatchBuilder::CalculateFlags_BLSI(uint8_t SrcSize, OrderedNode *Src) {
   SetRFLAG<X86State::RFLAG_OF_LOC>(Zero);
   SetRFLAG<X86State::RFLAG_AF_LOC>(Zero);
   if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
+    InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
   } else {
     SetRFLAG<X86State::RFLAG_PF_LOC>(Zero);
   }
@@ -1026,7 +1152,7 @@ void OpDispatchBuilder::CalculateFlags_BLSMSK(OrderedNode *Src) {
   SetRFLAG<X86State::RFLAG_OF_LOC>(Zero);
   SetRFLAG<X86State::RFLAG_AF_LOC>(Zero);
   if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
+    InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
   } else {
     SetRFLAG<X86State::RFLAG_PF_LOC>(Zero);
   }
@@ -1045,7 +1171,7 @@ void OpDispatchBuilder::CalculateFlags_BLSR(uint8_t SrcSize, OrderedNode *Result
   SetRFLAG<X86State::RFLAG_OF_LOC>(Zero);
   SetRFLAG<X86State::RFLAG_AF_LOC>(Zero);
   if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
+    InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
   } else {
     SetRFLAG<X86State::RFLAG_PF_LOC>(Zero);
   }
@@ -1099,7 +1225,7 @@ void OpDispatchBuilder::CalculateFlags_BZHI(uint8_t SrcSize, OrderedNode *Result
   SetRFLAG<X86State::RFLAG_OF_LOC>(Zero);
   SetRFLAG<X86State::RFLAG_AF_LOC>(Zero);
   if (CTX->Config.ABINoPF) {
-    _InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
+    InvalidateFlags(1UL << X86State::RFLAG_PF_LOC);
   } else {
     SetRFLAG<X86State::RFLAG_PF_LOC>(Zero);
   }
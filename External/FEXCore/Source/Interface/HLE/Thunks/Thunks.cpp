@@ -15,6 +15,7 @@ $end_info$
 #include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/unordered_set.h>
 #include "Thunks.h"
 
 #include <cstdint>
@@ -156,6 +157,9 @@ namespace FEXCore {
             },
         };
 
+        // Thunks registered with ThunkDefinition::GPROnly
+        fextl::unordered_set<IR::SHA256Sum, TruncatingSHA256Hash> GPROnlyThunks;
+
         // Can't be a string_view. We need to keep a copy of the library name in-case string_view pointer goes away.
         // Ideally we track when a library has been unloaded and remove it from this set before the memory backing goes away.
         fextl::set<fextl::string> Libs;
@@ -360,6 +364,11 @@ namespace FEXCore {
             }
         }
 
+        bool IsGPROnlyThunk(const IR::SHA256Sum &sha256) override {
+            std::shared_lock lk(ThunksMutex);
+            return GPROnlyThunks.contains(sha256);
+        }
+
         void RegisterTLSState(FEXCore::Core::InternalThreadState *_Thread) override {
           Thread = _Thread;
         }
@@ -367,6 +376,9 @@ namespace FEXCore {
         void AppendThunkDefinitions(fextl::vector<FEXCore::IR::ThunkDefinition> const& Definitions) override {
           for (auto & Definition : Definitions) {
             Thunks.emplace(Definition.Sum, Definition.ThunkFunction);
+            if (Definition.GPROnly) {
+              GPROnlyThunks.emplace(Definition.Sum);
+            }
           }
         }
     };
@@ -1,20 +1,32 @@
 #include "FEXHeaderUtils/Filesystem.h"
 #include "Interface/Context/Context.h"
+#include "Interface/Core/ObjectCache/Relocations.h"
 #include "Interface/IR/AOTIR.h"
+#include "git_version.h"
 
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/IR/RegisterAllocationData.h>
+#include <FEXCore/Core/HostFeatures.h>
 #include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
 
 #include <Interface/Core/LookupCache.h>
 #include <Interface/GDBJIT/GDBJIT.h>
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <mutex>
+#ifndef _WIN32
+#include "Common/ELFBuildId.h"
+
+#include <elf.h>
+#endif
 #include <sys/stat.h>
 #include <unistd.h>
 #include <xxhash.h>
@@ -45,8 +57,16 @@ namespace FEXCore::IR {
     return nullptr;
   }
 
+  const char *AOTIRInlineEntry::GetHostCode() {
+    return (const char *)InlineData;
+  }
+
+  const char *AOTIRInlineEntry::GetRelocations() {
+    return (const char *)&InlineData[FEXCore::AlignUp(HostCodeSize, 8)];
+  }
+
   IR::RegisterAllocationData *AOTIRInlineEntry::GetRAData() {
-    return (IR::RegisterAllocationData *)InlineData;
+    return (IR::RegisterAllocationData *)&InlineData[FEXCore::AlignUp(HostCodeSize, 8) + RelocationsSize];
   }
 
   IR::IRListView *AOTIRInlineEntry::GetIRData() {
@@ -56,21 +76,39 @@ namespace FEXCore::IR {
     return (IR::IRListView *)&InlineData[Offset];
   }
 
-  void AOTIRCaptureCacheEntry::AppendAOTIRCaptureCache(uint64_t GuestRIP, uint64_t Start, uint64_t Length, uint64_t Hash, FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData *RAData) {
-    auto Inserted = Index.emplace(GuestRIP, Stream->Offset());
+  void AOTIRCaptureCacheEntry::AppendAOTIRCaptureCache(uint64_t GuestRIP, uint64_t Start, uint64_t Length, uint64_t Hash, FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData *RAData, const AOTIRHostCode &HostCode) {
+    if (Index.contains(GuestRIP)) {
+      return;
+    }
 
-    if (Inserted.second) {
-      //GuestHash
-      Stream->Write((const char*)&Hash, sizeof(Hash));
+    // Keep the entries aligned so the relocations can be read in place
+    constexpr char Zero[8]{};
+    Stream->Write(Zero, FEXCore::AlignUp(Stream->Offset(), 8) - Stream->Offset());
 
-      //GuestLength
-      Stream->Write((const char*)&Length, sizeof(Length));
+    Index.emplace(GuestRIP, Stream->Offset());
 
-      RAData->Serialize(*Stream);
+    //GuestHash
+    Stream->Write((const char*)&Hash, sizeof(Hash));
 
-      // IRData (inline)
-      IRList->Serialize(*Stream);
-    }
+    //GuestLength
+    Stream->Write((const char*)&Length, sizeof(Length));
+
+    const uint64_t HostCodeSize = HostCode.Code.size();
+    const uint64_t RelocationsSize = HostCode.Relocations.size();
+    Stream->Write((const char*)&HostCodeSize, sizeof(HostCodeSize));
+    Stream->Write((const char*)&HostCode.EntryOffset, sizeof(HostCode.EntryOffset));
+    Stream->Write((const char*)&HostCode.NumRelocations, sizeof(HostCode.NumRelocations));
+    Stream->Write((const char*)&RelocationsSize, sizeof(RelocationsSize));
+
+    // Host code (inline), padded so the relocations stay aligned
+    Stream->Write((const char*)HostCode.Code.data(), HostCodeSize);
+    Stream->Write(Zero, FEXCore::AlignUp(HostCodeSize, 8) - HostCodeSize);
+    Stream->Write((const char*)HostCode.Relocations.data(), RelocationsSize);
+
+    RAData->Serialize(*Stream);
+
+    // IRData (inline)
+    IRList->Serialize(*Stream);
   }
 
   static bool readAll(int fd, void *data, size_t size) {
@@ -82,7 +120,69 @@ namespace FEXCore::IR {
       return true;
   }
 
-  static bool LoadAOTIRCache(AOTIRCacheEntry *Entry, int streamfd) {
+  // Host code depends on the FEX build, the host features the backend picked instructions for
+  // and every option that changes how the IR is lowered, on top of the IR
+  static uint64_t GetHostCodeConfig(FEXCore::Context::ContextImpl *CTX) {
+    const auto &Features = CTX->HostFeatures;
+    const auto &Config = CTX->Config;
+    const bool FeatureBits[] = {
+      Features.SupportsAES, Features.SupportsCRC, Features.SupportsCLZERO, Features.SupportsAtomics,
+      Features.SupportsRCPC, Features.SupportsTSOImm9, Features.SupportsRAND, Features.Supports3DNow,
+      Features.SupportsSSE4A, Features.SupportsAVX, Features.SupportsSHA, Features.SupportsBMI1,
+      Features.SupportsBMI2, Features.SupportsCLWB, Features.SupportsPMULL_128Bit, Features.SupportsCSSC,
+      Features.SupportsFlushInputsToZero, Features.SupportsFloatExceptions,
+      Config.ParanoidTSO(),
+      // The requested SRA and what the dispatcher ended up with can differ, the JIT follows the dispatcher
+      Config.StaticRegisterAllocation(),
+      CTX->Dispatcher->GetConfig().StaticRegisterAllocation,
+      Config.Is64BitMode(),
+      Config.TSOEnabled(),
+      Config.TSOAutoMigration(),
+      Config.Multiblock(),
+      Config.ABILocalFlags(),
+      Config.ABINoPF(),
+      Config.x87ReducedPrecision(),
+    };
+
+    uint64_t Bits{};
+    for (size_t i = 0; i < std::size(FeatureBits); ++i) {
+      Bits |= uint64_t(FeatureBits[i]) << i;
+    }
+
+    const uint64_t HostCodeConfig[] = {
+      AOTIR_VERSION,
+      Features.DCacheLineSize,
+      Features.ICacheLineSize,
+      Bits,
+      static_cast<uint64_t>(Config.Core()),
+      static_cast<uint64_t>(Config.SMCChecks()),
+      static_cast<uint64_t>(Config.MultiblockEdgeThreshold()),
+      static_cast<uint64_t>(Config.MaxInstPerBlock()),
+      XXH3_64bits(GIT_DESCRIBE_STRING GIT_SHORT_HASH, sizeof(GIT_DESCRIBE_STRING GIT_SHORT_HASH)),
+    };
+
+    return XXH3_64bits(HostCodeConfig, sizeof(HostCodeConfig));
+  }
+
+  // Packs the relocations back to back in the layout ApplyRelocations walks
+  static fextl::vector<uint8_t> PackRelocations(const fextl::vector<FEXCore::CPU::Relocation> &Relocations) {
+    fextl::vector<uint8_t> Packed;
+    for (const auto &Reloc : Relocations) {
+      size_t Size{};
+      switch (Reloc.Header.Type) {
+        case FEXCore::CPU::RelocationTypes::RELOC_NAMED_SYMBOL_LITERAL: Size = sizeof(Reloc.NamedSymbolLiteral); break;
+        case FEXCore::CPU::RelocationTypes::RELOC_NAMED_THUNK_MOVE: Size = sizeof(Reloc.NamedThunkMove); break;
+        case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_MOVE: Size = sizeof(Reloc.GuestRIPMove); break;
+        case FEXCore::CPU::RelocationTypes::RELOC_GUEST_RIP_LITERAL: Size = sizeof(Reloc.GuestRIPLiteral); break;
+      }
+
+      const auto Begin = reinterpret_cast<const uint8_t*>(&Reloc);
+      Packed.insert(Packed.end(), Begin, Begin + Size);
+    }
+    return Packed;
+  }
+
+  static bool LoadAOTIRCache(AOTIRCacheEntry *Entry, int streamfd, uint64_t HostCodeConfig) {
 #ifndef _WIN32
     uint64_t tag;
 
@@ -133,6 +233,7 @@ namespace FEXCore::IR {
     Entry->Array = Array;
     Entry->FilePtr = FilePtr;
     Entry->Size = Size;
+    Entry->HostCodeUsable = Array->HostCodeConfig == HostCodeConfig;
 
     LogMan::Msg::DFmt("AOTIR: Module {} has {} functions", Module, Array->Count);
 
@@ -142,9 +243,24 @@ namespace FEXCore::IR {
 #endif
   }
 
+  AOTIRCaptureCache::~AOTIRCaptureCache() {
+    if (CaptureAbandoned) {
+      // Closing the streams would publish the parent's incomplete files through the FEXServer
+      for (auto& [String, Entry] : AOTIRCaptureCacheMap) {
+        (void)Entry.Stream.release();
+      }
+    }
+  }
+
   void AOTIRCaptureCache::FinalizeAOTIRCache() {
+    if (CaptureAbandoned) {
+      return;
+    }
+
     AOTIRCaptureCacheWriteoutQueue_Flush();
 
+    const auto HostCodeConfig = GetHostCodeConfig(CTX);
+
     std::unique_lock lk(AOTIRCacheLock);
 
     for (auto& [String, Entry] : AOTIRCaptureCacheMap) {
@@ -166,6 +282,7 @@ namespace FEXCore::IR {
 
       stream->Write((const char*)&FnCount, sizeof(FnCount));
       stream->Write((const char*)&DataBase, sizeof(DataBase));
+      stream->Write((const char*)&HostCodeConfig, sizeof(HostCodeConfig));
 
       for (const auto& [GuestStart, DataOffset] : Entry.Index) {
         //AOTIRInlineIndexEntry
@@ -178,7 +295,7 @@ namespace FEXCore::IR {
       }
 
       // End of file header
-      const auto IndexSize = FnCount * sizeof(FEXCore::IR::AOTIRInlineIndexEntry) + sizeof(DataBase) + sizeof(FnCount);
+      const auto IndexSize = FnCount * sizeof(FEXCore::IR::AOTIRInlineIndexEntry) + sizeof(HostCodeConfig) + sizeof(DataBase) + sizeof(FnCount);
       stream->Write((const char*)&IndexSize, sizeof(IndexSize));
       stream->Write(String.c_str(), ModSize);
       stream->Write((const char*)&ModSize, sizeof(ModSize));
@@ -267,15 +384,25 @@ namespace FEXCore::IR {
           auto AOTEntry = Mod->Find(GuestRIP - AOTIRCacheEntry.VAFileStart);
 
           if (AOTEntry) {
-            // verify hash
+            // Entries keyed on the file's build-id or a hash of the whole file were validated when they were loaded,
+            // so only verify the hash if the guest could have changed the mapping since. Path keyed entries are always checked.
             auto MappedStart = GuestRIP;
-            auto hash = XXH3_64bits((void*)MappedStart, AOTEntry->GuestLength);
-            if (hash == AOTEntry->GuestHash) {
+            const bool Valid = (AOTIRCacheEntry.Entry->ContentsValidated && AOTIRCacheEntry.MappingUnmodified) ||
+                               XXH3_64bits((void*)MappedStart, AOTEntry->GuestLength) == AOTEntry->GuestHash;
+            if (Valid) {
               Result.IRList = AOTEntry->GetIRData();
               //LogMan::Msg::DFmt("using {} + {:x} -> {:x}\n", file->second.fileid, AOTEntry->first, GuestRIP);
 
-              Result.RAData = AOTEntry->GetRAData()->CreateCopy();
-              Result.DebugData = new FEXCore::Core::DebugData();
+              // Capturing needs the IR to go through the backend again so it ends up in the new cache
+              if (AOTEntry->HostCodeSize && AOTIRCacheEntry.Entry->HostCodeUsable &&
+                  CTX->Config.CacheObjectCodeCompilation() != FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE &&
+                  !CTX->Config.AOTIRCapture() && !CTX->GetGdbServerStatus()) {
+                // The RA data is only copied if the host code fails to relocate
+                Result.HostCodeEntry = AOTEntry;
+              } else {
+                Result.RAData = AOTEntry->GetRAData()->CreateCopy();
+                Result.DebugData = new FEXCore::Core::DebugData();
+              }
               Result.StartAddr = MappedStart;
               Result.Length = AOTEntry->GuestLength;
               Result.GeneratedIR = true;
@@ -310,7 +437,7 @@ namespace FEXCore::IR {
 
       if (AOTIRCacheEntry.Entry) {
         if (DebugData && CTX->Config.LibraryJITNaming()) {
-          CTX->Symbols.RegisterNamedRegion(CodePtr, DebugData->HostCodeSize, AOTIRCacheEntry.Entry->Filename);
+          CTX->Symbols.RegisterNamedRegion(Thread->SymbolBuffer.get(), CodePtr, DebugData->HostCodeSize, AOTIRCacheEntry.Entry->Filename);
         }
 
         if (CTX->Config.GDBSymbols()) {
@@ -318,7 +445,7 @@ namespace FEXCore::IR {
         }
 
         // Add to AOT cache if aot generation is enabled
-        if (GeneratedIR && RAData &&
+        if (GeneratedIR && RAData && !CaptureAbandoned &&
             (CTX->Config.AOTIRCapture() || CTX->Config.AOTIRGenerate())) {
 
           auto hash = XXH3_64bits((void*)StartAddr, Length);
@@ -333,9 +460,22 @@ namespace FEXCore::IR {
           auto RADataCopyDeleter = RADataCopy.get_deleter();
           auto IRListCopy = IRList->CreateCopy();
 
+          // Copied now, the code can be linked to other blocks as soon as it runs
+          AOTIRHostCode HostCode{};
+#ifdef _M_ARM_64
+          if (CTX->Config.CacheObjectCodeCompilation() == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_READWRITE &&
+              DebugData && DebugData->Relocations && !CTX->GetGdbServerStatus()) {
+            const auto HostCodeBegin = reinterpret_cast<const uint8_t*>(CodePtr) - DebugData->HostCodeEntryOffset;
+            HostCode.Code.assign(HostCodeBegin, HostCodeBegin + DebugData->HostCodeSize);
+            HostCode.EntryOffset = DebugData->HostCodeEntryOffset;
+            HostCode.NumRelocations = DebugData->Relocations->size();
+            HostCode.Relocations = PackRelocations(*DebugData->Relocations);
+          }
+#endif
+
           // The lambda is converted to std::function. This is tricky to refactor so it doesn't allocate memory through glibc.
           FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator glibc;
-          AOTIRCaptureCacheWriteoutQueue_Append([this, LocalRIP, LocalStartAddr, Length, hash, IRListCopy, RADataCopy=RADataCopy.release(), RADataCopyDeleter, FileId]() {
+          AOTIRCaptureCacheWriteoutQueue_Append([this, LocalRIP, LocalStartAddr, Length, hash, IRListCopy, RADataCopy=RADataCopy.release(), RADataCopyDeleter, FileId, HostCode]() {
 
             // It is guaranteed via AOTIRCaptureCacheWriteoutLock and AOTIRCaptureCacheWriteoutFlusing that this will not run concurrently
             // Memory coherency is guaranteed via AOTIRCaptureCacheWriteoutLock
@@ -347,7 +487,7 @@ namespace FEXCore::IR {
               uint64_t tag = FEXCore::IR::AOTIR_COOKIE;
               AotFile->Stream->Write(&tag, sizeof(tag));
             }
-            AotFile->AppendAOTIRCaptureCache(LocalRIP, LocalStartAddr, Length, hash, IRListCopy, RADataCopy);
+            AotFile->AppendAOTIRCaptureCache(LocalRIP, LocalStartAddr, Length, hash, IRListCopy, RADataCopy, HostCode);
             RADataCopyDeleter(RADataCopy);
             delete IRListCopy;
           });
@@ -380,15 +520,68 @@ namespace FEXCore::IR {
     return false;
   }
 
-  AOTIRCacheEntry *AOTIRCaptureCache::LoadAOTIRCacheEntry(const fextl::string &filename) {
+#ifndef _WIN32
+  // Identifies a file by its contents so every copy of a binary shares one cache, and a rebuilt binary never
+  // picks up a stale one. Uses the ELF build-id when there is one, otherwise hashes the whole file.
+  // Returns an empty string if the file can't be identified.
+  static fextl::string GetFileContentId(int fd) {
+    // Hashing is only done once per file, but don't stall on huge data files that happen to get mapped
+    constexpr off_t MaxHashedFileSize = 128 * 1024 * 1024;
+
+    unsigned char Ident[EI_NIDENT];
+    if (pread(fd, Ident, sizeof(Ident), 0) == sizeof(Ident) && memcmp(Ident, ELFMAG, SELFMAG) == 0) {
+      fextl::string BuildId;
+      if (Ident[EI_CLASS] == ELFCLASS64) {
+        BuildId = FEXCore::ELF::GetBuildId<Elf64_Ehdr, Elf64_Phdr>(fd);
+      } else if (Ident[EI_CLASS] == ELFCLASS32) {
+        BuildId = FEXCore::ELF::GetBuildId<Elf32_Ehdr, Elf32_Phdr>(fd);
+      }
+
+      if (!BuildId.empty()) {
+        return fextl::fmt::format("b{}", BuildId);
+      }
+    }
+
+    struct stat fileinfo;
+    if (fstat(fd, &fileinfo) < 0 || !S_ISREG(fileinfo.st_mode) ||
+        fileinfo.st_size == 0 || fileinfo.st_size > MaxHashedFileSize) {
+      return {};
+    }
+
+    void *FilePtr = FEXCore::Allocator::mmap(nullptr, fileinfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (FilePtr == MAP_FAILED) {
+      return {};
+    }
+
+    const auto Hash = XXH3_64bits(FilePtr, fileinfo.st_size);
+    FEXCore::Allocator::munmap(FilePtr, fileinfo.st_size);
+    return fextl::fmt::format("c{:016x}", Hash);
+  }
+#endif
+
+  AOTIRCacheEntry *AOTIRCaptureCache::LoadAOTIRCacheEntry(const fextl::string &filename, int fd) {
     fextl::string base_filename = FHU::Filesystem::GetFilename(filename);
 
     if (!base_filename.empty()) {
-      auto filename_hash = XXH3_64bits(filename.c_str(), filename.size());
+      fextl::string content_id;
+#ifndef _WIN32
+      // Only pay for identifying the file when the result is used for a cache
+      if (fd != -1 && (CTX->Config.AOTIRLoad() || CTX->Config.AOTIRCapture() || CTX->Config.AOTIRGenerate())) {
+        content_id = GetFileContentId(fd);
+      }
+#endif
+
+      // A build-id or a hash of the whole file identifies the contents the cache was generated from.
+      // Binaries patched in place without updating their build-id aren't supported, the same as for debuggers.
+      // A path says nothing about the contents, so those entries need every block validated against the guest memory
+      const bool ContentsValidated = !content_id.empty() && (content_id[0] == 'b' || content_id[0] == 'c');
+      if (content_id.empty()) {
+        content_id = fextl::fmt::format("{}", XXH3_64bits(filename.c_str(), filename.size()));
+      }
 
       auto fileid = fextl::fmt::format("{}-{}-{}{}{}{}",
         base_filename,
-        filename_hash,
+        content_id,
         (CTX->Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL) ? 'S' : 's',
         CTX->Config.TSOEnabled ? 'T' : 't',
         CTX->Config.ABILocalFlags ? 'L' : 'l',
@@ -396,15 +589,25 @@ namespace FEXCore::IR {
 
       std::unique_lock lk(AOTIRCacheLock);
 
-      auto Inserted = AOTIRCache.insert({fileid, AOTIRCacheEntry { .FileId = fileid, .Filename = filename }});
+      auto Inserted = AOTIRCache.insert({fileid, AOTIRCacheEntry { .FileId = fileid, .Filename = filename, .ContentsValidated = ContentsValidated }});
       auto Entry = &(Inserted.first->second);
 
+      // Copies of the same contents share the entry
+      if (Entry->RefCount++ != 0) {
+        return Entry;
+      }
+
       LOGMAN_THROW_AA_FMT(Entry->Array == nullptr, "Duplicate LoadAOTIRCacheEntry");
 
+      // Kept around when the file is unmapped, the contents can't have changed for the same FileId
+      if (CTX->Config.BlockJITNaming() && CTX->SourcecodeResolver && !Entry->SymbolMap) {
+        Entry->SymbolMap = CTX->SourcecodeResolver->GenerateSymbolMap(filename);
+      }
+
       if (CTX->Config.AOTIRLoad && AOTIRLoader) {
         auto streamfd = AOTIRLoader(fileid);
         if (streamfd != -1) {
-          FEXCore::IR::LoadAOTIRCache(Entry, streamfd);
+          FEXCore::IR::LoadAOTIRCache(Entry, streamfd, GetHostCodeConfig(CTX));
           close(streamfd);
         }
       }
@@ -418,6 +621,11 @@ namespace FEXCore::IR {
 #ifndef _WIN32
     LOGMAN_THROW_AA_FMT(Entry != nullptr, "Removing not existing entry");
 
+    std::unique_lock lk(AOTIRCacheLock);
+    if (--Entry->RefCount != 0) {
+      return;
+    }
+
     if (Entry->Array) {
       FEXCore::Allocator::munmap(Entry->FilePtr, Entry->Size);
       Entry->Array = nullptr;
@@ -6,6 +6,7 @@
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/queue.h>
 #include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
 
 #include <atomic>
 #include <cstdint>
@@ -40,16 +41,24 @@ namespace FEXCore::IR {
 
     return Cookie;
   };
-  constexpr static uint32_t AOTIR_VERSION = 0x0000'00004;
+  constexpr static uint32_t AOTIR_VERSION = 0x0000'00006;
   constexpr static uint64_t AOTIR_COOKIE = COOKIE_VERSION("FEXI", AOTIR_VERSION);
 
   struct AOTIRInlineEntry {
     uint64_t GuestHash;
     uint64_t GuestLength;
 
-    /* RAData followed by IRData */
+    // Relocatable host code compiled from the IR, HostCodeSize is 0 if it wasn't cached
+    uint64_t HostCodeSize;
+    uint64_t HostCodeEntryOffset;
+    uint64_t NumRelocations;
+    uint64_t RelocationsSize;
+
+    /* Host code and its relocations, followed by RAData and IRData */
     uint8_t InlineData[0];
 
+    const char *GetHostCode();
+    const char *GetRelocations();
     IR::RegisterAllocationData *GetRAData();
     IR::IRListView *GetIRData();
   };
@@ -62,17 +71,27 @@ namespace FEXCore::IR {
   struct AOTIRInlineIndex {
     uint64_t Count;
     uint64_t DataBase;
+    // Identifies the FEX build and host features the cached host code was compiled for
+    uint64_t HostCodeConfig;
     AOTIRInlineIndexEntry Entries[0];
 
     AOTIRInlineEntry *Find(uint64_t GuestStart);
     AOTIRInlineEntry *GetInlineEntry(uint64_t DataOffset);
   };
 
+  // Copy of a block's host code and relocations, taken before the block can be linked
+  struct AOTIRHostCode {
+    fextl::vector<uint8_t> Code;
+    uint64_t EntryOffset;
+    uint64_t NumRelocations;
+    fextl::vector<uint8_t> Relocations;
+  };
+
   struct AOTIRCaptureCacheEntry {
     fextl::unique_ptr<FEXCore::Context::AOTIRWriter> Stream;
     fextl::map<uint64_t, uint64_t> Index;
 
-    void AppendAOTIRCaptureCache(uint64_t GuestRIP, uint64_t Start, uint64_t Length, uint64_t Hash, FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData *RAData);
+    void AppendAOTIRCaptureCache(uint64_t GuestRIP, uint64_t Start, uint64_t Length, uint64_t Hash, FEXCore::IR::IRListView *IRList, FEXCore::IR::RegisterAllocationData *RAData, const AOTIRHostCode &HostCode);
   };
 
   struct AOTIRCacheEntry {
@@ -80,9 +99,17 @@ namespace FEXCore::IR {
     void *FilePtr;
     size_t Size;
     std::unique_ptr<FEXCore::HLE::SourcecodeMap> SourcecodeMap;
+    // Guest function symbols for naming JIT blocks, only generated with BlockJITNaming
+    fextl::unique_ptr<FEXCore::HLE::SourcecodeMap> SymbolMap;
     fextl::string FileId;
     fextl::string Filename;
     bool ContainsCode;
+    // FileId was derived from the file's build-id or a hash of the whole file, rather than its path
+    bool ContentsValidated;
+    // The cache's host code was compiled by this FEX build for the same host features
+    bool HostCodeUsable;
+    // Number of mapped resources sharing this entry
+    uint32_t RefCount;
   };
 
   using AOTCacheType = fextl::unordered_map<fextl::string, FEXCore::IR::AOTIRCacheEntry>;
@@ -91,16 +118,25 @@ namespace FEXCore::IR {
     public:
 
       AOTIRCaptureCache(FEXCore::Context::ContextImpl *ctx) : CTX {ctx} {}
+      ~AOTIRCaptureCache();
 
       void FinalizeAOTIRCache();
       void AOTIRCaptureCacheWriteoutQueue_Flush();
       void AOTIRCaptureCacheWriteoutQueue_Append(const std::function<void()> &fn);
       void WriteFilesWithCode(std::function<void(const fextl::string& fileid, const fextl::string& filename)> Writer);
 
+      // Stops a forked child from writing to the capture files it shares with the parent.
+      // The parent is the one that finishes them.
+      void AbandonCaptureAfterFork() {
+        CaptureAbandoned = true;
+      }
+
       struct PreGenerateIRFetchResult {
         FEXCore::IR::IRListView *IRList {};
         FEXCore::IR::RegisterAllocationData::UniquePtr RAData {};
         FEXCore::Core::DebugData *DebugData {};
+        // Set instead of RAData and DebugData when the entry has host code to relocate
+        AOTIRInlineEntry *HostCodeEntry {};
         uint64_t StartAddr {};
         uint64_t Length {};
         bool GeneratedIR {};
@@ -117,7 +153,7 @@ namespace FEXCore::IR {
         FEXCore::Core::DebugData *DebugData,
         bool GeneratedIR);
 
-      AOTIRCacheEntry *LoadAOTIRCacheEntry(const fextl::string &filename);
+      AOTIRCacheEntry *LoadAOTIRCacheEntry(const fextl::string &filename, int fd);
       void UnloadAOTIRCacheEntry(AOTIRCacheEntry *Entry);
 
       // Callbacks
@@ -139,6 +175,7 @@ namespace FEXCore::IR {
       std::shared_mutex AOTIRCacheLock;
       std::shared_mutex AOTIRCaptureCacheWriteoutLock;
       std::atomic<bool> AOTIRCaptureCacheWriteoutFlusing;
+      bool CaptureAbandoned{};
 
       fextl::queue<std::function<void()>> AOTIRCaptureCacheWriteoutQueue;
 
@@ -186,6 +186,10 @@ IREmitter::IRPair<IROp_CodeBlock> IREmitter::CreateNewCodeBlockAfter(OrderedNode
 }
 
 void IREmitter::SetCurrentCodeBlock(OrderedNode *Node) {
+  if (CurrentCodeBlock) {
+    CodeBlockEnded();
+  }
+
   CurrentCodeBlock = Node;
   LOGMAN_THROW_A_FMT(Node->Op(DualListData.DataBegin())->Op == OP_CODEBLOCK, "Node wasn't codeblock. It was '{}'", IR::GetName(Node->Op(DualListData.DataBegin())->Op));
   SetWriteCursor(Node->Op(DualListData.DataBegin())->CW<IROp_CodeBlock>()->Begin.GetNode(DualListData.ListBegin()));
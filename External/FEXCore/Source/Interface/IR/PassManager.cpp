@@ -12,6 +12,7 @@ $end_info$
 #include "Interface/IR/Passes/RegisterAllocationPass.h"
 
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/IR/IREmitter.h>
 #include <FEXCore/Utils/Profiler.h>
 
 namespace FEXCore::IR {
@@ -29,7 +30,18 @@ void PassManager::AddDefaultPasses(FEXCore::Context::ContextImpl *ctx, bool Inli
       InsertPass(CreateLongDivideEliminationPass());
     }
 
-    InsertPass(CreateDeadStoreElimination(ctx->HostFeatures.SupportsAVX));
+    // The folded results depend on the host and the CPUID config, which aren't part of the AOTIR or code cache keys.
+    // Don't fold when the generated code can end up in one of the caches.
+    const bool CachesCode = ctx->Config.AOTIRCapture() || ctx->Config.AOTIRGenerate() ||
+                            ctx->Config.CacheObjectCodeCompilation() != FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE;
+    if (!CachesCode) {
+      // This needs to run after RCLSE so CPUID and XGETBV arguments forwarded from context stores are visible as constants
+      // Runs before ConstProp so the extracted results can be folded further
+      InsertPass(CreateCPUIDOptimization(&ctx->CPUID));
+    }
+
+    // Iterates to a fixed point across every block, which gets expensive for large multiblock functions
+    InsertBudgetedPass(CreateDeadStoreElimination(ctx->HostFeatures.SupportsAVX));
     InsertPass(CreatePassDeadCodeElimination());
     InsertPass(CreateConstProp(InlineConstants, ctx->HostFeatures.SupportsTSOImm9));
 
@@ -60,8 +72,16 @@ void PassManager::InsertRegisterAllocationPass(bool OptimizeSRA, bool SupportsAV
 bool PassManager::Run(IREmitter *IREmit) {
   FEXCORE_PROFILE_SCOPED("PassManager::Run");
 
+  // The node count is deterministic, unlike a time budget, so cached IR doesn't depend on host load
+  const uint32_t PassBudget = MultiblockPassBudget();
+  const bool OverBudget = PassBudget && IREmit->ViewIR().GetSSACount() > PassBudget;
+
   bool Changed = false;
   for (auto const &Pass : Passes) {
+    if (OverBudget && Pass->Budgeted) {
+      continue;
+    }
+
     Changed |= Pass->Run(IREmit);
   }
 
@@ -41,6 +41,11 @@ public:
 
 protected:
   PassManager *Manager;
+
+private:
+  friend class PassManager;
+  // Skipped for functions that exceed the pass budget
+  bool Budgeted{};
 };
 
 class PassManager final {
@@ -58,6 +63,16 @@ public:
     return PassPtr;
   }
 
+  /**
+   * @brief Inserts a pass that only improves code quality and scales poorly with function size
+   *
+   * These are skipped when the IR is larger than the MultiblockPassBudget, trading code quality for compile latency.
+   */
+  Pass* InsertBudgetedPass(fextl::unique_ptr<Pass> Pass, fextl::string Name = "") {
+    Pass->Budgeted = true;
+    return InsertPass(std::move(Pass), std::move(Name));
+  }
+
   void InsertRegisterAllocationPass(bool OptimizeSRA, bool SupportsAVX);
 
   bool Run(IREmitter *IREmit);
@@ -104,6 +119,7 @@ private:
 #endif
 
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
+  FEX_CONFIG_OPT(MultiblockPassBudget, MULTIBLOCKPASSBUDGET);
 };
 }
 
@@ -0,0 +1,106 @@
+/*
+$info$
+tags: ir|opts
+desc: Folds CPUID and XGETBV with constant arguments in to constants
+$end_info$
+*/
+
+#include "Interface/Core/CPUID.h"
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+
+#include <memory>
+#include <stdint.h>
+
+namespace FEXCore::IR {
+
+class CPUIDOptimization final : public FEXCore::IR::Pass {
+public:
+  CPUIDOptimization(FEXCore::CPUIDEmu *CPUID)
+    : CPUID {CPUID} {}
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  FEXCore::CPUIDEmu *CPUID;
+
+  bool GetConstantPair(IREmitter *IREmit, OrderedNodeWrapper Pair, uint64_t *Lower, uint64_t *Upper);
+};
+
+bool CPUIDOptimization::GetConstantPair(IREmitter *IREmit, OrderedNodeWrapper Pair, uint64_t *Lower, uint64_t *Upper) {
+  auto PairOp = IREmit->GetOpHeader(Pair);
+
+  if (PairOp->Op == OP_CPUID) {
+    auto Op = PairOp->C<IR::IROp_CPUID>();
+
+    uint64_t Function, Leaf;
+    if (!IREmit->IsValueConstant(Op->Function, &Function) ||
+        !IREmit->IsValueConstant(Op->Leaf, &Leaf)) {
+      return false;
+    }
+
+    // Some functions depend on which CPU the thread is currently running on
+    if (!CPUID->DoesFunctionReportConstantData(Function)) {
+      return false;
+    }
+
+    const auto Results = CPUID->RunFunction(Function, Leaf);
+    *Lower = Results.eax | (uint64_t(Results.ebx) << 32);
+    *Upper = Results.ecx | (uint64_t(Results.edx) << 32);
+    return true;
+  }
+
+  if (PairOp->Op == OP_XGETBV) {
+    auto Op = PairOp->C<IR::IROp_XGetBV>();
+
+    uint64_t Function;
+    if (!IREmit->IsValueConstant(Op->Function, &Function)) {
+      return false;
+    }
+
+    const auto Results = CPUID->RunXCRFunction(Function);
+    *Lower = Results.eax;
+    *Upper = Results.edx;
+    return true;
+  }
+
+  return false;
+}
+
+bool CPUIDOptimization::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::CPUIDOpt");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+
+  for (auto [CodeNode, IROp] : CurrentIR.GetAllCode()) {
+    if (IROp->Op != OP_EXTRACTELEMENTPAIR) {
+      continue;
+    }
+
+    auto Op = IROp->C<IR::IROp_ExtractElementPair>();
+
+    uint64_t Lower, Upper;
+    if (!GetConstantPair(IREmit, Op->Pair, &Lower, &Upper)) {
+      continue;
+    }
+
+    // Replace the extracted element with the value the handler would have returned.
+    // Once all elements are replaced, DCE removes the call to the handler.
+    IREmit->SetWriteCursor(CodeNode);
+    auto Constant = IREmit->_Constant(Op->Element == 0 ? Lower : Upper);
+    IREmit->ReplaceAllUsesWith(CodeNode, Constant);
+    Changed = true;
+  }
+
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateCPUIDOptimization(FEXCore::CPUIDEmu *CPUID) {
+  return fextl::make_unique<CPUIDOptimization>(CPUID);
+}
+
+}
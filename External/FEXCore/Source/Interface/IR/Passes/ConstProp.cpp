@@ -885,6 +885,78 @@ bool ConstProp::ConstantPropagation(IREmitter *IREmit, const IRListView& Current
       break;
     }
 
+    case OP_VAESENCROUND:
+    case OP_VAESENCLASTROUND:
+    case OP_VAESDECROUND:
+    case OP_VAESDECLASTROUND: {
+      // x86 rounds come out of the frontend as a round with a zero key followed by a XOR with the x86 key.
+      // When the state is one of those XORs, from the previous round or from the initial key whitening,
+      // the XOR operands become the state and key of this round. The XOR then usually ends up dead.
+      auto KeyHeader = IREmit->GetOpHeader(IROp->Args[1]);
+      if (KeyHeader->Op != OP_VECTORZERO) {
+        break;
+      }
+
+      auto State = IROp->Args[0];
+      auto StateHeader = IREmit->GetOpHeader(State);
+
+      // VEX encoded rounds zero extend their 128-bit result
+      if (StateHeader->Op == OP_VMOV && StateHeader->Size == 16 &&
+          IREmit->GetOpHeader(StateHeader->Args[0])->Size == 16) {
+        State = StateHeader->Args[0];
+        StateHeader = IREmit->GetOpHeader(State);
+      }
+
+      if (StateHeader->Op == OP_VXOR && StateHeader->Size == 16) {
+        IREmit->ReplaceNodeArgument(CodeNode, 0, IREmit->UnwrapNode(StateHeader->Args[0]));
+        IREmit->ReplaceNodeArgument(CodeNode, 1, IREmit->UnwrapNode(StateHeader->Args[1]));
+        Changed = true;
+      }
+      break;
+    }
+
+    case OP_VXOR: {
+      // CRC folding loops and GHASH take the middle term of a 128-bit carryless multiply as
+      // PCLMUL(a, b, 0x01) ^ PCLMUL(a, b, 0x10).
+      // Rotating a by 64 bits turns the pair in to the 0x00 and 0x11 products, which the host
+      // does as a PMULL + PMULL2 pair without moving a half of a source for each product.
+      if (IROp->Size != 16) {
+        break;
+      }
+
+      auto LHSNode = IREmit->UnwrapNode(IROp->Args[0]);
+      auto RHSNode = IREmit->UnwrapNode(IROp->Args[1]);
+      auto LHSHeader = IREmit->GetOpHeader(IROp->Args[0]);
+      auto RHSHeader = IREmit->GetOpHeader(IROp->Args[1]);
+
+      if (LHSHeader->Op != OP_PCLMUL || RHSHeader->Op != OP_PCLMUL ||
+          LHSHeader->Size != 16 || RHSHeader->Size != 16 ||
+          LHSNode->NumUses != 1 || RHSNode->NumUses != 1) {
+        break;
+      }
+
+      auto LHS = LHSHeader->C<IR::IROp_PCLMUL>();
+      auto RHS = RHSHeader->C<IR::IROp_PCLMUL>();
+      const bool CrossProducts = (LHS->Selector == 0b0000'0001 && RHS->Selector == 0b0001'0000) ||
+                                 (LHS->Selector == 0b0001'0000 && RHS->Selector == 0b0000'0001);
+
+      if (!CrossProducts || LHS->Src1 != RHS->Src1 || LHS->Src2 != RHS->Src2) {
+        break;
+      }
+
+      auto Src1 = IREmit->UnwrapNode(LHS->Src1);
+      auto Src2 = IREmit->UnwrapNode(LHS->Src2);
+
+      IREmit->SetWriteCursor(IREmit->UnwrapNode(CodeNode->Header.Previous));
+      auto Rotated = IREmit->_VExtr(16, 8, Src1, Src1, 1);
+      auto HighLow = IREmit->_PCLMUL(16, Rotated, Src2, 0b0000'0000);
+      auto LowHigh = IREmit->_PCLMUL(16, Rotated, Src2, 0b0001'0001);
+      IREmit->ReplaceNodeArgument(CodeNode, 0, HighLow);
+      IREmit->ReplaceNodeArgument(CodeNode, 1, LowHigh);
+      Changed = true;
+      break;
+    }
+
     default:
       break;
     }
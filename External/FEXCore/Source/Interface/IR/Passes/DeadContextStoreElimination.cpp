@@ -261,6 +261,20 @@ namespace {
     }
 
     for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_FLAGS; ++i) {
+      if (i == FEXCore::X86State::FLAG_NZCV_OFFSET) {
+        // CF, ZF, SF and OF are accessed as a single word
+        ContextClassification->emplace_back(ContextMemberInfo{
+          ContextMemberClassification {
+            offsetof(FEXCore::Core::CPUState, flags[0]) + sizeof(FEXCore::Core::CPUState::flags[0]) * i,
+            sizeof(uint32_t),
+          },
+          ACCESS_NONE,
+          FEXCore::IR::InvalidClass,
+        });
+        i += sizeof(uint32_t) - 1;
+        continue;
+      }
+
       ContextClassification->emplace_back(ContextMemberInfo{
         ContextMemberClassification {
           offsetof(FEXCore::Core::CPUState, flags[0]) + sizeof(FEXCore::Core::CPUState::flags[0]) * i,
@@ -409,7 +423,8 @@ namespace {
       SetAccess(Offset++, ACCESS_NONE);
     }
 
-    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_FLAGS; ++i) {
+    // The NZCV word is one entry instead of four
+    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_FLAGS - (sizeof(uint32_t) - 1); ++i) {
       SetAccess(Offset++, ACCESS_NONE);
     }
 
@@ -735,6 +750,11 @@ bool RCLSE::RedundantStoreLoadElimination(FEXCore::IR::IREmitter *IREmit) {
             continue;
           }
 
+          if (F >= FEXCore::X86State::FLAG_NZCV_OFFSET && F < FEXCore::X86State::FLAG_NZCV_OFFSET + sizeof(uint32_t)) {
+            // Not a flag byte, the NZCV word is only written by the frontend as a whole
+            continue;
+          }
+
           auto Info = FindMemberInfo(&LocalInfo, offsetof(FEXCore::Core::CPUState, flags[0]) + F, 1);
           auto LastStoreNode = Info->StoreNode;
 
@@ -768,6 +788,14 @@ bool RCLSE::RedundantStoreLoadElimination(FEXCore::IR::IREmitter *IREmit) {
           Changed = true;
         }
       }
+      else if (IROp->Op == OP_GUESTOPCODE) {
+        // The guest instruction after this can fault, and the signal frame is built from the NZCV word in the context.
+        // Treat it as a read so the frontend's write back before the instruction isn't removed by a later one.
+        auto Info = FindMemberInfo(&LocalInfo, offsetof(FEXCore::Core::CPUState, flags[FEXCore::X86State::FLAG_NZCV_OFFSET]), sizeof(uint32_t));
+        if (IsWriteAccess(Info->Accessed)) {
+          RecordAccess(Info, Info->AccessRegClass, Info->AccessOffset, Info->AccessSize, ACCESS_READ, Info->Node);
+        }
+      }
       else if (IROp->Op == OP_SYSCALL ||
                IROp->Op == OP_INLINESYSCALL) {
         FEXCore::IR::SyscallFlags Flags{};
@@ -45,7 +45,7 @@ namespace Handler {
       return "0";
     else if (Value == "read")
       return "1";
-    else if (Value == "write")
+    else if (Value == "readwrite" || Value == "write")
       return "2";
     return "0";
   }
@@ -86,6 +86,21 @@ namespace FEXCore::Context {
     void *VDSO_kernel_rt_sigreturn;
   };
 
+  /**
+   * @brief Totals for the code the JIT has generated over the lifetime of a context.
+   *
+   * Only blocks compiled from freshly generated IR are counted, so guest and host sizes describe the same blocks.
+   */
+  struct JITCodeStats {
+    uint64_t BlocksCompiled;
+    uint64_t GuestInstructions;
+    uint64_t GuestBytes;
+    uint64_t HostCodeBytes;
+    // Time spent generating IR, running passes and emitting code for these blocks.
+    // Zero unless EnableCompileTimeStats was called.
+    uint64_t CompileNanoseconds;
+  };
+
   using CustomCPUFactoryType = std::function<fextl::unique_ptr<FEXCore::CPU::CPUBackend> (FEXCore::Context::Context*, FEXCore::Core::InternalThreadState *Thread)>;
 
   using ExitHandler = std::function<void(uint64_t ThreadId, FEXCore::Context::ExitReason)>;
@@ -254,7 +269,7 @@ namespace FEXCore::Context {
       FEX_DEFAULT_VISIBILITY virtual FEXCore::CPUID::XCRResults RunXCRFunction(uint32_t Function) = 0;
       FEX_DEFAULT_VISIBILITY virtual FEXCore::CPUID::FunctionResults RunCPUIDFunctionName(uint32_t Function, uint32_t Leaf, uint32_t CPU) = 0;
 
-      FEX_DEFAULT_VISIBILITY virtual FEXCore::IR::AOTIRCacheEntry *LoadAOTIRCacheEntry(const fextl::string& Name) = 0;
+      FEX_DEFAULT_VISIBILITY virtual FEXCore::IR::AOTIRCacheEntry *LoadAOTIRCacheEntry(const fextl::string& Name, int fd) = 0;
       FEX_DEFAULT_VISIBILITY virtual void UnloadAOTIRCacheEntry(FEXCore::IR::AOTIRCacheEntry *Entry) = 0;
 
       FEX_DEFAULT_VISIBILITY virtual void SetAOTIRLoader(std::function<int(const fextl::string&)> CacheReader) = 0;
@@ -297,6 +312,33 @@ namespace FEXCore::Context {
        *
        */
       FEX_DEFAULT_VISIBILITY virtual void EnableExitOnHLT() = 0;
+
+      /**
+       * @brief Times every block compilation for JITCodeStats::CompileNanoseconds.
+       *
+       * Off by default since it reads the clock twice per compiled block.
+       */
+      FEX_DEFAULT_VISIBILITY virtual void EnableCompileTimeStats() = 0;
+
+      /**
+       * @brief Returns the JIT code generation totals for this context.
+       */
+      FEX_DEFAULT_VISIBILITY virtual JITCodeStats GetJITCodeStats() const = 0;
+
+      /**
+       * @brief Writes the per guest module JIT statistics to the file configured by JITStatsFile.
+       *
+       * Does nothing if JITStatsFile isn't set.
+       */
+      FEX_DEFAULT_VISIBILITY virtual void WriteJITModuleStats() = 0;
+
+      /**
+       * @brief Writes out the JIT symbols every thread has buffered, before the process execs or crashes.
+       *
+       * @param Blocking Waits for threads that are registering symbols. Must be false in a signal handler,
+       *                 which skips anything that is in use instead.
+       */
+      FEX_DEFAULT_VISIBILITY virtual void FlushJITSymbols(bool Blocking) = 0;
     private:
   };
 
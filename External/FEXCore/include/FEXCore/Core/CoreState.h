@@ -3,10 +3,14 @@
 #include <FEXCore/HLE/Linux/ThreadManagement.h>
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Core/CPUBackend.h>
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/Utils/BitUtils.h>
 
 #include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstring>
+#include <iterator>
 #include <stdint.h>
 #include <string_view>
 #include <type_traits>
@@ -37,7 +41,7 @@ namespace FEXCore::Core {
       }
 
       // Returns original value.
-      // x86-64 needs to know the result on decrement.
+      // Used to only check for pending signals when leaving the outermost deferred section.
       T Decrement(T Value) {
         // Specifically avoiding fetch_sub here because that will turn into ldxr+stxr or lock xadd.
         // FEX very specifically wants to use simple loadstore instructions for this
@@ -129,6 +133,83 @@ namespace FEXCore::Core {
     static constexpr size_t NUM_GPRS = sizeof(gregs) / GPR_REG_SIZE;
     static constexpr size_t NUM_XMMS = sizeof(xmm) / XMM_AVX_REG_SIZE;
     static constexpr size_t NUM_MMS = sizeof(mm) / MM_REG_SIZE;
+
+    // RFLAGS that don't live in the bottom bit of their own byte
+    static constexpr uint32_t PACKED_EFLAGS_MASK =
+      (1U << X86State::RFLAG_CF_LOC) |
+      (1U << X86State::RFLAG_PF_LOC) |
+      (1U << X86State::RFLAG_AF_LOC) |
+      (1U << X86State::RFLAG_ZF_LOC) |
+      (1U << X86State::RFLAG_SF_LOC) |
+      (1U << X86State::RFLAG_OF_LOC);
+
+    // Returns the bit in the NZCV word that holds the flag, or -1 if the flag has its own byte.
+    static constexpr int GetNZCVBit(uint32_t FlagLoc) {
+      switch (FlagLoc) {
+        case X86State::RFLAG_CF_LOC: return X86State::NZCV_CF_LOC;
+        case X86State::RFLAG_ZF_LOC: return X86State::NZCV_ZF_LOC;
+        case X86State::RFLAG_SF_LOC: return X86State::NZCV_SF_LOC;
+        case X86State::RFLAG_OF_LOC: return X86State::NZCV_OF_LOC;
+        default: return -1;
+      }
+    }
+
+    /**
+     * @brief Assembles EFLAGS from the flags storage
+     *
+     * CF, ZF, SF and OF come from the NZCV word. PF is set when its byte has even parity and AF is bit 4 of its byte.
+     * Every other flag is the bottom bit of its own byte.
+     */
+    uint32_t GetEFLAGS() const {
+      uint64_t Bytes[3];
+      memcpy(Bytes, flags, sizeof(Bytes));
+
+      uint32_t EFLAGS{};
+      for (size_t i = 0; i < std::size(Bytes); ++i) {
+        // Gathers the bottom bit of each of the eight bytes in to the top byte
+        const uint64_t Bits = ((Bytes[i] & 0x0101'0101'0101'0101ULL) * 0x0102'0408'1020'4080ULL) >> 56;
+        EFLAGS |= static_cast<uint32_t>(Bits) << (i * 8);
+      }
+      EFLAGS &= ~PACKED_EFLAGS_MASK;
+      EFLAGS |= 1U << X86State::RFLAG_RESERVED_LOC;
+
+      uint32_t NZCV;
+      memcpy(&NZCV, &flags[X86State::FLAG_NZCV_OFFSET], sizeof(NZCV));
+      EFLAGS |= ((NZCV >> X86State::NZCV_CF_LOC) & 1) << X86State::RFLAG_CF_LOC;
+      EFLAGS |= ((NZCV >> X86State::NZCV_ZF_LOC) & 1) << X86State::RFLAG_ZF_LOC;
+      EFLAGS |= ((NZCV >> X86State::NZCV_SF_LOC) & 1) << X86State::RFLAG_SF_LOC;
+      EFLAGS |= ((NZCV >> X86State::NZCV_OF_LOC) & 1) << X86State::RFLAG_OF_LOC;
+
+      EFLAGS |= ((std::popcount(flags[X86State::RFLAG_PF_LOC]) & 1) ^ 1U) << X86State::RFLAG_PF_LOC;
+      EFLAGS |= ((flags[X86State::RFLAG_AF_LOC] >> 4) & 1) << X86State::RFLAG_AF_LOC;
+      return EFLAGS;
+    }
+
+    /**
+     * @brief Scatters EFLAGS in to the flags storage
+     *
+     * The inverse of GetEFLAGS.
+     */
+    void SetEFLAGS(uint32_t EFLAGS) {
+      uint64_t Bytes[3];
+      for (size_t i = 0; i < std::size(Bytes); ++i) {
+        // Spreads the eight bits to the bottom bit of eight bytes in reverse order, the swap puts them back in order
+        const uint64_t Bits = ((EFLAGS & ~PACKED_EFLAGS_MASK) >> (i * 8)) & 0xFF;
+        Bytes[i] = BSwap64(((Bits * 0x8040'2010'0804'0201ULL) >> 7) & 0x0101'0101'0101'0101ULL);
+      }
+      memcpy(flags, Bytes, sizeof(Bytes));
+
+      flags[X86State::RFLAG_PF_LOC] = ((EFLAGS >> X86State::RFLAG_PF_LOC) & 1) ^ 1;
+      flags[X86State::RFLAG_AF_LOC] = ((EFLAGS >> X86State::RFLAG_AF_LOC) & 1) << 4;
+
+      const uint32_t NZCV =
+        (((EFLAGS >> X86State::RFLAG_CF_LOC) & 1) << X86State::NZCV_CF_LOC) |
+        (((EFLAGS >> X86State::RFLAG_ZF_LOC) & 1) << X86State::NZCV_ZF_LOC) |
+        (((EFLAGS >> X86State::RFLAG_SF_LOC) & 1) << X86State::NZCV_SF_LOC) |
+        (((EFLAGS >> X86State::RFLAG_OF_LOC) & 1) << X86State::NZCV_OF_LOC);
+      memcpy(&flags[X86State::FLAG_NZCV_OFFSET], &NZCV, sizeof(NZCV));
+    }
+
     CPUState() {
       // Initialize default CPU state
       rip = ~0ULL;
@@ -141,8 +222,8 @@ namespace FEXCore::Core {
         xmm[3] = 0xBAD2CAD3ULL;
       }
       memset(&flags, 0, Core::CPUState::NUM_EFLAG_BITS);
-      flags[1] = 1; ///< Reserved - Always 1.
-      flags[9] = 1; ///< Interrupt flag - Always 1.
+      ///< Reserved and Interrupt flag - Always 1.
+      SetEFLAGS((1U << X86State::RFLAG_RESERVED_LOC) | (1U << X86State::RFLAG_IF_LOC));
       FCW = 0x37F;
       FTW = 0xFFFF;
     }
@@ -151,6 +232,7 @@ namespace FEXCore::Core {
   static_assert(std::is_standard_layout_v<CPUState>, "This needs to be standard layout");
   static_assert(offsetof(CPUState, xmm) % 32 == 0, "xmm needs to be 256-bit aligned!");
   static_assert(offsetof(CPUState, mm) % 16 == 0, "mm needs to be 128-bit aligned!");
+  static_assert(offsetof(CPUState, flags[X86State::FLAG_NZCV_OFFSET]) % 4 == 0, "NZCV needs to be 32-bit aligned!");
   static_assert(offsetof(CPUState, DeferredSignalRefCount) % 8 == 0, "Needs to be 8-byte aligned");
 
   struct InternalThreadState;
@@ -280,13 +362,14 @@ namespace FEXCore::Core {
       struct {
         // None so far
       } X86;
-
-      struct {
-        uint64_t FragmentExecuter;
-        using IntCallbackReturn =  void(*)(FEXCore::Core::InternalThreadState *Thread, volatile void *Host_RSP);
-        IntCallbackReturn CallbackReturn;
-      } Interpreter;
     };
+
+    // Outside of the union since the interpreter can run as a tier underneath the JIT.
+    struct {
+      uint64_t FragmentExecuter;
+      using IntCallbackReturn =  void(*)(FEXCore::Core::InternalThreadState *Thread, volatile void *Host_RSP);
+      IntCallbackReturn CallbackReturn;
+    } Interpreter;
   };
 
   // Each guest JIT frame has one of these
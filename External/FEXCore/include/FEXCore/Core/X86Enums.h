@@ -74,6 +74,10 @@ enum X86RegLocation : uint32_t {
   RFLAG_VIP_LOC   = 20,
   RFLAG_ID_LOC    = 21,
 
+// CF, ZF, SF and OF don't use their own bytes, they are packed in to a 32-bit word after RFLAGS.
+// See X86NZCVLocation for their bits in the word.
+  FLAG_NZCV_OFFSET = 24, // 4 Bytes wide
+
 // So we can share flag handling logic, we put x87 flags after RFLAGS
   X87FLAG_BASE    = 32,
   X87FLAG_IE_LOC  = 32,
@@ -92,6 +96,20 @@ enum X86RegLocation : uint32_t {
   X87FLAG_B_LOC   = 47,
 };
 
+/**
+ * @name Bit locations of the flags packed in the NZCV word
+ *
+ * Matches the host NZCV layout so the word can be moved to and from the host flags directly.
+ * CF is stored with x86 semantics, not inverted like the Arm64 carry after a subtract.
+ * @{ */
+enum X86NZCVLocation : uint32_t {
+  NZCV_OF_LOC     = 28, // V
+  NZCV_CF_LOC     = 29, // C
+  NZCV_ZF_LOC     = 30, // Z
+  NZCV_SF_LOC     = 31, // N
+};
+/**  @} */
+
 // X86 trap number definitions
 enum X86TrapNo : uint32_t {
   X86_TRAPNO_DE       = 0,  // Divide-by-zero
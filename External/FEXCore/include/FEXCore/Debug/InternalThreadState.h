@@ -10,6 +10,9 @@
 #include <FEXCore/Utils/Threads.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/robin_map.h>
+#include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/unordered_set.h>
 #include <FEXCore/fextl/vector.h>
 
 #include <shared_mutex>
@@ -18,6 +21,7 @@
 namespace FEXCore {
   class LookupCache;
   class CompileService;
+  struct JITSymbolBuffer;
 }
 
 namespace FEXCore::Context {
@@ -55,6 +59,7 @@ namespace FEXCore::Core {
    */
   struct DebugData : public FEXCore::Allocator::FEXAllocOperators {
     uint64_t HostCodeSize; ///< The size of the code generated in the host JIT
+    uint64_t HostCodeEntryOffset; ///< Offset of the block's entrypoint from the start of its host code
     fextl::vector<DebugDataSubblock> Subblocks;
     fextl::vector<DebugDataGuestOpcode> GuestOpcodes;
     fextl::vector<FEXCore::CPU::Relocation> *Relocations;
@@ -68,6 +73,18 @@ namespace FEXCore::Core {
     fextl::unique_ptr<FEXCore::Core::DebugData> DebugData;
   };
 
+  /**
+   * @brief Taken edge counts for the branch targets a multiblock region left out
+   *
+   * Regions start out without any of their in range branch targets and are recompiled once with the ones that were hot.
+   */
+  struct MultiblockRegionProfile {
+    fextl::unordered_map<uint64_t, uint32_t> SideExits; ///< Number of times each side exit target was taken
+    fextl::set<uint64_t> HotTargets; ///< Side exit targets that get compiled in to the region
+    uint32_t ExitsSinceNewHotTarget{}; ///< Once this reaches the threshold the hot targets are considered stable
+    bool Formed{}; ///< The region has been recompiled with its hot targets and isn't profiled anymore
+  };
+
   struct InternalThreadState : public FEXCore::Allocator::FEXAllocOperators {
     FEXCore::Core::CpuStateFrame* const CurrentFrame = &BaseFrameState;
 
@@ -95,6 +112,18 @@ namespace FEXCore::Core {
 
     fextl::unique_ptr<FEXCore::Frontend::Decoder> FrontendDecoder;
     fextl::unique_ptr<FEXCore::IR::PassManager> PassManager;
+    // Only allocated when JIT symbols are written
+    fextl::unique_ptr<FEXCore::JITSymbolBuffer> SymbolBuffer;
+
+    // Interpreter tier that runs cold blocks until they are executed enough times to be JIT compiled.
+    // Only allocated when the tier is enabled.
+    fextl::unique_ptr<FEXCore::CPU::CPUBackend> InterpreterBackend;
+    fextl::unique_ptr<FEXCore::IR::PassManager> InterpreterPassManager;
+    // Blocks that have been promoted out of the interpreter tier.
+    fextl::unordered_set<uint64_t> HotBlocks;
+    // Multiblock regions with side exits keyed by entry, only used when the edge profile threshold is set
+    // Erased along with the region's code entry, accessed with the CodeInvalidationMutex held
+    fextl::unordered_map<uint64_t, MultiblockRegionProfile> RegionProfiles;
     FEXCore::HLE::ThreadManagement ThreadManager;
 
     int StatusCode{};
@@ -114,6 +143,9 @@ namespace FEXCore::Core {
     // Queue of thread local signal frames that have been deferred.
     // Async signals aren't guaranteed to be delivered in any particular order, but FEX treats them as FILO.
     fextl::vector<DeferredSignalState> DeferredSignalFrames;
+    // Tracks if the page at DeferredSignalFaultAddress is currently PROT_NONE.
+    // Signal storms would otherwise pay for an mprotect on every deferred signal.
+    bool DeferredSignalFaultPageProtected{};
 
     // BaseFrameState should always be at the end.
     alignas(16) FEXCore::Core::CpuStateFrame BaseFrameState{};
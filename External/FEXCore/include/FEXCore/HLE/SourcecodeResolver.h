@@ -93,5 +93,8 @@ private:
 class SourcecodeResolver {
 public:
   virtual fextl::unique_ptr<SourcecodeMap> GenerateMap(const std::string_view& GuestBinaryFile, const std::string_view& GuestBinaryFileId) = 0;
+
+  // Only fills SortedSymbolMappings, from the symbol tables of the binary. Cheap enough to do for every mapped file.
+  virtual fextl::unique_ptr<SourcecodeMap> GenerateSymbolMap(const std::string_view& GuestBinaryFile) { return {}; }
 };
 }
@@ -51,8 +51,8 @@ namespace FEXCore::HLE {
   class SourcecodeResolver;
 
   struct AOTIRCacheEntryLookupResult {
-    AOTIRCacheEntryLookupResult(FEXCore::IR::AOTIRCacheEntry *Entry, uintptr_t VAFileStart)
-      : Entry(Entry), VAFileStart(VAFileStart) {
+    AOTIRCacheEntryLookupResult(FEXCore::IR::AOTIRCacheEntry *Entry, uintptr_t VAFileStart, bool MappingUnmodified = false)
+      : Entry(Entry), VAFileStart(VAFileStart), MappingUnmodified(MappingUnmodified) {
 
     }
 
@@ -60,6 +60,8 @@ namespace FEXCore::HLE {
 
     FEXCore::IR::AOTIRCacheEntry *Entry;
     uintptr_t VAFileStart;
+    // The guest can't have written to the mapping since it was made, so it still holds the file contents
+    bool MappingUnmodified;
 
     friend class SyscallHandler;
   };
@@ -423,6 +423,9 @@ typedef void ThunkedFunction(void* ArgsRv);
 struct ThunkDefinition final {
   SHA256Sum Sum;
   ThunkedFunction *ThunkFunction;
+  // The host function is a leaf that never touches guest state or host vector registers.
+  // Lets the JIT skip spilling and preserving FPRs around the call.
+  bool GPROnly{};
 };
 
 class NodeIterator;
@@ -509,6 +512,9 @@ enum class SyscallFlags : uint8_t {
   // Usually used with !NOSYNCSTATEONENTRY, so the syscall can modify CPU state entirely.
   // Then on return FEXCore picks up the new state.
   NORETURNEDRESULT   = 1 << 4,
+  // Syscall is cheap enough that leaving the JIT costs as much as the syscall itself.
+  // Only together with NOSYNCSTATEONENTRY, lets the JIT call the handler directly instead of returning to the frontend.
+  DIRECTCALL         = 1 << 5,
 };
 
 FEX_DEF_NUM_OPS(SyscallFlags)
@@ -26,6 +26,8 @@ friend class FEXCore::IR::PassManager;
       ResetWorkingList();
     }
 
+    virtual ~IREmitter() = default;
+
     void ReownOrClaimBuffer() {
       DualListData.ReownOrClaimBuffer();
     }
@@ -330,6 +332,9 @@ friend class FEXCore::IR::PassManager;
   protected:
     void RemoveArgUses(OrderedNode *Node);
 
+    // Called by SetCurrentCodeBlock before it leaves the current block, the write cursor is on the block's last op
+    virtual void CodeBlockEnded() {}
+
     OrderedNode *CreateNode(IROp_Header *Op) {
       uintptr_t ListBegin = DualListData.ListBegin();
       size_t Size = sizeof(OrderedNode);
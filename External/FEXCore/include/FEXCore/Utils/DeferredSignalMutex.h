@@ -190,20 +190,16 @@ namespace FEXCore {
           // Unlock the mutex
           (Mutex->*unlock_fn)();
 
-#ifdef _M_X86_64
           // Needs to be atomic so that operations can't end up getting reordered around this.
-          // Without this, the recount and the signal access could get reordered.
+          // Without this, the refcount and the signal access could get reordered.
           auto Result = Thread->CurrentFrame->State.DeferredSignalRefCount.Decrement(1);
 
-          // X86-64 must do an additional check around the store.
+          // Only the outermost section needs to check for pending signals.
+          // Nested sections would otherwise fault on every exit while a signal is pending.
           if ((Result - 1) == 0) {
             // Must happen after the refcount store
             Thread->CurrentFrame->State.DeferredSignalFaultAddress->Store(0);
           }
-#else
-          Thread->CurrentFrame->State.DeferredSignalRefCount.Decrement(1);
-          Thread->CurrentFrame->State.DeferredSignalFaultAddress->Store(0);
-#endif
         }
       }
     private:
@@ -290,20 +286,16 @@ namespace FEXCore {
           (Mutex->*unlock_fn)();
 
           if (Thread) {
-#ifdef _M_X86_64
             // Needs to be atomic so that operations can't end up getting reordered around this.
             // Without this, the refcount and the signal access could get reordered.
             auto Result = Thread->CurrentFrame->State.DeferredSignalRefCount.Decrement(1);
 
-            // X86-64 must do an additional check around the store.
+            // Only the outermost section needs to check for pending signals.
+            // Nested sections would otherwise fault on every exit while a signal is pending.
             if ((Result - 1) == 0) {
               // Must happen after the refcount store
               Thread->CurrentFrame->State.DeferredSignalFaultAddress->Store(0);
             }
-#else
-            Thread->CurrentFrame->State.DeferredSignalRefCount.Decrement(1);
-            Thread->CurrentFrame->State.DeferredSignalFaultAddress->Store(0);
-#endif
           }
           else {
             // Unmask back to the original signal mask
@@ -0,0 +1,75 @@
+#!/usr/bin/python3
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+
+# Runs a guest program twice under FEX with the same data directory.
+# The first run captures the AOTIR cache along with the host code of each block.
+# The second run loads that cache and relocates the cached host code instead of compiling the IR.
+# Both runs have to pass, and blocks of the program have to show up in the second run's JIT symbol map,
+# which only happens if the relocated blocks kept what the JIT naming needs.
+
+# Args: <FEXLoader> <Guest program> <Guest args>...
+
+if (len(sys.argv) < 3):
+    print("Usage: {} <FEXLoader> <Guest program> <Guest args>...".format(sys.argv[0]))
+    sys.exit(1)
+
+fexecutable = sys.argv[1]
+guest_args = sys.argv[2:]
+guest_name = os.path.basename(sys.argv[2])
+
+RunnerArgs = [fexecutable]
+ROOTFS_ENV = os.getenv("ROOTFS")
+if ROOTFS_ENV != None:
+    RunnerArgs.append("-R")
+    RunnerArgs.append(ROOTFS_ENV)
+RunnerArgs.extend(guest_args)
+
+def Run(DataDir, Options):
+    Env = dict(os.environ)
+    Env["FEX_APP_DATA_LOCATION"] = DataDir + "/"
+    Env.update(Options)
+    print(Options, RunnerArgs)
+    Process = subprocess.Popen(RunnerArgs, env=Env)
+    Process.wait()
+    return Process.pid, Process.returncode
+
+with tempfile.TemporaryDirectory() as DataDir:
+    _, ResultCode = Run(DataDir, {
+        "FEX_AOTIRCAPTURE": "1",
+        "FEX_CACHEOBJECTCODECOMPILATION": "readwrite",
+    })
+    if ResultCode != 0:
+        print("capture run failed with", ResultCode)
+        sys.exit(1)
+
+    if len(glob.glob(DataDir + "/aotir/*.aotir")) == 0:
+        print("capture run didn't write an AOTIR cache")
+        sys.exit(1)
+
+    Pid, ResultCode = Run(DataDir, {
+        "FEX_AOTIRLOAD": "1",
+        "FEX_CACHEOBJECTCODECOMPILATION": "read",
+        "FEX_BLOCKJITNAMING": "1",
+    })
+
+    PerfMap = "/tmp/perf-{}.map".format(Pid)
+    NamedBlocks = 0
+    if os.path.exists(PerfMap):
+        with open(PerfMap) as Map:
+            NamedBlocks = sum(1 for Line in Map if guest_name in Line)
+        os.remove(PerfMap)
+
+    if ResultCode != 0:
+        print("load run failed with", ResultCode)
+        sys.exit(1)
+
+    if NamedBlocks == 0:
+        print("load run didn't name any blocks of", guest_name)
+        sys.exit(1)
+
+    print("test passed,", NamedBlocks, "named blocks")
+    sys.exit(0)
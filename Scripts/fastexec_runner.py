@@ -0,0 +1,125 @@
+#!/usr/bin/python3
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+# Runs a guest program under FEX with FastExec enabled and a fresh data directory, then checks one of:
+#   capture_load  The first run captures a profile and its AOTIR caches, the second run loads them and keeps the profile.
+#   invalidated   A profile naming caches the program doesn't use is dropped by the run that loads it, the next run captures again.
+#   fork          A forked child that outlives the capturing run doesn't keep the capture lock or its fd.
+#                 The guest program is expected to leave such a child behind.
+
+# Args: <Scenario> <FEXLoader> <Guest program> <Guest args>...
+
+if (len(sys.argv) < 4):
+    print("Usage: {} <Scenario> <FEXLoader> <Guest program> <Guest args>...".format(sys.argv[0]))
+    sys.exit(1)
+
+scenario = sys.argv[1]
+fexecutable = sys.argv[2]
+guest_args = sys.argv[3:]
+
+RunnerArgs = [fexecutable]
+ROOTFS_ENV = os.getenv("ROOTFS")
+if ROOTFS_ENV != None:
+    RunnerArgs.append("-R")
+    RunnerArgs.append(ROOTFS_ENV)
+RunnerArgs.extend(guest_args)
+
+def Run(DataDir):
+    Env = dict(os.environ)
+    Env["FEX_APP_DATA_LOCATION"] = DataDir + "/"
+    Env["FEX_FASTEXEC"] = "1"
+    Env["FEX_SILENTLOG"] = "0"
+    print(RunnerArgs)
+    # Not a pipe, reading it to the end would wait for any child the guest left behind
+    with tempfile.TemporaryFile(mode="w+") as Log:
+        Process = subprocess.run(RunnerArgs, env=Env, stdout=Log, stderr=subprocess.STDOUT)
+        Log.seek(0)
+        Output = Log.read()
+    print(Output)
+    return Process.returncode, Output
+
+def Profiles(DataDir):
+    return glob.glob(DataDir + "/fastexec/*.profile")
+
+def Fail(Message):
+    print(Message)
+    sys.exit(1)
+
+def ExpectRun(DataDir, Expected):
+    ResultCode, Output = Run(DataDir)
+    if ResultCode != 0:
+        Fail("run failed with {}".format(ResultCode))
+    if "FastExec: " + Expected not in Output:
+        Fail("run wasn't {}".format(Expected.lower()))
+
+# Processes that still have a capture lock file of this data directory open
+def CaptureLockHolders(DataDir):
+    Holders = []
+    for FDPath in glob.glob("/proc/[0-9]*/fd/*"):
+        try:
+            Target = os.readlink(FDPath)
+        except OSError:
+            continue
+        if Target.startswith(DataDir) and Target.endswith(".capture"):
+            Holders.append(FDPath)
+    return Holders
+
+with tempfile.TemporaryDirectory() as DataDir:
+    DataDir = os.path.realpath(DataDir)
+
+    ExpectRun(DataDir, "Capturing")
+    if len(Profiles(DataDir)) != 1:
+        Fail("capture run didn't write a profile")
+    if len(glob.glob(DataDir + "/aotir/*.aotir")) == 0:
+        Fail("capture run didn't write an AOTIR cache")
+
+    if scenario == "capture_load":
+        Profile = Profiles(DataDir)[0]
+        with open(Profile) as File:
+            Captured = File.read()
+
+        ExpectRun(DataDir, "Loading")
+        if not os.path.exists(Profile):
+            Fail("loading run dropped a profile that covers the program")
+        with open(Profile) as File:
+            if File.read() != Captured:
+                Fail("loading run rewrote the profile")
+
+    elif scenario == "invalidated":
+        # Stands in for the libraries having been updated since the capture
+        Profile = Profiles(DataDir)[0]
+        with open(Profile, "w") as File:
+            File.write("FEXFastExec 1\n0000000000000000\n")
+
+        ExpectRun(DataDir, "Loading")
+        if os.path.exists(Profile):
+            Fail("loading run kept a profile that doesn't cover the program")
+
+        ExpectRun(DataDir, "Capturing")
+        if len(Profiles(DataDir)) != 1:
+            Fail("run after the invalidation didn't capture a profile again")
+
+    elif scenario == "fork":
+        # The child is still running at this point
+        Holders = CaptureLockHolders(DataDir)
+        if len(Holders) != 0:
+            Fail("capture lock is still open in {}".format(Holders))
+
+        # The profile was written, drop it so the next run has to take the lock again
+        for Profile in Profiles(DataDir):
+            os.remove(Profile)
+        ExpectRun(DataDir, "Capturing")
+
+        # Lets the children finish before the data directory goes away
+        time.sleep(3)
+
+    else:
+        Fail("Unknown scenario {}".format(scenario))
+
+    print("test passed")
+    sys.exit(0)
@@ -0,0 +1,143 @@
+#!/usr/bin/python3
+import argparse
+import json
+import os.path
+import platform
+import re
+import subprocess
+import sys
+import time
+
+# Runs the guest kernels in unittests/Benchmarks through TestHarnessRunner and reports
+# the code the JIT generated for them, how quickly it was compiled and the wall-clock time of the run.
+# With --native the same binaries also run on the host core, which gives the slowdown over native on x86-64 hosts.
+#
+# Args: [--baseline <Baseline.json>] [--update-baseline] [--native] <TestHarnessRunner> <Benchmark .bin>...
+
+RUNNER_ARGS = ["--no-silent", "-c", "irjit", "-n", "500", "--multiblock"]
+NATIVE_RUNNER_ARGS = ["--no-silent", "-c", "host"]
+
+# Allowed growth over the baseline before a benchmark is reported as a regression
+CODE_SIZE_TOLERANCE = 0.02
+TIME_TOLERANCE = 0.10
+
+STATS_REGEX = re.compile(r"JITStats: Blocks=(\d+) GuestInstructions=(\d+) GuestBytes=(\d+) HostCodeBytes=(\d+) CompileNanoseconds=(\d+)")
+
+def RunBenchmark(Runner, Bin):
+    Config = Bin[:-len(".bin")] + ".config.bin"
+
+    Start = time.monotonic()
+    Process = subprocess.run([Runner] + RUNNER_ARGS + [Bin, Config], stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    WallTime = time.monotonic() - Start
+
+    Match = STATS_REGEX.search(Process.stdout)
+    if Process.returncode != 0 or not Match or "Passed? Yes" not in Process.stdout:
+        print(Process.stdout)
+        return None
+
+    Blocks, GuestInstructions, GuestBytes, HostCodeBytes, CompileNanoseconds = (int(Value) for Value in Match.groups())
+
+    Result = {
+        "Blocks": Blocks,
+        "GuestInstructions": GuestInstructions,
+        "HostBytesPerGuestInst": HostCodeBytes / max(GuestInstructions, 1),
+        "BlocksPerSecond": Blocks / max(CompileNanoseconds / 1e9, 1e-9),
+        "WallTime": WallTime,
+    }
+
+    # AArch64 has fixed size instructions so the instruction count falls out of the code size
+    if platform.machine() == "aarch64":
+        Result["HostInstsPerGuestInst"] = (HostCodeBytes / 4) / max(GuestInstructions, 1)
+
+    return Result
+
+# The host core runs the code directly, so there are no JIT stats to read
+def RunNative(Runner, Bin):
+    Config = Bin[:-len(".bin")] + ".config.bin"
+
+    Start = time.monotonic()
+    Process = subprocess.run([Runner] + NATIVE_RUNNER_ARGS + [Bin, Config], stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    WallTime = time.monotonic() - Start
+
+    if Process.returncode != 0 or "Passed? Yes" not in Process.stdout:
+        print(Process.stdout)
+        return None
+
+    return WallTime
+
+def CompareToBaseline(Name, Result, Baseline):
+    Regressions = []
+    if Name not in Baseline:
+        return Regressions
+
+    # Entries only hold the fields that were measured for them
+    Base = Baseline[Name]
+    if "HostBytesPerGuestInst" in Base and Result["HostBytesPerGuestInst"] > Base["HostBytesPerGuestInst"] * (1 + CODE_SIZE_TOLERANCE):
+        Regressions.append("host bytes per guest instruction {:.2f} -> {:.2f}".format(Base["HostBytesPerGuestInst"], Result["HostBytesPerGuestInst"]))
+
+    if "BlocksPerSecond" in Base and Result["BlocksPerSecond"] < Base["BlocksPerSecond"] * (1 - TIME_TOLERANCE):
+        Regressions.append("compiled blocks per second {:.0f} -> {:.0f}".format(Base["BlocksPerSecond"], Result["BlocksPerSecond"]))
+
+    if "WallTime" in Base and Result["WallTime"] > Base["WallTime"] * (1 + TIME_TOLERANCE):
+        Regressions.append("wall time {:.3f}s -> {:.3f}s".format(Base["WallTime"], Result["WallTime"]))
+
+    if "SlowdownOverNative" in Base and "SlowdownOverNative" in Result and \
+       Result["SlowdownOverNative"] > Base["SlowdownOverNative"] * (1 + TIME_TOLERANCE):
+        Regressions.append("slowdown over native {:.2f}x -> {:.2f}x".format(Base["SlowdownOverNative"], Result["SlowdownOverNative"]))
+
+    return Regressions
+
+def main():
+    Parser = argparse.ArgumentParser(description="Guest microbenchmark runner")
+    Parser.add_argument("--baseline", help="Baseline JSON to compare against")
+    Parser.add_argument("--update-baseline", action="store_true", help="Write the results to the baseline instead of comparing")
+    Parser.add_argument("--native", action="store_true", help="Also run the benchmarks on the host core and report the slowdown")
+    Parser.add_argument("runner", help="Path to TestHarnessRunner")
+    Parser.add_argument("benchmarks", nargs="+", help="Assembled benchmark binaries")
+    Args = Parser.parse_args()
+
+    Baseline = {}
+    if Args.baseline and os.path.exists(Args.baseline) and not Args.update_baseline:
+        with open(Args.baseline) as BaselineFile:
+            Baseline = json.load(BaselineFile)
+
+    Results = {}
+    Failed = False
+
+    print("{:<24} {:>8} {:>12} {:>12} {:>12} {:>10} {:>12} {:>10}".format("Benchmark", "Blocks", "Bytes/Inst", "Insts/Inst", "Blocks/s", "Time (s)", "Native (s)", "Slowdown"))
+    for Bin in sorted(Args.benchmarks):
+        Name = os.path.basename(Bin)[:-len(".asm.bin")]
+        Result = RunBenchmark(Args.runner, Bin)
+        if Result is None:
+            print("{:<24} failed to run".format(Name))
+            Failed = True
+            continue
+
+        if Args.native:
+            NativeWallTime = RunNative(Args.runner, Bin)
+            if NativeWallTime is None:
+                print("{:<24} failed to run natively".format(Name))
+                Failed = True
+            else:
+                Result["NativeWallTime"] = NativeWallTime
+                Result["SlowdownOverNative"] = Result["WallTime"] / max(NativeWallTime, 1e-9)
+
+        Results[Name] = Result
+        InstsPerInst = "{:.2f}".format(Result["HostInstsPerGuestInst"]) if "HostInstsPerGuestInst" in Result else "-"
+        Native = "{:.3f}".format(Result["NativeWallTime"]) if "NativeWallTime" in Result else "-"
+        Slowdown = "{:.2f}x".format(Result["SlowdownOverNative"]) if "SlowdownOverNative" in Result else "-"
+        print("{:<24} {:>8} {:>12.2f} {:>12} {:>12.0f} {:>10.3f} {:>12} {:>10}".format(Name, Result["Blocks"], Result["HostBytesPerGuestInst"], InstsPerInst, Result["BlocksPerSecond"], Result["WallTime"], Native, Slowdown))
+
+        for Regression in CompareToBaseline(Name, Result, Baseline):
+            print("  Regression: {}".format(Regression))
+            Failed = True
+
+    if Args.update_baseline and Args.baseline:
+        with open(Args.baseline, "w") as BaselineFile:
+            json.dump(Results, BaselineFile, indent=2, sort_keys=True)
+            BaselineFile.write("\n")
+
+    return 1 if Failed else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
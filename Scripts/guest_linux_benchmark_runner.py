@@ -0,0 +1,71 @@
+#!/usr/bin/python3
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+# Runs the guest Linux benchmarks in unittests/Benchmarks/Linux through FEXLoader and reports the rates they print.
+# Each benchmark prints one line per measured loop:
+#   Rate: <Name> <calls per second>
+# With --native the same binaries also run directly on the host, which gives the slowdown over native on x86 hosts.
+#
+# Args: [--native] <FEXLoader> <Benchmark binary>...
+
+LOADER_ARGS = ["-c", "irjit", "-n", "500", "--"]
+
+RATE_REGEX = re.compile(r"^Rate: (\S+) ([0-9.]+)$", re.MULTILINE)
+
+def Run(Args):
+    Process = subprocess.run(Args, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    Rates = {Name: float(Rate) for Name, Rate in RATE_REGEX.findall(Process.stdout)}
+    if Process.returncode != 0 or len(Rates) == 0:
+        print(Process.stdout)
+        return None
+
+    return Rates
+
+def main():
+    Parser = argparse.ArgumentParser(description="Guest Linux benchmark runner")
+    Parser.add_argument("--native", action="store_true", help="Also run the benchmarks directly on the host and report the slowdown")
+    Parser.add_argument("loader", help="Path to FEXLoader")
+    Parser.add_argument("benchmarks", nargs="+", help="Benchmark binaries")
+    Args = Parser.parse_args()
+
+    LoaderArgs = [Args.loader]
+    ROOTFS_ENV = os.getenv("ROOTFS")
+    if ROOTFS_ENV != None:
+        LoaderArgs += ["-R", ROOTFS_ENV]
+    LoaderArgs += LOADER_ARGS
+
+    Failed = False
+
+    print("{:<32} {:>14} {:>14} {:>10}".format("Benchmark", "Calls/s", "Native", "Slowdown"))
+    for Bin in sorted(Args.benchmarks):
+        Name = os.path.basename(Bin)
+        Rates = Run(LoaderArgs + [Bin])
+        if Rates is None:
+            print("{:<32} failed to run".format(Name))
+            Failed = True
+            continue
+
+        NativeRates = {}
+        if Args.native:
+            NativeRates = Run([Bin])
+            if NativeRates is None:
+                print("{:<32} failed to run natively".format(Name))
+                NativeRates = {}
+                Failed = True
+
+        for Loop, Rate in Rates.items():
+            Native = "-"
+            Slowdown = "-"
+            if Loop in NativeRates:
+                Native = "{:.0f}".format(NativeRates[Loop])
+                Slowdown = "{:.2f}x".format(NativeRates[Loop] / max(Rate, 1e-9))
+            print("{:<32} {:>14.0f} {:>14} {:>10}".format(Name + ":" + Loop, Rate, Native, Slowdown))
+
+    return 1 if Failed else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,66 @@
+#!/usr/bin/python3
+import os
+import re
+import subprocess
+import sys
+
+# Checks the IR the JIT ends up with after its passes for an ASM test.
+# The test source lists what it expects with comment lines:
+#   ; IR-CHECK: <regex>      Some op of the optimized IR has to match
+#   ; IR-CHECK-NOT: <regex>  No op of the optimized IR may match
+#
+# Args: <ASM source> <TestHarnessRunner> <Runner args>...
+
+CHECK_REGEX = re.compile(r"^\s*;\s*IR-CHECK(-NOT)?:\s*(.*?)\s*$")
+
+if (len(sys.argv) < 3):
+    print("Usage: {} <ASM source> <TestHarnessRunner> <Runner args>...".format(sys.argv[0]))
+    sys.exit(1)
+
+asm_source = sys.argv[1]
+RunnerArgs = sys.argv[2:]
+
+Checks = []
+with open(asm_source) as Source:
+    for Line in Source:
+        Match = CHECK_REGEX.match(Line)
+        if Match:
+            Checks.append((Match.group(1) is None, re.compile(Match.group(2))))
+
+if len(Checks) == 0:
+    print("No IR checks in", asm_source)
+    sys.exit(1)
+
+Env = dict(os.environ)
+Env["FEX_DUMPIR"] = "stdout"
+Process = subprocess.run(RunnerArgs, env=Env, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+if Process.returncode != 0:
+    print(Process.stdout)
+    print("Runner failed with", Process.returncode)
+    sys.exit(1)
+
+# Each block is dumped before and after the passes, only the IR after them is checked
+PostIR = []
+for Section in Process.stdout.split("@@@@@"):
+    Section = Section.strip()
+    if Section.startswith("IR-post"):
+        PostIR.extend(Section.splitlines()[1:])
+
+if len(PostIR) == 0:
+    print(Process.stdout)
+    print("Runner didn't dump any optimized IR")
+    sys.exit(1)
+
+Failed = False
+for Expected, Regex in Checks:
+    Found = any(Regex.search(Line) for Line in PostIR)
+    if Found != Expected:
+        print("IR-CHECK{} failed: {}".format("" if Expected else "-NOT", Regex.pattern))
+        Failed = True
+
+if Failed:
+    print("\n".join(PostIR))
+    sys.exit(1)
+
+print("test passed,", len(Checks), "IR checks")
+sys.exit(0)
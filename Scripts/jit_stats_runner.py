@@ -0,0 +1,116 @@
+#!/usr/bin/python3
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+# Runs a guest program under FEX with JITStatsFile set, then parses the JSON it writes on exit and checks its fields.
+# The guest program is run from a copy whose name needs escaping in JSON.
+# It is expected to compile code in anonymous memory and then modify it, so that both modules and invalidations show up.
+
+# Args: <FEXLoader> <Guest program> <Guest args>...
+
+if (len(sys.argv) < 3):
+    print("Usage: {} <FEXLoader> <Guest program> <Guest args>...".format(sys.argv[0]))
+    sys.exit(1)
+
+fexecutable = sys.argv[1]
+guest_program = sys.argv[2]
+guest_args = sys.argv[3:]
+
+ModuleFields = [
+    "BlocksCompiled",
+    "GuestInstructions",
+    "GuestBytes",
+    "IRNodes",
+    "SpillSlots",
+    "HostCodeBytes",
+    "FrontendMicroseconds",
+    "PassMicroseconds",
+    "CodegenMicroseconds",
+    "AOTIRHits",
+    "ObjectCacheHits",
+]
+
+def Fail(Message):
+    print(Message)
+    sys.exit(1)
+
+def IsCount(Value):
+    # bool is an int in python, the stats never contain one
+    return type(Value) == int and Value >= 0
+
+with tempfile.TemporaryDirectory() as TempDir:
+    TempDir = os.path.realpath(TempDir)
+
+    # A quote, a backslash and a control character
+    Guest = os.path.join(TempDir, "jit \"stats\\\t" + os.path.basename(guest_program))
+    shutil.copy(guest_program, Guest)
+
+    RunnerArgs = [fexecutable]
+    ROOTFS_ENV = os.getenv("ROOTFS")
+    if ROOTFS_ENV != None:
+        RunnerArgs.append("-R")
+        RunnerArgs.append(ROOTFS_ENV)
+    RunnerArgs.append(Guest)
+    RunnerArgs.extend(guest_args)
+
+    Env = dict(os.environ)
+    Env["FEX_JITSTATSFILE"] = os.path.join(TempDir, "stats-{pid}.json")
+    # Only JIT compiled blocks are counted
+    Env["FEX_INTERPRETERTIERTHRESHOLD"] = "0"
+    print(RunnerArgs)
+
+    Process = subprocess.Popen(RunnerArgs, env=Env)
+    Process.wait(60)
+    if Process.returncode != 0:
+        Fail("guest failed with {}".format(Process.returncode))
+
+    # FEX runs the guest in its own process, the placeholder is replaced with its pid
+    StatsFiles = [File for File in os.listdir(TempDir) if File.endswith(".json")]
+    if StatsFiles != ["stats-{}.json".format(Process.pid)]:
+        Fail("expected only the stats file of pid {}, found {}".format(Process.pid, StatsFiles))
+
+    with open(os.path.join(TempDir, StatsFiles[0])) as File:
+        Contents = File.read()
+    print(Contents)
+
+    try:
+        Stats = json.loads(Contents)
+    except json.JSONDecodeError as Error:
+        Fail("stats file isn't valid JSON: {}".format(Error))
+
+    if type(Stats) != dict or sorted(Stats.keys()) != ["CodeInvalidations", "Modules"]:
+        Fail("unexpected top level fields")
+    if not IsCount(Stats["CodeInvalidations"]) or Stats["CodeInvalidations"] == 0:
+        Fail("modified code wasn't counted as invalidated")
+
+    Modules = Stats["Modules"]
+    if type(Modules) != dict:
+        Fail("Modules isn't an object")
+
+    for Module, ModuleStats in Modules.items():
+        if type(ModuleStats) != dict or sorted(ModuleStats.keys()) != sorted(ModuleFields):
+            Fail("unexpected fields for {}".format(Module))
+        for Field in ModuleFields:
+            if not IsCount(ModuleStats[Field]):
+                Fail("{} of {} isn't a count".format(Field, Module))
+
+    # The copy's name only survives the round trip if it was escaped
+    for Module in [Guest, "<anonymous>"]:
+        if Module not in Modules:
+            Fail("no stats for {}, found {}".format(Module, list(Modules.keys())))
+
+        ModuleStats = Modules[Module]
+        for Field in ["BlocksCompiled", "GuestInstructions", "GuestBytes", "IRNodes", "HostCodeBytes"]:
+            if ModuleStats[Field] == 0:
+                Fail("{} of {} is zero".format(Field, Module))
+
+        # Every decoded instruction is at least one byte
+        if ModuleStats["GuestBytes"] < ModuleStats["GuestInstructions"]:
+            Fail("{} decoded fewer bytes than instructions".format(Module))
+
+print("test passed")
+sys.exit(0)
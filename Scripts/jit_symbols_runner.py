@@ -0,0 +1,118 @@
+#!/usr/bin/python3
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+# Runs one case of the jit-symbols guest test under FEX with BlockJITNaming, then checks the perf map for its marker block:
+#   idle   The symbol is written while the guest is blocked and not compiling anything.
+#   exec   The symbol is written before the guest execs, the new image doesn't write the perf map.
+#   crash  The symbol is written before the guest dies from a fatal signal.
+#   fork   The symbol is written exactly once, a forked child exiting doesn't write the parent's buffered symbols.
+
+# Args: <Scenario> <FEXLoader> <Guest program>
+
+if (len(sys.argv) != 4):
+    print("Usage: {} <Scenario> <FEXLoader> <Guest program>".format(sys.argv[0]))
+    sys.exit(1)
+
+scenario = sys.argv[1]
+fexecutable = sys.argv[2]
+guest_program = sys.argv[3]
+
+if scenario not in ["idle", "exec", "crash", "fork"]:
+    print("Unknown scenario {}".format(scenario))
+    sys.exit(1)
+
+RunnerArgs = [fexecutable]
+ROOTFS_ENV = os.getenv("ROOTFS")
+if ROOTFS_ENV != None:
+    RunnerArgs.append("-R")
+    RunnerArgs.append(ROOTFS_ENV)
+RunnerArgs.extend([guest_program, "jit symbols: " + scenario])
+
+# Long enough for the symbols of an idle thread to be flushed, they may be up to twice JITSymbolBuffer::MAXIMUM_AGE old
+FLUSH_TIMEOUT = 5
+
+def Fail(Message):
+    print(Message)
+    sys.exit(1)
+
+def ReadFile(Path):
+    try:
+        with open(Path) as File:
+            return File.read()
+    except OSError:
+        return ""
+
+# Waits for Check to return something other than None
+def WaitFor(Check, Timeout):
+    End = time.monotonic() + Timeout
+    while True:
+        Result = Check()
+        if Result != None or time.monotonic() > End:
+            return Result
+        time.sleep(0.1)
+
+def MarkerCount(PerfMap, Marker):
+    return len(re.findall(r"^\S+ \S+ JIT_{}_".format(Marker), ReadFile(PerfMap), re.MULTILINE))
+
+Env = dict(os.environ)
+Env["FEX_BLOCKJITNAMING"] = "1"
+print(RunnerArgs)
+
+# Not a pipe, reading it to the end would wait for the guest's children
+with tempfile.TemporaryFile(mode="w+") as Log:
+    Process = subprocess.Popen(RunnerArgs, env=Env, stdin=subprocess.PIPE, stdout=Log, stderr=subprocess.STDOUT)
+    # FEX runs the guest in its own process, the perf map is named after it
+    PerfMap = "/tmp/perf-{}.map".format(Process.pid)
+    JITDump = "/tmp/jit-{}.dump".format(Process.pid)
+
+    def ReadMarker():
+        Log.seek(0)
+        Match = re.search(r"^Marker: (0x[0-9a-f]+)$", Log.read(), re.MULTILINE)
+        return Match.group(1) if Match else None
+
+    try:
+        Marker = WaitFor(ReadMarker, 30)
+        if Marker == None:
+            Fail("guest didn't run its marker block")
+
+        if scenario == "idle":
+            Found = WaitFor(lambda: True if MarkerCount(PerfMap, Marker) != 0 else None, FLUSH_TIMEOUT)
+            # Lets the guest finish
+            Process.stdin.close()
+            Process.wait(30)
+            if Found == None:
+                Fail("symbol of an idle thread wasn't written within {} seconds".format(FLUSH_TIMEOUT))
+            if Process.returncode != 0:
+                Fail("guest failed with {}".format(Process.returncode))
+
+        else:
+            Process.stdin.close()
+            Process.wait(30)
+            if scenario == "crash":
+                if Process.returncode == 0:
+                    Fail("guest didn't crash")
+            elif Process.returncode != 0:
+                Fail("guest failed with {}".format(Process.returncode))
+
+            Count = MarkerCount(PerfMap, Marker)
+            if scenario == "fork":
+                if Count != 1:
+                    Fail("symbol was written {} times".format(Count))
+            elif Count == 0:
+                Fail("symbol wasn't written")
+    finally:
+        if Process.poll() == None:
+            Process.kill()
+        Log.seek(0)
+        print(Log.read())
+        for Path in [PerfMap, JITDump]:
+            if os.path.exists(Path):
+                os.remove(Path)
+
+print("test passed")
+sys.exit(0)
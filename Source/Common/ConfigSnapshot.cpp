@@ -0,0 +1,449 @@
+#include "Common/ConfigSnapshot.h"
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/list.h>
+#include <FEXCore/fextl/memory.h>
+#include <FEXHeaderUtils/Filesystem.h>
+
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <tiny-json.h>
+
+namespace FEX::Config::Snapshot {
+namespace JSON {
+  struct JsonAllocator {
+    jsonPool_t PoolObject;
+    fextl::unique_ptr<fextl::list<json_t>> json_objects;
+  };
+  static_assert(offsetof(JsonAllocator, PoolObject) == 0, "This needs to be at offset zero");
+
+  json_t* PoolInit(jsonPool_t* Pool) {
+    JsonAllocator* alloc = reinterpret_cast<JsonAllocator*>(Pool);
+    alloc->json_objects = fextl::make_unique<fextl::list<json_t>>();
+    return &*alloc->json_objects->emplace(alloc->json_objects->end());
+  }
+
+  json_t* PoolAlloc(jsonPool_t* Pool) {
+    JsonAllocator* alloc = reinterpret_cast<JsonAllocator*>(Pool);
+    return &*alloc->json_objects->emplace(alloc->json_objects->end());
+  }
+
+  static void Flatten(json_t const *Node, std::array<std::string_view, MAX_DEPTH> &Keys, uint32_t Depth, fextl::vector<Entry> *Entries) {
+    const bool IsObject = json_getType(Node) == JSON_OBJ;
+
+    for (json_t const* Child = json_getChild(Node); Child != nullptr; Child = json_getSibling(Child)) {
+      uint32_t ChildDepth = Depth;
+      if (IsObject) {
+        const char *Name = json_getName(Child);
+        if (!Name || Depth == MAX_DEPTH) {
+          continue;
+        }
+        Keys[Depth] = Name;
+        ++ChildDepth;
+      }
+
+      const auto Type = json_getType(Child);
+      if (Type == JSON_OBJ || Type == JSON_ARRAY) {
+        if (!json_getChild(Child)) {
+          Entries->push_back(Entry {ChildDepth, Keys, "", true});
+          continue;
+        }
+        Flatten(Child, Keys, ChildDepth, Entries);
+      }
+      else if (const char *Value = json_getValue(Child)) {
+        Entries->push_back(Entry {ChildDepth, Keys, Value});
+      }
+    }
+  }
+}
+
+// The snapshot is keyed by stat results and shared through a mapping, neither of which exist on Windows.
+// Files are always parsed there.
+#ifndef _WIN32
+namespace {
+  constexpr uint64_t SNAPSHOT_MAGIC = 0x50414E5343584546ULL; // "FEXCSNAP"
+  constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+  // Stored in the depth of an entry for an empty object or array
+  constexpr uint32_t ENTRY_EMPTY_CONTAINER = 1U << 31;
+
+  struct SnapshotHeader {
+    uint64_t Magic;
+    uint32_t Version;
+    uint32_t NumFiles;
+    uint64_t Size;
+  };
+
+  // A file is reparsed when any of these change
+  struct FileKey {
+    uint64_t Dev;
+    uint64_t Inode;
+    uint64_t Size;
+    uint64_t MTime;
+
+    bool operator==(const FileKey &) const = default;
+
+    static FileKey FromStat(const struct stat &Buffer) {
+      return FileKey {
+        .Dev = static_cast<uint64_t>(Buffer.st_dev),
+        .Inode = static_cast<uint64_t>(Buffer.st_ino),
+        .Size = static_cast<uint64_t>(Buffer.st_size),
+        .MTime = static_cast<uint64_t>(Buffer.st_mtim.tv_sec) * 1'000'000'000ULL + Buffer.st_mtim.tv_nsec,
+      };
+    }
+  };
+
+  struct FileBlockHeader {
+    FileKey Key;
+    uint32_t NumEntries;
+    // Size of the whole block, including this header
+    uint32_t BlockSize;
+  };
+
+  // Bounds checked reads out of the mapped snapshot, a truncated or corrupt snapshot just misses
+  class Reader {
+  public:
+    Reader(const char *Begin, const char *End)
+      : Cur {Begin}, End {End} {}
+
+    template<typename T>
+    bool Read(T *Value) {
+      if (static_cast<size_t>(End - Cur) < sizeof(T)) {
+        return false;
+      }
+      memcpy(Value, Cur, sizeof(T));
+      Cur += sizeof(T);
+      return true;
+    }
+
+    // Strings are stored with their null terminator
+    bool ReadString(std::string_view *Value) {
+      uint32_t Length;
+      if (!Read(&Length) || static_cast<size_t>(End - Cur) <= Length || Cur[Length] != '\0') {
+        return false;
+      }
+      *Value = std::string_view(Cur, Length);
+      Cur += Length + 1;
+      return true;
+    }
+
+    const char *Position() const { return Cur; }
+
+  private:
+    const char *Cur;
+    const char *End;
+  };
+
+  class Writer {
+  public:
+    template<typename T>
+    void Write(const T &Value) {
+      const auto *Bytes = reinterpret_cast<const char*>(&Value);
+      Data.insert(Data.end(), Bytes, Bytes + sizeof(T));
+    }
+
+    void WriteString(std::string_view Value) {
+      Write(static_cast<uint32_t>(Value.size()));
+      Data.insert(Data.end(), Value.begin(), Value.end());
+      Data.push_back('\0');
+    }
+
+    void WriteRaw(const char *Begin, const char *End) {
+      Data.insert(Data.end(), Begin, End);
+    }
+
+    template<typename T>
+    void Patch(size_t Offset, const T &Value) {
+      memcpy(&Data[Offset], &Value, sizeof(T));
+    }
+
+    fextl::vector<char> Data;
+  };
+
+  // Mappings are never unmapped, entries handed out point in to them.
+  // A newer snapshot replaces the current one when this process or another one stored a file.
+  struct MappedSnapshot {
+    bool Initialized;
+    const char *Begin;
+    const char *End;
+    uint32_t NumFiles;
+    // Identifies the snapshot file that was mapped, to notice when it got replaced
+    uint64_t Dev;
+    uint64_t Inode;
+  };
+  MappedSnapshot Snapshot{};
+
+  fextl::string GetSnapshotPath() {
+    return fextl::fmt::format("{}/ConfigSnapshot.bin", FEXCore::Config::GetDataDirectory());
+  }
+
+  MappedSnapshot MapSnapshot() {
+    MappedSnapshot Mapped {
+      .Initialized = true,
+    };
+
+    const auto Path = GetSnapshotPath();
+    int FD = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD == -1) {
+      return Mapped;
+    }
+
+    struct stat Buffer{};
+    SnapshotHeader Header{};
+    if (fstat(FD, &Buffer) == -1) {
+      close(FD);
+      return Mapped;
+    }
+
+    Mapped.Dev = Buffer.st_dev;
+    Mapped.Inode = Buffer.st_ino;
+
+    if (pread(FD, &Header, sizeof(Header), 0) != sizeof(Header) ||
+        Header.Magic != SNAPSHOT_MAGIC ||
+        Header.Version != SNAPSHOT_VERSION ||
+        Header.Size != static_cast<uint64_t>(Buffer.st_size)) {
+      close(FD);
+      return Mapped;
+    }
+
+    void *Ptr = mmap(nullptr, Header.Size, PROT_READ, MAP_PRIVATE, FD, 0);
+    close(FD);
+    if (Ptr == MAP_FAILED) {
+      return Mapped;
+    }
+
+    Mapped.Begin = reinterpret_cast<const char*>(Ptr);
+    Mapped.End = Mapped.Begin + Header.Size;
+    Mapped.NumFiles = Header.NumFiles;
+    return Mapped;
+  }
+
+  // Whether the snapshot on disk is a different file from the one that is mapped
+  bool SnapshotReplaced() {
+    struct stat Buffer{};
+    if (stat(GetSnapshotPath().c_str(), &Buffer) == -1) {
+      return false;
+    }
+
+    return static_cast<uint64_t>(Buffer.st_dev) != Snapshot.Dev ||
+           static_cast<uint64_t>(Buffer.st_ino) != Snapshot.Inode;
+  }
+
+  // Calls Func(Path, Header, BlockReader, BlockBegin, BlockEnd) for every file in the snapshot
+  template<typename F>
+  void ForEachFile(const MappedSnapshot &Mapped, F &&Func) {
+    if (!Mapped.Begin) {
+      return;
+    }
+
+    const char *Cur = Mapped.Begin + sizeof(SnapshotHeader);
+    for (uint32_t i = 0; i < Mapped.NumFiles; ++i) {
+      FileBlockHeader Header;
+      if (!Reader {Cur, Mapped.End}.Read(&Header) ||
+          Header.BlockSize < sizeof(FileBlockHeader) ||
+          Header.BlockSize > static_cast<size_t>(Mapped.End - Cur)) {
+        return;
+      }
+
+      // Everything past the header, including the path, has to fit in the block
+      const char *BlockEnd = Cur + Header.BlockSize;
+      Reader BlockReader {Cur + sizeof(FileBlockHeader), BlockEnd};
+      std::string_view Path;
+      if (!BlockReader.ReadString(&Path)) {
+        return;
+      }
+
+      if (Func(Path, Header, BlockReader, Cur, BlockEnd)) {
+        return;
+      }
+      Cur = BlockEnd;
+    }
+  }
+
+  bool ReadEntries(Reader EntryReader, uint32_t NumEntries, fextl::vector<Entry> *Entries) {
+    Entries->resize(NumEntries);
+    for (auto &Entry : *Entries) {
+      if (!EntryReader.Read(&Entry.Depth)) {
+        return false;
+      }
+
+      Entry.EmptyContainer = Entry.Depth & ENTRY_EMPTY_CONTAINER;
+      Entry.Depth &= ~ENTRY_EMPTY_CONTAINER;
+      if (Entry.Depth > MAX_DEPTH) {
+        return false;
+      }
+
+      for (uint32_t i = 0; i < Entry.Depth; ++i) {
+        if (!EntryReader.ReadString(&Entry.Keys[i])) {
+          return false;
+        }
+      }
+
+      if (!EntryReader.ReadString(&Entry.Value)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool FindFile(const MappedSnapshot &Mapped, const fextl::string &Filename, const FileKey &Key, fextl::vector<Entry> *Entries) {
+    bool Found = false;
+    ForEachFile(Mapped, [&](std::string_view Path, const FileBlockHeader &Header, Reader EntryReader, const char *, const char *) {
+      if (Path != Filename) {
+        return false;
+      }
+
+      Found = Header.Key == Key && ReadEntries(EntryReader, Header.NumEntries, Entries);
+      return true;
+    });
+
+    return Found;
+  }
+
+  void StoreFile(const fextl::string &Filename, const FileKey &Key, const fextl::vector<Entry> &Entries) {
+    const auto DataDirectory = FEXCore::Config::GetDataDirectory();
+    if (!FHU::Filesystem::Exists(DataDirectory) && !FHU::Filesystem::CreateDirectories(DataDirectory)) {
+      return;
+    }
+
+    // Processes that miss at the same time take turns, each one merges with what the previous one stored
+    const auto Path = GetSnapshotPath();
+    const auto LockPath = fextl::fmt::format("{}.lock", Path);
+    int LockFD = open(LockPath.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+    if (LockFD == -1) {
+      return;
+    }
+
+    if (flock(LockFD, LOCK_EX) == -1) {
+      close(LockFD);
+      return;
+    }
+
+    const auto Current = MapSnapshot();
+    fextl::vector<Entry> Existing;
+    if (FindFile(Current, Filename, Key, &Existing)) {
+      // Another process stored it first
+      Snapshot = Current;
+      close(LockFD);
+      return;
+    }
+
+    Writer Out;
+    Out.Write(SnapshotHeader {SNAPSHOT_MAGIC, SNAPSHOT_VERSION, 0, 0});
+    uint32_t NumFiles = 0;
+
+    // Carry over the other files, dropping any that changed or were removed since
+    ForEachFile(Current, [&](std::string_view Path, const FileBlockHeader &Header, Reader, const char *BlockBegin, const char *BlockEnd) {
+      struct stat Buffer{};
+      if (Path != Filename && stat(Path.data(), &Buffer) == 0 && FileKey::FromStat(Buffer) == Header.Key) {
+        Out.WriteRaw(BlockBegin, BlockEnd);
+        ++NumFiles;
+      }
+      return false;
+    });
+
+    const size_t BlockBegin = Out.Data.size();
+    Out.Write(FileBlockHeader {Key, static_cast<uint32_t>(Entries.size()), 0});
+    Out.WriteString(Filename);
+    for (const auto &Entry : Entries) {
+      Out.Write(Entry.Depth | (Entry.EmptyContainer ? ENTRY_EMPTY_CONTAINER : 0));
+      for (uint32_t i = 0; i < Entry.Depth; ++i) {
+        Out.WriteString(Entry.Keys[i]);
+      }
+      Out.WriteString(Entry.Value);
+    }
+    Out.Patch(BlockBegin + offsetof(FileBlockHeader, BlockSize), static_cast<uint32_t>(Out.Data.size() - BlockBegin));
+    ++NumFiles;
+
+    Out.Patch(offsetof(SnapshotHeader, NumFiles), NumFiles);
+    Out.Patch(offsetof(SnapshotHeader, Size), static_cast<uint64_t>(Out.Data.size()));
+
+    // Written to a temporary and renamed in to place so readers that don't take the lock only ever see a complete snapshot
+    const auto TmpPath = fextl::fmt::format("{}.{}.tmp", Path, getpid());
+    int FD = open(TmpPath.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+    if (FD != -1) {
+      const bool Written = write(FD, Out.Data.data(), Out.Data.size()) == static_cast<ssize_t>(Out.Data.size());
+      close(FD);
+
+      if (!Written || FHU::Filesystem::RenameFile(TmpPath, Path)) {
+        unlink(TmpPath.c_str());
+      }
+      else {
+        // Later lookups in this process see every file stored so far
+        Snapshot = MapSnapshot();
+      }
+    }
+
+    close(LockFD);
+  }
+}
+#endif
+
+  bool LoadFile(const fextl::string &Filename, ParsedFile *File) {
+#ifndef _WIN32
+    struct stat Buffer{};
+    const bool HaveKey = stat(Filename.c_str(), &Buffer) == 0;
+    const auto Key = FileKey::FromStat(Buffer);
+
+    if (HaveKey) {
+      if (!Snapshot.Initialized) {
+        Snapshot = MapSnapshot();
+      }
+
+      bool Found = FindFile(Snapshot, Filename, Key, &File->Entries);
+      if (!Found && SnapshotReplaced()) {
+        // Another process may have stored the file since the snapshot was mapped
+        Snapshot = MapSnapshot();
+        Found = FindFile(Snapshot, Filename, Key, &File->Entries);
+      }
+
+      if (Found) {
+        File->Data.clear();
+        return true;
+      }
+    }
+#endif
+
+    // Miss, parse the file and add it to the snapshot
+    File->Entries.clear();
+    if (!FEXCore::FileLoading::LoadFile(File->Data, Filename)) {
+      return false;
+    }
+    File->Data.push_back('\0');
+
+    JSON::JsonAllocator Pool {
+      .PoolObject = {
+        .init = JSON::PoolInit,
+        .alloc = JSON::PoolAlloc,
+      },
+    };
+
+    json_t const *json = json_createWithPool(File->Data.data(), &Pool.PoolObject);
+    if (!json) {
+      LogMan::Msg::EFmt("Couldn't create json from '{}'", Filename);
+      return false;
+    }
+
+    std::array<std::string_view, MAX_DEPTH> Keys{};
+    JSON::Flatten(json, Keys, 0, &File->Entries);
+
+#ifndef _WIN32
+    // Only stored when the file didn't change while it was read, the entries have to match the key
+    struct stat After{};
+    if (HaveKey && stat(Filename.c_str(), &After) == 0 && FileKey::FromStat(After) == Key) {
+      StoreFile(Filename, Key, File->Entries);
+    }
+#endif
+    return true;
+  }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Pre-parsed snapshots of FEX's JSON configuration files
+ *
+ * Every FEX process parses the same handful of config and thunk database files on startup.
+ * The flattened result of parsing each file is kept in a single binary snapshot in the data directory,
+ * keyed by the file's device, inode, size and modification time, so later processes only need to stat
+ * the file and read the entries out of one mapping.
+ */
+namespace FEX::Config::Snapshot {
+  constexpr size_t MAX_DEPTH = 3;
+
+  /**
+   * @brief One leaf value of a JSON file
+   *
+   * Keys are the object member names leading to the value, array elements share the keys of their array.
+   * An empty object or array gets an entry of its own with an empty value, so its name isn't lost.
+   * All strings are null terminated.
+   */
+  struct Entry {
+    uint32_t Depth;
+    std::array<std::string_view, MAX_DEPTH> Keys;
+    std::string_view Value;
+    bool EmptyContainer{};
+
+    bool Matches(std::string_view Key0) const {
+      return Depth >= 1 && Keys[0] == Key0;
+    }
+    bool Matches(std::string_view Key0, std::string_view Key1) const {
+      return Depth >= 2 && Keys[0] == Key0 && Keys[1] == Key1;
+    }
+  };
+
+  struct ParsedFile {
+    fextl::vector<Entry> Entries;
+
+    // Whether the entries were read from the snapshot rather than parsed from the file
+    bool FromSnapshot() const { return Data.empty(); }
+
+  private:
+    friend bool LoadFile(const fextl::string &Filename, ParsedFile *File);
+    // Backing storage when the file had to be parsed instead of coming from the snapshot
+    fextl::vector<char> Data;
+  };
+
+  /**
+   * @brief Loads a JSON file through the snapshot, parsing it and updating the snapshot on a miss
+   *
+   * @param Filename The JSON file to load
+   * @param File Receives the flattened entries, which stay valid for as long as File exists
+   *
+   * @return false if the file doesn't exist or couldn't be parsed
+   */
+  bool LoadFile(const fextl::string &Filename, ParsedFile *File);
+}
@@ -20,9 +20,66 @@
 #include <sys/types.h>
 #include <sys/un.h>
 #include <sys/uio.h>
+#include <mutex>
 #include <thread>
 
 namespace FEXServerClient {
+  static int ReceiveFDPacket(int ServerSocket) {
+    // Wait for success response with SCM_RIGHTS
+
+    FEXServerResultPacket Res{};
+    struct iovec iov {
+      .iov_base = &Res,
+      .iov_len = sizeof(Res),
+    };
+
+    struct msghdr msg {
+      .msg_name = nullptr,
+      .msg_namelen = 0,
+      .msg_iov = &iov,
+      .msg_iovlen = 1,
+    };
+
+    // Setup the ancillary buffer. This is where we will be getting pipe FDs
+    // We only need 4 bytes for the FD
+    constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int));
+    union AncillaryBuffer {
+      struct cmsghdr Header;
+      uint8_t Buffer[CMSG_SIZE];
+    };
+    AncillaryBuffer AncBuf{};
+
+    // Now link to our ancilllary buffer
+    msg.msg_control = AncBuf.Buffer;
+    msg.msg_controllen = CMSG_SIZE;
+
+    ssize_t DataResult = recvmsg(ServerSocket, &msg, 0);
+    if (DataResult > 0) {
+      // Now that we have the data, we can extract the FD from the ancillary buffer
+      struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+
+      // Do some error checking
+      if (cmsg == nullptr ||
+          cmsg->cmsg_len != CMSG_LEN(sizeof(int)) ||
+          cmsg->cmsg_level != SOL_SOCKET ||
+          cmsg->cmsg_type != SCM_RIGHTS) {
+        // Couldn't get a socket
+      }
+      else {
+        // Check for Success.
+        // If type error was returned then the FEXServer doesn't have a log to pipe in to
+        if (Res.Header.Type == PacketType::TYPE_SUCCESS) {
+          // Now that we know the cmsg is sane, read the FD
+          int NewFD{};
+          memcpy(&NewFD, CMSG_DATA(cmsg), sizeof(NewFD));
+          return NewFD;
+        }
+      }
+    }
+
+    return -1;
+  }
+
   int RequestPIDFDPacket(int ServerSocket, PacketType Type) {
     FEXServerRequestPacket Req {
       .Header {
@@ -32,57 +89,41 @@ namespace FEXServerClient {
 
     int Result = write(ServerSocket, &Req, sizeof(Req.BasicRequest));
     if (Result != -1) {
-      // Wait for success response with SCM_RIGHTS
-
-      FEXServerResultPacket Res{};
-      struct iovec iov {
-        .iov_base = &Res,
-        .iov_len = sizeof(Res),
-      };
-
-      struct msghdr msg {
-        .msg_name = nullptr,
-        .msg_namelen = 0,
-        .msg_iov = &iov,
-        .msg_iovlen = 1,
-      };
-
-      // Setup the ancillary buffer. This is where we will be getting pipe FDs
-      // We only need 4 bytes for the FD
-      constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int));
-      union AncillaryBuffer {
-        struct cmsghdr Header;
-        uint8_t Buffer[CMSG_SIZE];
-      };
-      AncillaryBuffer AncBuf{};
-
-      // Now link to our ancilllary buffer
-      msg.msg_control = AncBuf.Buffer;
-      msg.msg_controllen = CMSG_SIZE;
-
-      ssize_t DataResult = recvmsg(ServerSocket, &msg, 0);
-      if (DataResult > 0) {
-        // Now that we have the data, we can extract the FD from the ancillary buffer
-        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
-
-        // Do some error checking
-        if (cmsg == nullptr ||
-            cmsg->cmsg_len != CMSG_LEN(sizeof(int)) ||
-            cmsg->cmsg_level != SOL_SOCKET ||
-            cmsg->cmsg_type != SCM_RIGHTS) {
-          // Couldn't get a socket
-        }
-        else {
-          // Check for Success.
-          // If type error was returned then the FEXServer doesn't have a log to pipe in to
-          if (Res.Header.Type == PacketType::TYPE_SUCCESS) {
-            // Now that we know the cmsg is sane, read the FD
-            int NewFD{};
-            memcpy(&NewFD, CMSG_DATA(cmsg), sizeof(NewFD));
-            return NewFD;
-          }
-        }
-      }
+      return ReceiveFDPacket(ServerSocket);
+    }
+
+    return -1;
+  }
+
+  // Code cache requests can come from any thread, like the AOTIR writeout.
+  // The request and its reply need to stay paired on the socket.
+  static std::mutex CodeCacheRequestMutex;
+
+  static int RequestCodeCachePacket(int ServerSocket, PacketType Type, std::string_view Key) {
+    FEXServerRequestPacket Req {
+      .CodeCache {
+        .Header {
+          .Type = Type,
+        },
+        .KeyLength = Key.size(),
+      },
+    };
+
+    const iovec vec[2] = {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.CodeCache),
+      },
+      {
+        .iov_base = const_cast<char*>(Key.data()),
+        .iov_len = Key.size(),
+      },
+    };
+
+    std::lock_guard lk(CodeCacheRequestMutex);
+    int Result = writev(ServerSocket, vec, 2);
+    if (Result != -1) {
+      return ReceiveFDPacket(ServerSocket);
     }
 
     return -1;
@@ -333,6 +374,18 @@ namespace FEXServerClient {
     return RequestPIDFDPacket(ServerSocket, PacketType::TYPE_GET_PID_FD);
   }
 
+  int RequestCodeCacheFD(int ServerSocket, std::string_view Key) {
+    return RequestCodeCachePacket(ServerSocket, PacketType::TYPE_GET_CODE_CACHE_FD, Key);
+  }
+
+  int RequestCreateCodeCacheFD(int ServerSocket, std::string_view Key) {
+    return RequestCodeCachePacket(ServerSocket, PacketType::TYPE_CREATE_CODE_CACHE_FD, Key);
+  }
+
+  bool SealCodeCacheFD(int FD) {
+    return fcntl(FD, F_ADD_SEALS, F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE) == 0;
+  }
+
   /**  @} */
 
   /**
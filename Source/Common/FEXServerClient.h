@@ -4,6 +4,8 @@
 #include <FEXCore/fextl/string.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
+#include <string_view>
+
 namespace FEXServerClient {
   enum class PacketType {
     // Request and Result
@@ -11,6 +13,8 @@ namespace FEXServerClient {
     TYPE_GET_LOG_FD,
     TYPE_GET_ROOTFS_PATH,
     TYPE_GET_PID_FD,
+    TYPE_GET_CODE_CACHE_FD,
+    TYPE_CREATE_CODE_CACHE_FD,
 
     // Result only
     TYPE_SUCCESS,
@@ -25,6 +29,12 @@ namespace FEXServerClient {
     struct {
       struct Header Header;
     } BasicRequest;
+
+    struct {
+      struct Header Header;
+      size_t KeyLength;
+      char Key[0];
+    } CodeCache;
   };
 
   union FEXServerResultPacket {
@@ -103,6 +113,33 @@ namespace FEXServerClient {
    */
   int RequestPIDFD(int ServerSocket);
 
+  /**
+   * @brief Request a FEXServer to give us a sealed code cache memfd that another process published
+   *
+   * @param ServerSocket - Socket to the server
+   * @param Key - Code cache key, must encode everything the cached code depends on
+   *
+   * @return Read-only FD for the code cache or -1 if the server doesn't have one
+   */
+  int RequestCodeCacheFD(int ServerSocket, std::string_view Key);
+
+  /**
+   * @brief Request a FEXServer to create a new code cache memfd for us to fill
+   *
+   * The cache only becomes visible to other processes once it is sealed with `SealCodeCacheFD`.
+   *
+   * @param ServerSocket - Socket to the server
+   * @param Key - Code cache key, must encode everything the cached code depends on
+   *
+   * @return Writable memfd or -1 on error
+   */
+  int RequestCreateCodeCacheFD(int ServerSocket, std::string_view Key);
+
+  /**
+   * @brief Seals a code cache memfd against any future modification, publishing it to other processes
+   */
+  bool SealCodeCacheFD(int FD);
+
   /**  @} */
 
   /**
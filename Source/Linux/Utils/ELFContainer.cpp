@@ -333,6 +333,31 @@ ELFSymbol const *ELFContainer::GetSymbolInRange(RangeType Address) {
   return Sym->second;
 }
 
+bool ELFContainer::GetFileOffset(uint64_t Address, uint64_t *FileOffset) const {
+  for (auto &Header : ProgramHeaders) {
+    uint64_t Type, VAddr, Offset, FileSize;
+    if (Mode == MODE_32BIT) {
+      Type = Header._32->p_type;
+      VAddr = Header._32->p_vaddr;
+      Offset = Header._32->p_offset;
+      FileSize = Header._32->p_filesz;
+    }
+    else {
+      Type = Header._64->p_type;
+      VAddr = Header._64->p_vaddr;
+      Offset = Header._64->p_offset;
+      FileSize = Header._64->p_filesz;
+    }
+
+    if (Type == PT_LOAD && Address >= VAddr && Address < VAddr + FileSize) {
+      *FileOffset = Address - VAddr + Offset;
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void ELFContainer::CalculateMemoryLayouts() {
   uint64_t MinPhysAddr = ~0ULL;
   uint64_t MaxPhysAddr = 0;
@@ -72,6 +72,9 @@ public:
   using RangeType = std::pair<uint64_t, uint64_t>;
   ELFSymbol const *GetSymbolInRange(RangeType Address);
 
+  // Translates a virtual address to where it lives in the file, through the loadable segments
+  bool GetFileOffset(uint64_t Address, uint64_t *FileOffset) const;
+
   bool WasDynamic() const { return DynamicProgram; }
   bool HasDynamicLinker() const { return !DynamicLinker.empty(); }
   bool WasLoaded() const { return Loaded; }
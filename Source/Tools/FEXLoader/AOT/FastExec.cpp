@@ -0,0 +1,213 @@
+#include "AOT/FastExec.h"
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/set.h>
+#include <FEXHeaderUtils/Filesystem.h>
+
+#include <algorithm>
+#include <fcntl.h>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <xxhash.h>
+
+namespace FEX::AOT {
+namespace {
+  constexpr std::string_view PROFILE_HEADER = "FEXFastExec 1";
+
+  // Environment variables that change which libraries the guest's dynamic linker loads
+  bool AffectsDynamicLinking(std::string_view Env) {
+    return Env.starts_with("LD_") || Env.starts_with("GLIBC_TUNABLES=");
+  }
+
+  // Identifies the program file and the environment it is started in.
+  // The caches themselves are keyed on library contents, so this only has to pick the profile.
+  bool GetFingerprint(const fextl::string &ProgramPath, const fextl::string &RootFS, char **const envp, uint64_t *Fingerprint) {
+    struct stat Buffer{};
+    if (stat(ProgramPath.c_str(), &Buffer) == -1 || !S_ISREG(Buffer.st_mode)) {
+      return false;
+    }
+
+    const uint64_t FileKey[] = {
+      static_cast<uint64_t>(Buffer.st_dev),
+      static_cast<uint64_t>(Buffer.st_ino),
+      static_cast<uint64_t>(Buffer.st_size),
+      static_cast<uint64_t>(Buffer.st_mtim.tv_sec) * 1'000'000'000ULL + Buffer.st_mtim.tv_nsec,
+    };
+
+    auto State = XXH3_createState();
+    XXH3_64bits_reset(State);
+    XXH3_64bits_update(State, FileKey, sizeof(FileKey));
+    XXH3_64bits_update(State, ProgramPath.c_str(), ProgramPath.size() + 1);
+    XXH3_64bits_update(State, RootFS.c_str(), RootFS.size() + 1);
+
+    // Sorted so the fingerprint doesn't depend on the order of the environment
+    fextl::set<std::string_view> Environment;
+    for (char **Env = envp; Env && *Env; ++Env) {
+      if (AffectsDynamicLinking(*Env)) {
+        Environment.emplace(*Env);
+      }
+    }
+
+    for (auto Env : Environment) {
+      XXH3_64bits_update(State, Env.data(), Env.size() + 1);
+    }
+
+    *Fingerprint = XXH3_64bits_digest(State);
+    XXH3_freeState(State);
+    return true;
+  }
+
+  bool LoadProfile(const fextl::string &ProfilePath, fextl::vector<fextl::string> *FileIds) {
+    fextl::string Data;
+    if (!FEXCore::FileLoading::LoadFile(Data, ProfilePath)) {
+      return false;
+    }
+
+    std::string_view View {Data};
+    auto NextLine = [&View]() {
+      const auto End = View.find('\n');
+      const auto Line = View.substr(0, End);
+      View = End == std::string_view::npos ? std::string_view{} : View.substr(End + 1);
+      return Line;
+    };
+
+    if (NextLine() != PROFILE_HEADER) {
+      return false;
+    }
+
+    while (!View.empty()) {
+      const auto Line = NextLine();
+      if (!Line.empty()) {
+        FileIds->emplace_back(Line);
+      }
+    }
+
+    return !FileIds->empty();
+  }
+
+  // Returns the locked FD, or -1 if another process is already capturing this profile
+  int TryLockCapture(const fextl::string &CaptureLockPath) {
+    int FD = open(CaptureLockPath.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+    if (FD == -1) {
+      return -1;
+    }
+
+    // Not flock, that lock belongs to the open file and a forked child that outlives the capture would keep holding it
+    struct flock Lock {
+      .l_type = F_WRLCK,
+      .l_whence = SEEK_SET,
+      .l_start = 0,
+      .l_len = 0,
+    };
+
+    if (fcntl(FD, F_SETLK, &Lock) == -1) {
+      close(FD);
+      return -1;
+    }
+
+    return FD;
+  }
+}
+
+FastExecProfile SetupFastExec(const fextl::string &ProgramPath, const fextl::string &RootFS, char **const envp) {
+  FastExecProfile Profile{};
+
+  uint64_t Fingerprint;
+  if (!GetFingerprint(ProgramPath, RootFS, envp, &Fingerprint)) {
+    return Profile;
+  }
+
+  const auto ProfileDirectory = fextl::fmt::format("{}/fastexec", FEXCore::Config::GetDataDirectory());
+  Profile.ProfilePath = fextl::fmt::format("{}/{:016x}.profile", ProfileDirectory, Fingerprint);
+
+  Profile.OwnerPID = getpid();
+
+  if (LoadProfile(Profile.ProfilePath, &Profile.FileIds)) {
+    LogMan::Msg::IFmt("FastExec: Loading {}", Profile.ProfilePath);
+    Profile.Mode = FastExecProfile::ModeType::LOAD;
+    return Profile;
+  }
+
+  if (FHU::Filesystem::CreateDirectories(ProfileDirectory) &&
+      FHU::Filesystem::CreateDirectories(fextl::fmt::format("{}/aotir", FEXCore::Config::GetDataDirectory()))) {
+    // The lock file is never removed, so every process locks the same file
+    Profile.CaptureLockFD = TryLockCapture(fextl::fmt::format("{}/{:016x}.capture", ProfileDirectory, Fingerprint));
+    if (Profile.CaptureLockFD != -1) {
+      LogMan::Msg::IFmt("FastExec: Capturing {}", Profile.ProfilePath);
+      Profile.Mode = FastExecProfile::ModeType::CAPTURE;
+    }
+  }
+
+  return Profile;
+}
+
+void PrefetchFastExecCaches(const FastExecProfile &Profile) {
+  for (const auto &FileId : Profile.FileIds) {
+    const auto Filepath = fextl::fmt::format("{}/aotir/{}.aotir", FEXCore::Config::GetDataDirectory(), FileId);
+    int FD = open(Filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD != -1) {
+      // Asynchronous readahead, the caches are mapped once the guest maps the matching libraries
+      posix_fadvise(FD, 0, 0, POSIX_FADV_WILLNEED);
+      close(FD);
+    }
+  }
+}
+
+void FinishFastExec(FEXCore::Context::Context *CTX, const FastExecProfile &Profile) {
+  if (Profile.Mode == FastExecProfile::ModeType::DISABLED || getpid() != Profile.OwnerPID) {
+    return;
+  }
+
+  fextl::set<fextl::string> UsedFileIds;
+  CTX->WriteFilesWithCode([&UsedFileIds](const fextl::string& fileid, const fextl::string& filename) {
+    UsedFileIds.emplace(fileid);
+  });
+
+  if (Profile.Mode == FastExecProfile::ModeType::LOAD) {
+    // A library was updated or the program took a different path, capture again on the next run
+    const bool Covered = std::all_of(UsedFileIds.begin(), UsedFileIds.end(), [&Profile](const fextl::string &FileId) {
+      return std::find(Profile.FileIds.begin(), Profile.FileIds.end(), FileId) != Profile.FileIds.end();
+    });
+
+    if (!Covered) {
+      LogMan::Msg::IFmt("FastExec: Profile is out of date, recapturing on the next run");
+      unlink(Profile.ProfilePath.c_str());
+    }
+    return;
+  }
+
+  fextl::string Data {PROFILE_HEADER};
+  Data += '\n';
+  for (const auto &FileId : UsedFileIds) {
+    Data += FileId;
+    Data += '\n';
+  }
+
+  // Written to a temporary file first so concurrent runs never see a partial profile
+  const auto TmpFilepath = fextl::fmt::format("{}.{}.tmp", Profile.ProfilePath, getpid());
+  int FD = open(TmpFilepath.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+  if (FD != -1) {
+    const bool Written = write(FD, Data.data(), Data.size()) == static_cast<ssize_t>(Data.size());
+    close(FD);
+
+    if (!Written || UsedFileIds.empty() || FHU::Filesystem::RenameFile(TmpFilepath, Profile.ProfilePath)) {
+      unlink(TmpFilepath.c_str());
+    }
+  }
+
+  close(Profile.CaptureLockFD);
+}
+
+void AbandonCaptureAfterFork(FastExecProfile &Profile) {
+  // The lock itself stayed with the parent, only the fd was inherited
+  if (Profile.CaptureLockFD != -1) {
+    close(Profile.CaptureLockFD);
+    Profile.CaptureLockFD = -1;
+  }
+}
+}
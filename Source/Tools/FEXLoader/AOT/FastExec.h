@@ -0,0 +1,42 @@
+#pragma once
+
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <sys/types.h>
+
+namespace FEXCore::Context {
+  class Context;
+}
+
+namespace FEX::AOT {
+  // Per program and environment record of the AOTIR caches a run used.
+  // The first run captures the caches, later runs load them.
+  struct FastExecProfile {
+    enum class ModeType {
+      DISABLED,
+      LOAD,
+      CAPTURE,
+    };
+
+    ModeType Mode {ModeType::DISABLED};
+    fextl::string ProfilePath;
+    // Holds an exclusive record lock for the whole capture, released by the kernel if the process dies or execs.
+    // Record locks belong to the process, so a forked child never holds it.
+    int CaptureLockFD {-1};
+    // Only the process that was started with the profile finishes it, forked children don't
+    pid_t OwnerPID {};
+    fextl::vector<fextl::string> FileIds;
+  };
+
+  FastExecProfile SetupFastExec(const fextl::string &ProgramPath, const fextl::string &RootFS, char **const envp);
+
+  // Starts reading the profile's caches in to the page cache before the guest maps its libraries
+  void PrefetchFastExecCaches(const FastExecProfile &Profile);
+
+  // Writes the profile after a capture, or drops it when a loading run found libraries it doesn't cover
+  void FinishFastExec(FEXCore::Context::Context *CTX, const FastExecProfile &Profile);
+
+  // Called in a forked child, which leaves finishing the capture to its parent
+  void AbandonCaptureAfterFork(FastExecProfile &Profile);
+}
@@ -6,6 +6,7 @@ $end_info$
 */
 
 #include "AOT/AOTGenerator.h"
+#include "AOT/FastExec.h"
 #include "Common/ArgumentLoader.h"
 #include "Common/FEXServerClient.h"
 #include "Common/Config.h"
@@ -127,7 +128,8 @@ namespace FEXServerLogging {
 namespace AOTIR {
   class AOTIRWriterFD final : public FEXCore::Context::AOTIRWriter {
     public:
-      AOTIRWriterFD(const fextl::string &Path) {
+      AOTIRWriterFD(const fextl::string &Path, int SharedFD = -1)
+        : SharedFD {SharedFD} {
         // Create and truncate if exists.
         constexpr int USER_PERMS = S_IRWXU | S_IRWXG | S_IRWXO;
         FD = open(Path.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, USER_PERMS);
@@ -139,6 +141,9 @@ namespace AOTIR {
 
       void Write(const void* Data, size_t Size) override {
         write(FD, Data, Size);
+        if (SharedFD != -1) {
+          write(SharedFD, Data, Size);
+        }
       }
 
       size_t Offset() override {
@@ -150,6 +155,13 @@ namespace AOTIR {
           close(FD);
           FD = -1;
         }
+
+        if (SharedFD != -1) {
+          // Sealing publishes the cache to other processes through the FEXServer.
+          FEXServerClient::SealCodeCacheFD(SharedFD);
+          close(SharedFD);
+          SharedFD = -1;
+        }
       }
 
       virtual ~AOTIRWriterFD() {
@@ -157,6 +169,8 @@ namespace AOTIR {
       }
     private:
       int FD{-1};
+      // FEXServer owned memfd that mirrors the on-disk cache
+      int SharedFD{-1};
   };
 }
 
@@ -328,6 +342,7 @@ int main(int argc, char **argv, char **const envp) {
   FEX_CONFIG_OPT(AOTIRCapture, AOTIRCAPTURE);
   FEX_CONFIG_OPT(AOTIRGenerate, AOTIRGENERATE);
   FEX_CONFIG_OPT(AOTIRLoad, AOTIRLOAD);
+  FEX_CONFIG_OPT(FastExec, FASTEXEC);
   FEX_CONFIG_OPT(OutputLog, OUTPUTLOG);
   FEX_CONFIG_OPT(LDPath, ROOTFS);
   FEX_CONFIG_OPT(Environment, ENV);
@@ -432,6 +447,24 @@ int main(int argc, char **argv, char **const envp) {
     FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_APP_CONFIG_NAME, Program.ProgramName);
   }
 
+  // FastExec picks between capturing and loading per program, explicit AOTIR options take priority.
+  // Anonymous programs have no path to key the profile on.
+  FEX::AOT::FastExecProfile FastExecProfile{};
+  if (FastExec() && !AOTIRLoad() && !AOTIRCapture() && !AOTIRGenerate() && !FEXFD) {
+    FastExecProfile = FEX::AOT::SetupFastExec(Program.ProgramPath, LDPath(), envp);
+  }
+
+  // The context reads these when it is created
+  const bool LoadAOTIR = AOTIRLoad() || FastExecProfile.Mode == FEX::AOT::FastExecProfile::ModeType::LOAD;
+  const bool CaptureAOTIR = AOTIRCapture() || FastExecProfile.Mode == FEX::AOT::FastExecProfile::ModeType::CAPTURE;
+  if (LoadAOTIR && !AOTIRLoad()) {
+    FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_AOTIRLOAD, "1");
+    FEX::AOT::PrefetchFastExecCaches(FastExecProfile);
+  }
+  if (CaptureAOTIR && !AOTIRCapture()) {
+    FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_AOTIRCAPTURE, "1");
+  }
+
   // Setup Thread handlers, so FEXCore can create threads.
   FEX::LinuxEmulation::Threads::SetupThreadHandlers();
 
@@ -491,6 +524,11 @@ int main(int argc, char **argv, char **const envp) {
   }
 
   SyscallHandler->SetCodeLoader(&Loader);
+  if (FastExecProfile.Mode == FEX::AOT::FastExecProfile::ModeType::CAPTURE) {
+    SyscallHandler->SetForkChildHandler([&FastExecProfile]() {
+      FEX::AOT::AbandonCaptureAfterFork(FastExecProfile);
+    });
+  }
 
   auto BRKInfo = Loader.GetBRKInfo();
 
@@ -516,19 +554,29 @@ int main(int argc, char **argv, char **const envp) {
     });
   }
 
-  const bool AOTEnabled = AOTIRLoad() || AOTIRCapture() || AOTIRGenerate();
+  const bool AOTEnabled = LoadAOTIR || CaptureAOTIR || AOTIRGenerate();
   if (AOTEnabled) {
     LogMan::Msg::IFmt("Warning: AOTIR is experimental, and might lead to crashes. "
-                      "Capture doesn't work with programs that fork.");
+                      "Capture only records the original process of programs that fork.");
 
+    // The FEXServer brokers caches between concurrently running processes, like a shell pipeline or a `make -j` fan-out.
+    // Loads get their own file description, so they always read the cache from the start.
     CTX->SetAOTIRLoader([](const fextl::string &fileid) -> int {
       const auto filepath = fextl::fmt::format("{}/aotir/{}.aotir", FEXCore::Config::GetDataDirectory(), fileid);
-      return open(filepath.c_str(), O_RDONLY);
+      int FD = open(filepath.c_str(), O_RDONLY);
+      if (FD == -1 && FEXServerClient::GetServerFD() != -1) {
+        FD = FEXServerClient::RequestCodeCacheFD(FEXServerClient::GetServerFD(), fileid);
+      }
+      return FD;
     });
 
     CTX->SetAOTIRWriter([](const fextl::string& fileid) -> fextl::unique_ptr<AOTIR::AOTIRWriterFD> {
       const auto filepath = fextl::fmt::format("{}/aotir/{}.aotir.tmp", FEXCore::Config::GetDataDirectory(), fileid);
-      auto AOTWrite = fextl::make_unique<AOTIR::AOTIRWriterFD>(filepath);
+      int SharedFD = -1;
+      if (FEXServerClient::GetServerFD() != -1) {
+        SharedFD = FEXServerClient::RequestCreateCodeCacheFD(FEXServerClient::GetServerFD(), fileid);
+      }
+      auto AOTWrite = fextl::make_unique<AOTIR::AOTIRWriterFD>(filepath, SharedFD);
       if (*AOTWrite) {
         LogMan::Msg::IFmt("AOTIR: Storing {}", fileid);
       } else {
@@ -554,6 +602,7 @@ int main(int argc, char **argv, char **const envp) {
     }
   } else {
     CTX->RunUntilExit();
+    CTX->WriteJITModuleStats();
   }
 
   if (AOTEnabled) {
@@ -568,10 +617,12 @@ int main(int argc, char **argv, char **const envp) {
       });
     }
 
-    if (AOTIRCapture() || AOTIRGenerate()) {
+    if (CaptureAOTIR || AOTIRGenerate()) {
       CTX->FinalizeAOTIRCache();
       LogMan::Msg::IFmt("AOTIR Cache Stored");
     }
+
+    FEX::AOT::FinishFastExec(CTX.get(), FastExecProfile);
   }
 
   auto ProgramStatus = CTX->GetProgramStatus();
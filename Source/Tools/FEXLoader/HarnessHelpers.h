@@ -135,11 +135,7 @@ namespace FEX::HarnessHelper {
     MatchMask >>= 1;
 
     auto CompactRFlags = [](auto Arg) -> uint32_t {
-      uint32_t Res = 2;
-      for (int i = 0; i < 32; ++i) {
-        Res |= Arg->flags[i] << i;
-      }
-      return Res;
+      return Arg->GetEFLAGS();
     };
 
     // FLAGS
@@ -6,12 +6,14 @@ $end_info$
 */
 
 #include "Common/Config.h"
+#include "Common/ConfigSnapshot.h"
 #include "Common/FDUtils.h"
 
 #include "FEXCore/Config/Config.h"
 #include "LinuxSyscalls/FileManagement.h"
 #include "LinuxSyscalls/EmulatedFiles/EmulatedFiles.h"
 #include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/x32/IOUring.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 
 #include <FEXCore/Utils/LogManager.h>
@@ -29,36 +31,18 @@ $end_info$
 #include <fcntl.h>
 #include <filesystem>
 #include <optional>
+#include <poll.h>
+#include <shared_mutex>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
+#include <sys/statvfs.h>
 #include <sys/xattr.h>
 #include <syscall.h>
 #include <system_error>
 #include <unistd.h>
 #include <utility>
 
-#include <tiny-json.h>
-
-namespace JSON {
-  struct JsonAllocator {
-    jsonPool_t PoolObject;
-    fextl::unique_ptr<fextl::list<json_t>> json_objects;
-  };
-  static_assert(offsetof(JsonAllocator, PoolObject) == 0, "This needs to be at offset zero");
-
-  json_t* PoolInit(jsonPool_t* Pool) {
-    JsonAllocator* alloc = reinterpret_cast<JsonAllocator*>(Pool);
-    alloc->json_objects = fextl::make_unique<fextl::list<json_t>>();
-    return &*alloc->json_objects->emplace(alloc->json_objects->end());
-  }
-
-  json_t* PoolAlloc(jsonPool_t* Pool) {
-    JsonAllocator* alloc = reinterpret_cast<JsonAllocator*>(Pool);
-    return &*alloc->json_objects->emplace(alloc->json_objects->end());
-  }
-}
-
 namespace FEX::HLE {
 bool FileManager::RootFSPathExists(const char* Filepath) {
   LOGMAN_THROW_A_FMT(Filepath && Filepath[0] == '/', "Filepath needs to be absolute");
@@ -67,10 +51,8 @@ bool FileManager::RootFSPathExists(const char* Filepath) {
 
 void FileManager::LoadThunkDatabase(fextl::unordered_map<fextl::string, ThunkDBObject>& ThunkDB, bool Global) {
   auto ThunkDBPath = FEXCore::Config::GetConfigDirectory(Global) + "ThunksDB.json";
-  fextl::vector<char> FileData;
-  if (FEXCore::FileLoading::LoadFile(FileData, ThunkDBPath)) {
-    FileData.push_back(0);
-
+  FEX::Config::Snapshot::ParsedFile File;
+  if (FEX::Config::Snapshot::LoadFile(ThunkDBPath, &File)) {
     // If the thunksDB file exists then we need to check if the rootfs supports multi-arch or not.
     const bool RootFSIsMultiarch = RootFSPathExists("/usr/lib/x86_64-linux-gnu/") ||
       RootFSPathExists("/usr/lib/i386-linux-gnu/");
@@ -116,90 +98,70 @@ void FileManager::LoadThunkDatabase(fextl::unordered_map<fextl::string, ThunkDBO
       }
     }
 
-    JSON::JsonAllocator Pool {
-      .PoolObject = {
-        .init = JSON::PoolInit,
-        .alloc = JSON::PoolAlloc,
-      },
-    };
+    std::string_view HomeDirectory = FEX::Config::GetHomeDirectory();
 
-    json_t const *json = json_createWithPool(&FileData.at(0), &Pool.PoolObject);
+    // Arrays are flattened in to one entry per element
+    std::string_view LastLibrary{};
+    fextl::unordered_map<fextl::string, ThunkDBObject>::iterator DBObject{};
+    for (const auto &Item : File.Entries) {
+      if (Item.Depth < 2 || !Item.Matches("DB")) {
+        continue;
+      }
 
-    json_t const* DB = json_getProperty( json, "DB" );
-    if ( !DB || JSON_OBJ != json_getType( DB ) ) {
-      return;
-    }
+      // Get the user defined name for the library, a library declared with an empty object still gets an entry
+      if (Item.Keys[1] != LastLibrary) {
+        LastLibrary = Item.Keys[1];
+        DBObject = ThunkDB.insert_or_assign(fextl::string(LastLibrary), ThunkDBObject{}).first;
+      }
 
-    std::string_view HomeDirectory = FEX::Config::GetHomeDirectory();
+      if (Item.Depth != 3 || Item.EmptyContainer) {
+        continue;
+      }
 
-    for( json_t const* Library = json_getChild( DB ); Library != nullptr; Library = json_getSibling( Library )) {
-      // Get the user defined name for the library
-      const char* LibraryName = json_getName(Library);
-      auto DBObject = ThunkDB.insert_or_assign(LibraryName, ThunkDBObject{}).first;
+      std::string_view ItemName = Item.Keys[2];
 
-      // Walk the libraries items to get the data
-      for (json_t const* LibraryItem = json_getChild(Library); LibraryItem != nullptr; LibraryItem = json_getSibling(LibraryItem)) {
-        std::string_view ItemName = json_getName(LibraryItem);
+      if (ItemName == "Library") {
+        // "Library": "libGL-guest.so"
+        DBObject->second.LibraryName = Item.Value;
+      }
+      else if (ItemName == "Depends") {
+        DBObject->second.Depends.insert(fextl::string(Item.Value));
+      }
+      else if (ItemName == "Overlay") {
+        auto AddWithReplacement = [HomeDirectory, &PathPrefixes](ThunkDBObject& DBObject, fextl::string LibraryItem) {
+          // Walk through template string and fill in prefixes from right to left
 
-        if (ItemName == "Library") {
-          // "Library": "libGL-guest.so"
-          DBObject->second.LibraryName = json_getValue(LibraryItem);
-        }
-        else if (ItemName == "Depends") {
-          jsonType_t PropertyType = json_getType(LibraryItem);
-          if (PropertyType == JSON_TEXT) {
-            DBObject->second.Depends.insert(json_getValue(LibraryItem));
-          }
-          else if (PropertyType == JSON_ARRAY) {
-            for (json_t const* Depend = json_getChild(LibraryItem); Depend != nullptr; Depend = json_getSibling(Depend)) {
-              DBObject->second.Depends.insert(json_getValue(Depend));
-            }
-          }
-        }
-        else if (ItemName == "Overlay") {
-          auto AddWithReplacement = [HomeDirectory, &PathPrefixes](ThunkDBObject& DBObject, fextl::string LibraryItem) {
-            // Walk through template string and fill in prefixes from right to left
-
-            using namespace std::string_view_literals;
-            const std::pair PrefixHome { "@HOME@"sv, LibraryItem.find("@HOME@") };
-            const std::pair PrefixLib { "@PREFIX_LIB@"sv, LibraryItem.find("@PREFIX_LIB@") };
-
-            fextl::string::size_type PrefixPositions[] = {
-              PrefixHome.second, PrefixLib.second,
-            };
-            // Sort offsets in descending order to enable safe in-place replacement
-            std::sort(std::begin(PrefixPositions), std::end(PrefixPositions), std::greater<>{});
-
-            for (auto& LibPrefix : PathPrefixes) {
-              fextl::string Replacement = LibraryItem;
-              for (auto PrefixPos : PrefixPositions) {
-                if (PrefixPos == fextl::string::npos) {
-                  continue;
-                } else if (PrefixPos == PrefixHome.second) {
-                  Replacement.replace(PrefixPos, PrefixHome.first.size(), HomeDirectory);
-                } else if (PrefixPos == PrefixLib.second) {
-                  Replacement.replace(PrefixPos, PrefixLib.first.size(), LibPrefix);
-                }
-              }
-              DBObject.Overlays.emplace_back(std::move(Replacement));
+          using namespace std::string_view_literals;
+          const std::pair PrefixHome { "@HOME@"sv, LibraryItem.find("@HOME@") };
+          const std::pair PrefixLib { "@PREFIX_LIB@"sv, LibraryItem.find("@PREFIX_LIB@") };
 
-              if (PrefixLib.second == fextl::string::npos) {
-                // Don't repeat for other LibPrefixes entries if the prefix wasn't used
-                break;
+          fextl::string::size_type PrefixPositions[] = {
+            PrefixHome.second, PrefixLib.second,
+          };
+          // Sort offsets in descending order to enable safe in-place replacement
+          std::sort(std::begin(PrefixPositions), std::end(PrefixPositions), std::greater<>{});
+
+          for (auto& LibPrefix : PathPrefixes) {
+            fextl::string Replacement = LibraryItem;
+            for (auto PrefixPos : PrefixPositions) {
+              if (PrefixPos == fextl::string::npos) {
+                continue;
+              } else if (PrefixPos == PrefixHome.second) {
+                Replacement.replace(PrefixPos, PrefixHome.first.size(), HomeDirectory);
+              } else if (PrefixPos == PrefixLib.second) {
+                Replacement.replace(PrefixPos, PrefixLib.first.size(), LibPrefix);
               }
             }
-          };
+            DBObject.Overlays.emplace_back(std::move(Replacement));
 
-          jsonType_t PropertyType = json_getType(LibraryItem);
-          if (PropertyType == JSON_TEXT) {
-            AddWithReplacement(DBObject->second, json_getValue(LibraryItem));
-          }
-          else if (PropertyType == JSON_ARRAY) {
-            for (json_t const* Overlay = json_getChild(LibraryItem); Overlay != nullptr; Overlay = json_getSibling(Overlay)) {
-              AddWithReplacement(DBObject->second, json_getValue(Overlay));
+            if (PrefixLib.second == fextl::string::npos) {
+              // Don't repeat for other LibPrefixes entries if the prefix wasn't used
+              break;
             }
           }
-        }
+        };
+
+        AddWithReplacement(DBObject->second, fextl::string(Item.Value));
       }
     }
   }
@@ -248,6 +210,14 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
     if (RootFSFD == -1) {
       RootFSFD = AT_FDCWD;
     }
+    else {
+      // A read-only rootfs (SquashFS/EroFS image mounts) can't change underneath us, so lookups are safe to cache.
+      struct statvfs Buffer{};
+      RootFSPathCacheEnabled = fstatvfs(RootFSFD, &Buffer) == 0 && (Buffer.f_flag & ST_RDONLY);
+      if (RootFSPathCacheEnabled) {
+        OpenMountInfo();
+      }
+    }
   }
 
   fextl::unordered_map<fextl::string, ThunkDBObject> ThunkDB;
@@ -255,25 +225,16 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
   LoadThunkDatabase(ThunkDB, false);
 
   for (const auto &Path : ConfigPaths) {
-    fextl::vector<char> FileData;
-    if (FEXCore::FileLoading::LoadFile(FileData, Path)) {
-      JSON::JsonAllocator Pool {
-        .PoolObject = {
-          .init = JSON::PoolInit,
-          .alloc = JSON::PoolAlloc,
-        },
-      };
-
+    FEX::Config::Snapshot::ParsedFile File;
+    if (FEX::Config::Snapshot::LoadFile(Path, &File)) {
       // If a thunks DB property exists then we pull in data from the thunks database
-      json_t const *json = json_createWithPool(&FileData.at(0), &Pool.PoolObject);
-      json_t const* ThunksDB = json_getProperty( json, "ThunksDB" );
-      if (!ThunksDB) {
-        continue;
-      }
+      for (const auto &Item : File.Entries) {
+        if (Item.Depth != 2 || !Item.Matches("ThunksDB")) {
+          continue;
+        }
 
-      for (json_t const* Item = json_getChild(ThunksDB); Item != nullptr; Item = json_getSibling(Item)) {
-        const char *LibraryName = json_getName(Item);
-        bool LibraryEnabled = json_getInteger(Item) != 0;
+        const auto LibraryName = fextl::string(Item.Keys[1]);
+        bool LibraryEnabled = strtoll(Item.Value.data(), nullptr, 10) != 0;
         // If the library is enabled then find it in the DB
         auto DBObject = ThunkDB.find(LibraryName);
         if (DBObject != ThunkDB.end()) {
@@ -349,6 +310,9 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
 
 FileManager::~FileManager() {
   close(RootFSFD);
+  if (MountInfoFD != -1) {
+    close(MountInfoFD);
+  }
 }
 
 fextl::string FileManager::GetEmulatedPath(const char *pathname, bool FollowSymlink) {
@@ -405,6 +369,11 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
     return NoEntry;
   }
 
+  std::pair<int, const char*> CachedResult;
+  if (FollowSymlink && LookupRootFSPathCache(pathname, &CachedResult, TmpFilename)) {
+    return CachedResult;
+  }
+
   // Starting subpath is the pathname passed in.
   const char *SubPath = pathname;
 
@@ -428,6 +397,7 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
       int Result = fstatat(RootFSFD, &SubPath[1], &Buffer, AT_SYMLINK_NOFOLLOW);
       if (Result != 0 && errno == ENOENT && !HadAtLeastOne) {
         // Initial file didn't exist at all
+        InsertRootFSPathCache(pathname, NoEntry);
         return NoEntry;
       }
 
@@ -466,7 +436,145 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
   }
 
   // Return the pair of rootfs FD plus relative subpath by stripping off the front '/'
-  return std::make_pair(RootFSFD, &SubPath[1]);
+  const auto Result = std::make_pair(RootFSFD, &SubPath[1]);
+  if (FollowSymlink) {
+    InsertRootFSPathCache(pathname, Result);
+  }
+  return Result;
+}
+
+bool FileManager::LookupRootFSPathCache(const char *pathname, std::pair<int, const char*> *Result, FDPathTmpData &TmpFilename) {
+  if (!RootFSPathCacheEnabled) {
+    return false;
+  }
+
+  if (RootFSPathCacheStale.load() || RootFSMountsChanged()) {
+    return false;
+  }
+
+  std::shared_lock lk(RootFSPathCacheMutex, std::try_to_lock);
+  if (!lk.owns_lock()) {
+    return false;
+  }
+
+  auto Entry = RootFSPathCache.find(pathname);
+  if (Entry == RootFSPathCache.end()) {
+    return false;
+  }
+
+  if (!Entry->second.Exists) {
+    *Result = std::make_pair(-1, nullptr);
+    return true;
+  }
+
+  // Copy out of the cache, the entry may be evicted once the lock is dropped.
+  const auto &SubPath = Entry->second.SubPath;
+  if (SubPath.size() >= PATH_MAX) {
+    return false;
+  }
+
+  memcpy(TmpFilename[0], SubPath.c_str(), SubPath.size() + 1);
+  *Result = std::make_pair(RootFSFD, TmpFilename[0]);
+  return true;
+}
+
+void FileManager::InsertRootFSPathCache(const char *pathname, std::pair<int, const char*> Result) {
+  if (!RootFSPathCacheEnabled) {
+    return;
+  }
+
+  std::unique_lock lk(RootFSPathCacheMutex, std::try_to_lock);
+  if (!lk.owns_lock()) {
+    return;
+  }
+
+  if (RootFSPathCacheStale.exchange(false)) {
+    RootFSPathCache.clear();
+
+    // A remount can make the rootfs writable, which nothing would notice changing
+    struct statvfs Buffer{};
+    if (fstatvfs(RootFSFD, &Buffer) != 0 || !(Buffer.f_flag & ST_RDONLY)) {
+      RootFSPathCacheEnabled = false;
+    }
+
+    // This result may have been resolved against the old mounts
+    return;
+  }
+
+  if (RootFSPathCache.size() >= MaxRootFSPathCacheEntries) {
+    RootFSPathCache.clear();
+  }
+
+  RootFSPathCache.insert_or_assign(pathname, RootFSPathCacheEntry {
+    .Exists = Result.first != -1,
+    .SubPath = Result.second ? Result.second : "",
+  });
+}
+
+bool FileManager::RootFSMountsChanged() {
+  // poll consumes the event, so whoever sees it has to leave the cache marked stale for the next insert to clear
+  struct pollfd PollFD {
+    .fd = MountInfoFD,
+    .events = POLLPRI,
+    .revents = 0,
+  };
+
+  if (poll(&PollFD, 1, 0) == 0) {
+    return false;
+  }
+
+  if (PollFD.revents & POLLNVAL) {
+    // The guest closed the fd, changes can't be seen anymore
+    RootFSPathCacheEnabled = false;
+  }
+
+  RootFSPathCacheStale = true;
+  return true;
+}
+
+void FileManager::OpenMountInfo() {
+  int FD = open("/proc/self/mountinfo", O_RDONLY | O_CLOEXEC);
+  if (FD == -1) {
+    RootFSPathCacheEnabled = false;
+    return;
+  }
+
+  if (MountInfoFD == -1) {
+    MountInfoFD = FD;
+    return;
+  }
+
+  // Replaced in place, other threads may be polling the old one
+  dup3(FD, MountInfoFD, O_CLOEXEC);
+  close(FD);
+}
+
+void FileManager::MountNamespaceChanged() {
+  if (!RootFSPathCacheEnabled) {
+    return;
+  }
+
+  // The old fd keeps watching the namespace it was opened in
+  OpenMountInfo();
+  RootFSPathCacheStale = true;
+}
+
+void FileManager::LockBeforeFork() {
+  RootFSPathCacheMutex.lock();
+}
+
+void FileManager::UnlockAfterFork(bool Child) {
+  if (Child) {
+    RootFSPathCacheMutex.StealAndDropActiveLocks();
+
+    // The open file shares its event state with the parent, whichever polls first would hide a change from the other
+    if (RootFSPathCacheEnabled) {
+      OpenMountInfo();
+    }
+  }
+  else {
+    RootFSPathCacheMutex.unlock();
+  }
 }
 
 std::optional<fextl::string> FileManager::GetSelf(const char *Pathname) {
@@ -529,6 +637,8 @@ uint64_t FileManager::Open(const char *pathname, int flags, uint32_t mode) {
 }
 
 uint64_t FileManager::Close(int fd) {
+  // Forgotten first, a ring set up by another thread can get the fd number as soon as it is closed
+  FEX::HLE::x32::IOUring::TrackClose(fd);
   return ::close(fd);
 }
 
@@ -536,6 +646,9 @@ uint64_t FileManager::CloseRange(unsigned int first, unsigned int last, unsigned
 #ifndef CLOSE_RANGE_CLOEXEC
 #define CLOSE_RANGE_CLOEXEC (1U << 2)
 #endif
+  if (!(flags & CLOSE_RANGE_CLOEXEC)) {
+    FEX::HLE::x32::IOUring::TrackCloseRange(first, last);
+  }
   return ::syscall(SYSCALL_DEF(close_range), first, last, flags);
 }
 
@@ -6,10 +6,13 @@ $end_info$
 
 #pragma once
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/DeferredSignalMutex.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
 #include <FEXCore/fextl/unordered_set.h>
 
+#include <atomic>
 #include <cstdint>
 #include <fcntl.h>
 #include <functional>
@@ -85,9 +88,41 @@ public:
   using FDPathTmpData = std::array<char[PATH_MAX], 2>;
   std::pair<int, const char*> GetEmulatedFDPath(int dirfd, const char *pathname, bool FollowSymlink, FDPathTmpData &TmpFilename);
 
+  ///// FORK tracking /////
+  void LockBeforeFork();
+  void UnlockAfterFork(bool Child);
+
+  // The thread moved to another mount namespace, cached rootfs lookups may no longer hold.
+  void MountNamespaceChanged();
+
 private:
   bool RootFSPathExists(const char* Filepath);
 
+  // Caches symlink-following rootfs lookups from GetEmulatedFDPath, keyed by guest path.
+  // Only enabled when the rootfs is mounted read-only, so the only way entries go stale is something being mounted
+  // or unmounted inside it. Any change to the mount table marks the whole cache stale, see RootFSMountsChanged.
+  // All accesses use try_lock so a signal handler reentering the FileManager can't deadlock; contention is just a miss.
+  struct RootFSPathCacheEntry {
+    // false if the path doesn't exist in the rootfs
+    bool Exists;
+    // Resolved path relative to RootFSFD
+    fextl::string SubPath;
+  };
+  bool LookupRootFSPathCache(const char *pathname, std::pair<int, const char*> *Result, FDPathTmpData &TmpFilename);
+  void InsertRootFSPathCache(const char *pathname, std::pair<int, const char*> Result);
+
+  bool RootFSMountsChanged();
+  void OpenMountInfo();
+
+  constexpr static size_t MaxRootFSPathCacheEntries = 16384;
+  std::atomic<bool> RootFSPathCacheEnabled{};
+  // Set once the mounts changed, lookups miss until the next insert has cleared the cache
+  std::atomic<bool> RootFSPathCacheStale{};
+  // /proc/self/mountinfo polls with POLLPRI once per change to the mount namespace it was opened in
+  int MountInfoFD{-1};
+  FEXCore::ForkableSharedMutex RootFSPathCacheMutex;
+  fextl::unordered_map<fextl::string, RootFSPathCacheEntry> RootFSPathCache;
+
   struct ThunkDBObject {
     fextl::string LibraryName;
     fextl::unordered_set<fextl::string> Depends;
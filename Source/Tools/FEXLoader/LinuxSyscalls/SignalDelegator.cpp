@@ -400,9 +400,7 @@ namespace FEX::HLE {
       Frame->State.rip = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_RIP];
       // XXX: Full context setting
       uint32_t eflags = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_EFL];
-      for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-        Frame->State.flags[i] = (eflags & (1U << i)) ? 1 : 0;
-      }
+      Frame->State.SetEFLAGS(eflags);
 
       Frame->State.flags[1] = 1;
       Frame->State.flags[9] = 1;
@@ -475,9 +473,7 @@ namespace FEX::HLE {
       // XXX: Full context setting
       // First 32-bytes of flags is EFLAGS broken out
       uint32_t eflags = guest_uctx->sc.flags;
-      for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-        Frame->State.flags[i] = (eflags & (1U << i)) ? 1 : 0;
-      }
+      Frame->State.SetEFLAGS(eflags);
 
       Frame->State.flags[1] = 1;
       Frame->State.flags[9] = 1;
@@ -562,9 +558,7 @@ namespace FEX::HLE {
       // XXX: Full context setting
       // First 32-bytes of flags is EFLAGS broken out
       uint32_t eflags = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_EFL];
-      for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-        Frame->State.flags[i] = (eflags & (1U << i)) ? 1 : 0;
-      }
+      Frame->State.SetEFLAGS(eflags);
 
       Frame->State.flags[1] = 1;
       Frame->State.flags[9] = 1;
@@ -1225,10 +1219,7 @@ namespace FEX::HLE {
     // Backup where we think the RIP currently is
     ContextBackup->OriginalRIP = CTX->RestoreRIPFromHostPC(Thread, ArchHelpers::Context::GetPc(ucontext));
     // Calculate eflags upfront.
-    uint32_t eflags = 0;
-    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_EFLAG_BITS; ++i) {
-      eflags |= Frame->State.flags[i] << i;
-    }
+    uint32_t eflags = Frame->State.GetEFLAGS();
 
     if (Is64BitMode) {
       NewGuestSP = SetupFrame_x64(Thread, ContextBackup, Frame, Signal, HostSigInfo, ucontext, GuestAction, GuestStack, NewGuestSP, eflags);
@@ -1262,6 +1253,15 @@ namespace FEX::HLE {
     return true;
   }
 
+  static void SetDeferredSignalFaultPageProtection(FEXCore::Core::InternalThreadState *Thread, bool Protected) {
+    if (Thread->DeferredSignalFaultPageProtected == Protected) {
+      return;
+    }
+
+    mprotect(reinterpret_cast<void*>(Thread->CurrentFrame->State.DeferredSignalFaultAddress), 4096, Protected ? PROT_NONE : PROT_READ | PROT_WRITE);
+    Thread->DeferredSignalFaultPageProtected = Protected;
+  }
+
   bool SignalDelegator::HandleSIGILL(FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext) {
     if (ArchHelpers::Context::GetPc(ucontext) == Config.SignalHandlerReturnAddress ||
         ArchHelpers::Context::GetPc(ucontext) == Config.SignalHandlerReturnAddressRT) {
@@ -1276,7 +1276,7 @@ namespace FEX::HLE {
         // If we have more deferred frames to process then mprotect back to PROT_NONE.
         // It will have been RW coming in to this sigreturn and now we need to remove permissions
         // to ensure FEX trampolines back to the SIGSEGV deferred handler.
-        mprotect(reinterpret_cast<void*>(Thread->CurrentFrame->State.DeferredSignalFaultAddress), 4096, PROT_NONE);
+        SetDeferredSignalFaultPageProtection(Thread, true);
       }
       return true;
     }
@@ -1425,7 +1425,7 @@ namespace FEX::HLE {
           // We just reached the end of the outermost signal-deferring section and faulted to check for pending signals.
           // Pull a signal frame off the stack.
 
-          mprotect(reinterpret_cast<void*>(Thread->CurrentFrame->State.DeferredSignalFaultAddress), 4096, PROT_READ | PROT_WRITE);
+          SetDeferredSignalFaultPageProtection(Thread, false);
 
           if (Thread->DeferredSignalFrames.empty()) {
             // No signals to defer. Just set the fault page back to RW and continue execution.
@@ -1450,13 +1450,13 @@ namespace FEX::HLE {
         }
         else {
 #ifdef _M_ARM_64
-          // If RefCount != 0 then that means we hit an access with nested signal-deferring sections.
+          // Signal-deferring sections only access the fault page when the refcount reaches zero, so this shouldn't happen.
+          // If RefCount != 0 then something accessed the page from inside of a nested section.
           // Increment the PC past the `str zr, [x1]` to continue code execution until we reach the outermost section.
           ArchHelpers::Context::SetPc(UContext, ArchHelpers::Context::GetPc(UContext) + 4);
           return;
 #else
           // X86 should always be doing a refcount compare and branch since we can't guarantee instruction size.
-          // ARM64 just always does the access to reduce branching overhead.
           ERROR_AND_DIE_FMT("X86 shouldn't hit this DeferredSignalFaultAddress");
 #endif
         }
@@ -1473,7 +1473,8 @@ namespace FEX::HLE {
           });
 
           // Now update the faulting page permissions so it will fault on write.
-          mprotect(reinterpret_cast<void*>(Thread->CurrentFrame->State.DeferredSignalFaultAddress), 4096, PROT_NONE);
+          // Already protected if another signal was deferred in this section.
+          SetDeferredSignalFaultPageProtection(Thread, true);
 
           // Postpone the remainder of signal handling logic until we process the SIGSEGV triggered by writing to DeferredSignalFaultAddress.
           return;
@@ -1547,6 +1548,7 @@ namespace FEX::HLE {
       if (!ApplicationName.empty()) {
         FEXCore::Telemetry::Shutdown(ApplicationName);
       }
+      CTX->FlushJITSymbols(false);
 
       // Reassign back to DFL and crash
       signal(Signal, SIG_DFL);
@@ -1762,9 +1764,30 @@ namespace FEX::HLE {
       return Result.first;
     };
 
+    // Cold blocks run in the interpreter underneath the JIT, so unaligned accesses can come from either
+    const auto SigbusHandlerTiered = [](FEXCore::Core::InternalThreadState *Thread, int Signal, void *_info, void *ucontext) -> bool {
+      const auto PC = ArchHelpers::Context::GetPc(ucontext);
+      siginfo_t* info = reinterpret_cast<siginfo_t*>(_info);
+
+      if (info->si_code != BUS_ADRALN) {
+        // This only handles alignment problems
+        return false;
+      }
+
+      // The interpreter always needs its atomics handled, JIT code only when TSO is emulated paranoidly
+      const bool InJIT = Thread->CPUBackend->IsAddressInCodeBuffer(PC);
+      const auto Result = FEXCore::ArchHelpers::Arm64::HandleUnalignedAccess(InJIT ? GlobalDelegator->ParanoidTSO() : true, PC, ArchHelpers::Context::GetArmGPRs(ucontext));
+      ArchHelpers::Context::SetPc(ucontext, PC + Result.second);
+      return Result.first;
+    };
+
     if (Core == FEXCore::Config::CONFIG_INTERPRETER) {
       RegisterHostSignalHandler(SIGBUS, SigbusHandlerInterpreter, true);
     }
+    else if (InterpreterTierThreshold()) {
+      // Config loading erases the threshold unless the interpreter tier can run underneath the JIT
+      RegisterHostSignalHandler(SIGBUS, SigbusHandlerTiered, true);
+    }
     else {
       RegisterHostSignalHandler(SIGBUS, SigbusHandler, true);
     }
@@ -271,6 +271,9 @@ uint64_t ExecveHandler(const char *pathname, char* const* argv, char* const* env
   // Kernel does its own checks for file format support for this
   // We can only call execve directly if we both have an interpreter installed AND were ran with the interpreter
   // If the user ran FEX through FEXLoader then we must go down the emulated path
+  // A successful exec replaces the process without going through FEX's shutdown
+  FEX::HLE::_SyscallHandler->GetContext()->FlushJITSymbols(true);
+
   uint64_t Result{};
   if (FEX::HLE::_SyscallHandler->IsInterpreterInstalled() &&
       FEX::HLE::_SyscallHandler->IsInterpreter() &&
@@ -831,11 +834,18 @@ uint64_t UnimplementedSyscallSafe(FEXCore::Core::CpuStateFrame *Frame, uint64_t
 
 void SyscallHandler::LockBeforeFork() {
   VMATracking.Mutex.lock();
+  FM.LockBeforeFork();
 }
 
 void SyscallHandler::UnlockAfterFork(bool Child) {
+  FM.UnlockAfterFork(Child);
+
   if (Child) {
     VMATracking.Mutex.StealAndDropActiveLocks();
+
+    if (ForkChildHandler) {
+      ForkChildHandler();
+    }
   }
   else {
     VMATracking.Mutex.unlock();
@@ -1169,4 +1179,46 @@ fextl::unique_ptr<FEXCore::HLE::SourcecodeMap> SyscallHandler::GenerateMap(const
 
 }
 
+fextl::unique_ptr<FEXCore::HLE::SourcecodeMap> SyscallHandler::GenerateSymbolMap(const std::string_view& GuestBinaryFile) {
+  const fextl::string Filename(GuestBinaryFile);
+  if (!ELFLoader::ELFContainer::IsSupportedELF(Filename)) {
+    return {};
+  }
+
+  ELFLoader::ELFContainer GuestELF{Filename, "", true};
+  if (!GuestELF.WasLoaded()) {
+    return {};
+  }
+
+  auto rv = fextl::make_unique<FEXCore::HLE::SourcecodeMap>();
+
+  GuestELF.AddSymbols([&](ELFLoader::ELFSymbol *Symbol) {
+    uint64_t FileOffset;
+    if (Symbol->Type != STT_FUNC || Symbol->Size == 0 || !GuestELF.GetFileOffset(Symbol->Address, &FileOffset)) {
+      return;
+    }
+
+    rv->SortedSymbolMappings.push_back({FileOffset, FileOffset + Symbol->Size, Symbol->Name});
+  });
+
+  if (rv->SortedSymbolMappings.empty()) {
+    return {};
+  }
+
+  std::sort(rv->SortedSymbolMappings.begin(), rv->SortedSymbolMappings.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.FileGuestBegin < rhs.FileGuestBegin;
+  });
+
+  // Lookups need non-overlapping ranges, keeps the first of any aliases for the same function
+  size_t Last = 0;
+  for (size_t i = 1; i < rv->SortedSymbolMappings.size(); ++i) {
+    if (rv->SortedSymbolMappings[i].FileGuestBegin >= rv->SortedSymbolMappings[Last].FileGuestEnd) {
+      rv->SortedSymbolMappings[++Last] = std::move(rv->SortedSymbolMappings[i]);
+    }
+  }
+  rv->SortedSymbolMappings.resize(Last + 1);
+
+  return rv;
+}
+
 }
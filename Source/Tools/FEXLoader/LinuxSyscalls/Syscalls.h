@@ -22,6 +22,7 @@ $end_info$
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <functional>
 #include <mutex>
 #include <shared_mutex>
 
@@ -62,7 +63,6 @@ class SignalDelegator;
   void RegisterFS(FEX::HLE::SyscallHandler *Handler);
   void RegisterInfo(FEX::HLE::SyscallHandler *Handler);
   void RegisterIO(FEX::HLE::SyscallHandler *Handler);
-  void RegisterIOUring(FEX::HLE::SyscallHandler *Handler);
   void RegisterKey(FEX::HLE::SyscallHandler *Handler);
   void RegisterMemory(FEX::HLE::SyscallHandler *Handler);
   void RegisterMsg(FEX::HLE::SyscallHandler *Handler);
@@ -168,7 +168,10 @@ public:
   FEX::HLE::FileManager FM;
   FEXCore::CodeLoader *GetCodeLoader() const override { return LocalLoader; }
   void SetCodeLoader(FEXCore::CodeLoader *Loader) { LocalLoader = Loader; }
+  // Runs in the child of a guest fork, after the syscall handler's own state has been fixed up
+  void SetForkChildHandler(std::function<void()> Handler) { ForkChildHandler = std::move(Handler); }
   FEX::HLE::SignalDelegator *GetSignalDelegator() { return SignalDelegation; }
+  FEXCore::Context::Context *GetContext() const { return CTX; }
 
   FEX_CONFIG_OPT(IsInterpreter, IS_INTERPRETER);
   FEX_CONFIG_OPT(IsInterpreterInstalled, INTERPRETER_INSTALLED);
@@ -250,6 +253,7 @@ private:
   std::mutex FutexMutex;
   std::mutex SyscallMutex;
   FEXCore::CodeLoader *LocalLoader{};
+  std::function<void()> ForkChildHandler;
 
   #ifdef DEBUG_STRACE
     void Strace(FEXCore::HLE::SyscallArguments *Args, uint64_t Ret);
@@ -258,6 +262,7 @@ private:
   fextl::unique_ptr<FEX::HLE::MemAllocator> Alloc32Handler{};
 
   fextl::unique_ptr<FEXCore::HLE::SourcecodeMap> GenerateMap(const std::string_view& GuestBinaryFile, const std::string_view& GuestBinaryFileId) override;
+  fextl::unique_ptr<FEXCore::HLE::SourcecodeMap> GenerateSymbolMap(const std::string_view& GuestBinaryFile) override;
 
   ///// VMA (Virtual Memory Area) tracking /////
 
@@ -306,6 +311,8 @@ private:
 
   struct VMAFlags {
     bool Shared: 1;
+    // Sticky, set once the mapping has been writable at any point
+    bool WasWritable: 1;
 
     static VMAFlags fromFlags(int Flags);
   };
@@ -337,6 +344,10 @@ private:
 
     MappedResource::ContainerType MappedResources;
 
+    // Incremented on every modification of VMAs, used to validate the per-thread lookup cache
+    // Only modified while the Mutex is unique_locked
+    uint64_t Generation{1};
+
     // Mutex must be at least shared_locked before calling
     VMACIterator LookupVMAUnsafe(uint64_t GuestAddr) const;
 
@@ -358,6 +369,13 @@ private:
     void ListInsertAfter(VMAEntry *Mapping, VMAEntry *NewMapping);
     void ListPrepend(MappedResource *Resource, VMAEntry *NewVMA);
     static void ListCheckVMALinks(VMAEntry *VMA);
+
+    // Last VMA found by LookupVMAUnsafe on this thread, only valid while Generation matches
+    struct LookupCache {
+      uint64_t Generation;
+      VMACIterator Entry;
+    };
+    static thread_local LookupCache LastLookup;
   } VMATracking;
 };
 
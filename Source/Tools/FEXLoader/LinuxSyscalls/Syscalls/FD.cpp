@@ -6,6 +6,7 @@ $end_info$
 
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
+#include "LinuxSyscalls/x32/IOUring.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 
 #include <FEXCore/IR/IR.h>
@@ -96,6 +97,9 @@ namespace FEX::HLE {
       [](FEXCore::Core::CpuStateFrame* Frame, int oldfd, int newfd, int flags) -> uint64_t {
       flags = FEX::HLE::RemapFromX86Flags(flags);
       uint64_t Result = ::dup3(oldfd, newfd, flags);
+      if (Result != -1) {
+        FEX::HLE::x32::IOUring::TrackFDDuplication(oldfd, newfd);
+      }
       SYSCALL_ERRNO();
     });
 
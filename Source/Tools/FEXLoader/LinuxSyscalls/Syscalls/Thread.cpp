@@ -620,12 +620,19 @@ namespace FEX::HLE {
     REGISTER_SYSCALL_IMPL_PASS_FLAGS(unshare, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, int flags) -> uint64_t {
       uint64_t Result = ::unshare(flags);
+      if (Result != -1 && (flags & CLONE_NEWNS)) {
+        FEX::HLE::_SyscallHandler->FM.MountNamespaceChanged();
+      }
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_PASS_FLAGS(setns, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, int fd, int nstype) -> uint64_t {
       uint64_t Result = ::setns(fd, nstype);
+      // nstype 0 allows any kind of namespace
+      if (Result != -1 && (nstype == 0 || (nstype & CLONE_NEWNS))) {
+        FEX::HLE::_SyscallHandler->FM.MountNamespaceChanged();
+      }
       SYSCALL_ERRNO();
     });
 
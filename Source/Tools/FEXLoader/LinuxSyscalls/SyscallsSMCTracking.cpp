@@ -176,9 +176,15 @@ FEXCore::HLE::AOTIRCacheEntryLookupResult SyscallHandler::LookupAOTIRCacheEntry(
     return {nullptr, 0};
   }
 
+  const auto AOTIRCacheEntry = Entry->second.Resource ? Entry->second.Resource->AOTIRCacheEntry : nullptr;
+
+  // Shared mappings can be written through by other processes, private ones only if they were ever writable
+  const bool MappingUnmodified = !Entry->second.Flags.Shared && !Entry->second.Flags.WasWritable;
+
   return {
-    Entry->second.Resource ? Entry->second.Resource->AOTIRCacheEntry : nullptr,
-    Entry->second.Base - Entry->second.Offset
+    AOTIRCacheEntry,
+    Entry->second.Base - Entry->second.Offset,
+    MappingUnmodified
   };
 }
 
@@ -190,6 +196,36 @@ void SyscallHandler::TrackMmap(FEXCore::Core::InternalThreadState *Thread, uintp
     CTX->MarkMemoryShared();
   }
 
+  MRID FileMrid{};
+  fextl::string FilePath;
+  bool HasFilePath = false;
+  FEXCore::IR::AOTIRCacheEntry *LoadedAOTIRCacheEntry = nullptr;
+
+  if (!(Flags & MAP_ANONYMOUS)) {
+    struct stat64 buf;
+    fstat64(fd, &buf);
+    FileMrid = MRID {buf.st_dev, buf.st_ino};
+
+    char Tmp[PATH_MAX];
+    auto PathLength = FEX::get_fdpath(fd, Tmp);
+
+    if (PathLength != -1) {
+      FilePath = fextl::string(Tmp, PathLength);
+      HasFilePath = true;
+
+      bool Known;
+      {
+        FEXCore::ScopedPotentialDeferredSignalWithForkableSharedLock lk(VMATracking.Mutex, Thread);
+        Known = VMATracking.MappedResources.find(FileMrid) != VMATracking.MappedResources.end();
+      }
+
+      // Identifying the file can hash all of it, so never do that with the VMA lock held
+      if (!Known) {
+        LoadedAOTIRCacheEntry = CTX->LoadAOTIRCacheEntry(FilePath, fd);
+      }
+    }
+  }
+
   {
     // NOTE: Frontend calls this with a nullptr Thread during initialization, but
     //       providing this code with a valid Thread object earlier would allow
@@ -200,23 +236,15 @@ void SyscallHandler::TrackMmap(FEXCore::Core::InternalThreadState *Thread, uintp
 
     MappedResource *Resource = nullptr;
 
-    if (!(Flags & MAP_ANONYMOUS)) {
-      struct stat64 buf;
-      fstat64(fd, &buf);
-      MRID mrid {buf.st_dev, buf.st_ino};
-
-      char Tmp[PATH_MAX];
-      auto PathLength = FEX::get_fdpath(fd, Tmp);
-
-      if (PathLength != -1) {
-        Tmp[PathLength] = '\0';
-        auto [Iter, Inserted] = VMATracking.MappedResources.emplace(mrid, MappedResource {nullptr, nullptr, 0});
-        Resource = &Iter->second;
+    if (HasFilePath) {
+      auto [Iter, Inserted] = VMATracking.MappedResources.emplace(FileMrid, MappedResource {nullptr, nullptr, 0});
+      Resource = &Iter->second;
 
-        if (Inserted) {
-          Resource->AOTIRCacheEntry = CTX->LoadAOTIRCacheEntry(fextl::string(Tmp, PathLength));
-          Resource->Iterator = Iter;
-        }
+      if (Inserted) {
+        // If the last mapping of the file went away after the check above, the resource goes without a cache entry
+        Resource->AOTIRCacheEntry = LoadedAOTIRCacheEntry;
+        Resource->Iterator = Iter;
+        LoadedAOTIRCacheEntry = nullptr;
       }
     } else if (Flags & MAP_SHARED) {
       MRID mrid{SpecialDev::Anon, AnonSharedId++};
@@ -232,6 +260,11 @@ void SyscallHandler::TrackMmap(FEXCore::Core::InternalThreadState *Thread, uintp
     VMATracking.SetUnsafe(CTX, Resource, Base, Offset, Size, VMAFlags::fromFlags(Flags), VMAProt::fromProt(Prot));
   }
 
+  // Another thread mapped the same file in the meantime and its resource already holds the entry
+  if (LoadedAOTIRCacheEntry) {
+    CTX->UnloadAOTIRCacheEntry(LoadedAOTIRCacheEntry);
+  }
+
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
     // VMATracking.Mutex can't be held while executing this, otherwise it hangs if the JIT is in the process of looking up code in the AOT JIT.
     CTX->InvalidateGuestCodeRange(Thread, (uintptr_t)Base, Size);
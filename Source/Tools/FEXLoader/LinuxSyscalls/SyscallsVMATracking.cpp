@@ -8,6 +8,8 @@ $end_info$
 
 #include "LinuxSyscalls/Syscalls.h"
 
+#include <atomic>
+
 namespace FEX::HLE {
 /// List Operations ///
 
@@ -125,14 +127,30 @@ void SyscallHandler::VMATracking::ListPrepend(MappedResource *Resource, VMAEntry
 
 /// VMA tracking ///
 
+// Generation starts at 1, so a zero initialized cache is always a miss
+thread_local SyscallHandler::VMATracking::LookupCache SyscallHandler::VMATracking::LastLookup{};
+
 // Lookup a VMA by address
 SyscallHandler::VMATracking::VMACIterator SyscallHandler::VMATracking::LookupVMAUnsafe(uint64_t GuestAddr) const {
+  // Faults and code lookups tend to hit the same mapping repeatedly.
+  // The generation can't change while the Mutex is held, so a matching generation means the iterator is still live.
+  if (LastLookup.Generation == Generation) {
+    const auto Cached = LastLookup.Entry;
+    if (Cached->first <= GuestAddr && (Cached->first + Cached->second.Length) > GuestAddr) {
+      return Cached;
+    }
+  }
+
   auto Entry = VMAs.upper_bound(GuestAddr);
 
   if (Entry != VMAs.begin()) {
     --Entry;
 
     if (Entry->first <= GuestAddr && (Entry->first + Entry->second.Length) > GuestAddr) {
+      // Entry must be visible before the Generation, as this can be reentered from the SIGSEGV handler
+      LastLookup.Entry = Entry;
+      std::atomic_signal_fence(std::memory_order_release);
+      LastLookup.Generation = Generation;
       return Entry;
     }
   }
@@ -145,6 +163,8 @@ void SyscallHandler::VMATracking::SetUnsafe(FEXCore::Context::Context *CTX, Mapp
                                             uintptr_t Offset, uintptr_t Length, VMAFlags Flags, VMAProt Prot) {
   ClearUnsafe(CTX, Base, Length, MappedResource);
 
+  Flags.WasWritable |= Prot.Writable;
+
   auto [Iter, Inserted] = VMAs.emplace(
       Base, VMAEntry{MappedResource, nullptr, MappedResource ? MappedResource->FirstVMA : nullptr, Base, Offset, Length, Flags, Prot});
       
@@ -160,6 +180,7 @@ void SyscallHandler::VMATracking::SetUnsafe(FEXCore::Context::Context *CTX, Mapp
 // freeing their associated MappedResource unless it is equal to PreservedMappedResource
 void SyscallHandler::VMATracking::ClearUnsafe(FEXCore::Context::Context *CTX, uintptr_t Base, uintptr_t Length,
                                               MappedResource *PreservedMappedResource) {
+  ++Generation;
   const auto Top = Base + Length;
 
   // find the first Mapping at or after the Range ends, or ::end()
@@ -244,6 +265,7 @@ void SyscallHandler::VMATracking::ClearUnsafe(FEXCore::Context::Context *CTX, ui
 
 // Change flags of mappings in a range and split the mappings if needed
 void SyscallHandler::VMATracking::ChangeUnsafe(uintptr_t Base, uintptr_t Length, VMAProt NewProt) {
+  ++Generation;
   const auto Top = Base + Length;
 
   // find the first Mapping at or after the Range ends, or ::end()
@@ -259,6 +281,8 @@ void SyscallHandler::VMATracking::ChangeUnsafe(uintptr_t Base, uintptr_t Length,
     const auto MapTop = MapBase + Current->Length;
     const auto MapFlags = Current->Flags;
     const auto MapProt = Current->Prot;
+    auto NewFlags = MapFlags;
+    NewFlags.WasWritable |= NewProt.Writable;
 
     const auto OffsetDiff = Current->Offset - MapBase;
 
@@ -283,7 +307,7 @@ void SyscallHandler::VMATracking::ChangeUnsafe(uintptr_t Base, uintptr_t Length,
         auto NewLength = Top - Base;
 
         auto [Iter, Inserted] =
-            VMAs.emplace(Base, VMAEntry{Current->Resource, Current, Current->ResourceNextVMA, Base, NewOffset, NewLength, MapFlags, NewProt});
+            VMAs.emplace(Base, VMAEntry{Current->Resource, Current, Current->ResourceNextVMA, Base, NewOffset, NewLength, NewFlags, NewProt});
         LOGMAN_THROW_A_FMT(Inserted == true, "VMA tracking error");
         auto RestOfMapping = &Iter->second;
 
@@ -295,6 +319,7 @@ void SyscallHandler::VMATracking::ChangeUnsafe(uintptr_t Base, uintptr_t Length,
       } else {
         // Mapping starts in range, just change Prot
         Current->Prot = NewProt;
+        Current->Flags = NewFlags;
       }
 
       if (HasTrailingPart) {
@@ -324,7 +349,7 @@ void SyscallHandler::VMATracking::ChangeUnsafe(uintptr_t Base, uintptr_t Length,
 
 // This matches the peculiarities algorithm used in linux ksys_shmdt (linux kernel 5.16, ipc/shm.c)
 uintptr_t SyscallHandler::VMATracking::ClearShmUnsafe(FEXCore::Context::Context *CTX, uintptr_t Base) {
-
+  ++Generation;
   // Find first VMA at or after Base
   // Iterate until first SHM VMA, with matching offset, get length
   // Then, erase any later occurrences of this SHM
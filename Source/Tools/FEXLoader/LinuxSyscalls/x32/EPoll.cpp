@@ -7,13 +7,11 @@ $end_info$
 
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/Types.h"
+#include "LinuxSyscalls/x32/Marshaling.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/Types.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 
-#include <FEXCore/fextl/vector.h>
-
-#include <algorithm>
 #include <cstdint>
 #include <sys/epoll.h>
 #include <syscall.h>
@@ -29,15 +27,13 @@ namespace FEXCore::Core {
 
 namespace FEX::HLE::x32 {
   void RegisterEpoll(FEX::HLE::SyscallHandler *Handler) {
-    REGISTER_SYSCALL_IMPL_X32(epoll_wait, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevents, int timeout) -> uint64_t {
-      fextl::vector<struct epoll_event> Events(std::max(0, maxevents));
-      uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events.data(), maxevents, timeout, nullptr, 8);
+    using namespace FEXCore::IR;
 
-      if (Result != -1) {
-        for (size_t i = 0; i < Result; ++i) {
-          events[i] = Events[i];
-        }
-      }
+    REGISTER_SYSCALL_IMPL_X32_FLAGS(epoll_wait, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY | SyscallFlags::DIRECTCALL,
+      [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevents, int timeout) -> uint64_t {
+      uint64_t Result = WaitForEPollEvents(events, maxevents, [&](struct epoll_event *Events) -> uint64_t {
+        return ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events, maxevents, timeout, nullptr, 8);
+      });
       SYSCALL_ERRNO();
     });
 
@@ -47,30 +43,23 @@ namespace FEX::HLE::x32 {
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_X32(epoll_pwait, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevent, int timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-      fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
-
-      uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait),
-        epfd,
-        Events.data(),
-        maxevent,
-        timeout,
-        sigmask,
-        sigsetsize);
-
-      if (Result != -1) {
-        for (size_t i = 0; i < Result; ++i) {
-          events[i] = Events[i];
-        }
-      }
+    REGISTER_SYSCALL_IMPL_X32_FLAGS(epoll_pwait, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY | SyscallFlags::DIRECTCALL,
+      [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevent, int timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
+      uint64_t Result = WaitForEPollEvents(events, maxevent, [&](struct epoll_event *Events) -> uint64_t {
+        return ::syscall(SYSCALL_DEF(epoll_pwait),
+          epfd,
+          Events,
+          maxevent,
+          timeout,
+          sigmask,
+          sigsetsize);
+      });
 
       SYSCALL_ERRNO();
     });
 
     if (Handler->IsHostKernelVersionAtLeast(5, 11, 0)) {
       REGISTER_SYSCALL_IMPL_X32(epoll_pwait2, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevent, compat_ptr<timespec32> timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-        fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
-
         struct timespec tp64{};
         struct timespec *timed_ptr{};
         if (timeout) {
@@ -78,19 +67,15 @@ namespace FEX::HLE::x32 {
           timed_ptr = &tp64;
         }
 
-        uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait2),
-          epfd,
-          Events.data(),
-          maxevent,
-          timed_ptr,
-          sigmask,
-          sigsetsize);
-
-        if (Result != -1) {
-          for (size_t i = 0; i < Result; ++i) {
-            events[i] = Events[i];
-          }
-        }
+        uint64_t Result = WaitForEPollEvents(events, maxevent, [&](struct epoll_event *Events) -> uint64_t {
+          return ::syscall(SYSCALL_DEF(epoll_pwait2),
+            epfd,
+            Events,
+            maxevent,
+            timed_ptr,
+            sigmask,
+            sigsetsize);
+        });
 
         SYSCALL_ERRNO();
       });
@@ -5,7 +5,9 @@ $end_info$
 */
 
 #include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/x32/IOUring.h"
 #include "LinuxSyscalls/x32/IoctlEmulation.h"
+#include "LinuxSyscalls/x32/Marshaling.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/SyscallsEnum.h"
 #include "LinuxSyscalls/x32/Types.h"
@@ -14,8 +16,6 @@ $end_info$
 
 #include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/Utils/LogManager.h>
-#include <FEXCore/Utils/MathUtils.h>
-#include <FEXCore/fextl/vector.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -45,13 +45,6 @@ namespace FEXCore::Core {
 }
 
 namespace FEX::HLE::x32 {
-  // Used to ensure no bogus values are passed into readv/writev family syscalls.
-  // This is mainly to sanitize vector sizing. It's fine for the bogus value
-  // itself to pass into the syscall, since the kernel will handle it.
-  static constexpr int SanitizeIOCount(int count) {
-    return std::max(0, count);
-  }
-
 #ifdef _M_X86_64
   uint32_t ioctl_32(FEXCore::Core::CpuStateFrame*, int fd, uint32_t cmd, uint32_t args) {
     uint32_t Result{};
@@ -147,6 +140,7 @@ namespace FEX::HLE::x32 {
         case F_DUPFD:
         case F_DUPFD_CLOEXEC:
           FEX::HLE::x32::CheckAndAddFDDuplication(fd, Result);
+          FEX::HLE::x32::IOUring::TrackFDDuplication(fd, Result);
           break;
         case F_GETFL: {
           Result = FEX::HLE::RemapToX86Flags(Result);
@@ -164,85 +158,16 @@ namespace FEX::HLE::x32 {
       tp64 = *timeout;
     }
 
-    fd_set Host_readfds;
-    fd_set Host_writefds;
-    fd_set Host_exceptfds;
-    FD_ZERO(&Host_readfds);
-    FD_ZERO(&Host_writefds);
-    FD_ZERO(&Host_exceptfds);
-
-    // Round up to the full 32bit word
-    uint32_t NumWords = FEXCore::AlignUp(nfds, 32) / 4;
-
-    if (readfds) {
-      for (int i = 0; i < NumWords; ++i) {
-        uint32_t FD = readfds[i];
-        int32_t Rem = nfds - (i * 32);
-        for (int j = 0; j < 32 && j < Rem; ++j) {
-          if ((FD >> j) & 1) {
-            FD_SET(i * 32 + j, &Host_readfds);
-          }
-        }
-      }
-    }
-
-    if (writefds) {
-      for (int i = 0; i < NumWords; ++i) {
-        uint32_t FD = writefds[i];
-        int32_t Rem = nfds - (i * 32);
-        for (int j = 0; j < 32 && j < Rem; ++j) {
-          if ((FD >> j) & 1) {
-            FD_SET(i * 32 + j, &Host_writefds);
-          }
-        }
-      }
-    }
-
-    if (exceptfds) {
-      for (int i = 0; i < NumWords; ++i) {
-        uint32_t FD = exceptfds[i];
-        int32_t Rem = nfds - (i * 32);
-        for (int j = 0; j < 32 && j < Rem; ++j) {
-          if ((FD >> j) & 1) {
-            FD_SET(i * 32 + j, &Host_exceptfds);
-          }
-        }
-      }
-    }
+    HostFDSets Sets(nfds, readfds, writefds, exceptfds);
 
     uint64_t Result = ::select(nfds,
-      readfds ? &Host_readfds : nullptr,
-      writefds ? &Host_writefds : nullptr,
-      exceptfds ? &Host_exceptfds : nullptr,
+      Sets.Read(),
+      Sets.Write(),
+      Sets.Except(),
       timeout ? &tp64 : nullptr);
-    if (readfds) {
-      for (int i = 0; i < nfds; ++i) {
-        if (FD_ISSET(i, &Host_readfds)) {
-          readfds[i/32] |= 1 << (i & 31);
-        } else {
-          readfds[i/32] &= ~(1 << (i & 31));
-        }
-      }
-    }
 
-    if (writefds) {
-      for (int i = 0; i < nfds; ++i) {
-        if (FD_ISSET(i, &Host_writefds)) {
-          writefds[i/32] |= 1 << (i & 31);
-        } else {
-          writefds[i/32] &= ~(1 << (i & 31));
-        }
-      }
-    }
-
-    if (exceptfds) {
-      for (int i = 0; i < nfds; ++i) {
-        if (FD_ISSET(i, &Host_exceptfds)) {
-          exceptfds[i/32] |= 1 << (i & 31);
-        } else {
-          exceptfds[i/32] &= ~(1 << (i & 31));
-        }
-      }
+    if (Result != -1) {
+      Sets.CopyToGuest();
     }
 
     if (timeout) {
@@ -303,13 +228,13 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(readv, [](FEXCore::Core::CpuStateFrame *Frame, int fd, const struct iovec32 *iov, int iovcnt) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      HostIOVec Host_iovec(iov, iovcnt);
       uint64_t Result = ::readv(fd, Host_iovec.data(), iovcnt);
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_X32(writev, [](FEXCore::Core::CpuStateFrame *Frame, int fd, const struct iovec32 *iov, int iovcnt) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      HostIOVec Host_iovec(iov, iovcnt);
       uint64_t Result = ::writev(fd, Host_iovec.data(), iovcnt);
       SYSCALL_ERRNO();
     });
@@ -493,6 +418,7 @@ namespace FEX::HLE::x32 {
       uint64_t Result = ::dup(oldfd);
       if (Result != -1) {
         CheckAndAddFDDuplication(oldfd, Result);
+        IOUring::TrackFDDuplication(oldfd, Result);
       }
       SYSCALL_ERRNO();
     });
@@ -501,6 +427,7 @@ namespace FEX::HLE::x32 {
       uint64_t Result = ::dup2(oldfd, newfd);
       if (Result != -1) {
         CheckAndAddFDDuplication(oldfd, newfd);
+        IOUring::TrackFDDuplication(oldfd, newfd);
       }
       SYSCALL_ERRNO();
     });
@@ -511,7 +438,7 @@ namespace FEX::HLE::x32 {
       uint32_t iovcnt,
       uint32_t pos_low,
       uint32_t pos_high) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      HostIOVec Host_iovec(iov, iovcnt);
 
       uint64_t Result = ::syscall(SYSCALL_DEF(preadv), fd, Host_iovec.data(), iovcnt, pos_low, pos_high);
       SYSCALL_ERRNO();
@@ -523,23 +450,23 @@ namespace FEX::HLE::x32 {
       uint32_t iovcnt,
       uint32_t pos_low,
       uint32_t pos_high) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      HostIOVec Host_iovec(iov, iovcnt);
 
       uint64_t Result = ::syscall(SYSCALL_DEF(pwritev), fd, Host_iovec.data(), iovcnt, pos_low, pos_high);
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_X32(process_vm_readv, [](FEXCore::Core::CpuStateFrame *Frame, pid_t pid, const struct iovec32 *local_iov, unsigned long liovcnt, const struct iovec32 *remote_iov, unsigned long riovcnt, unsigned long flags) -> uint64_t {
-      fextl::vector<iovec> Host_local_iovec(local_iov, local_iov + SanitizeIOCount(liovcnt));
-      fextl::vector<iovec> Host_remote_iovec(remote_iov, remote_iov + SanitizeIOCount(riovcnt));
+      HostIOVec Host_local_iovec(local_iov, liovcnt);
+      HostIOVec Host_remote_iovec(remote_iov, riovcnt);
 
       uint64_t Result = ::process_vm_readv(pid, Host_local_iovec.data(), liovcnt, Host_remote_iovec.data(), riovcnt, flags);
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_X32(process_vm_writev, [](FEXCore::Core::CpuStateFrame *Frame, pid_t pid, const struct iovec32 *local_iov, unsigned long liovcnt, const struct iovec32 *remote_iov, unsigned long riovcnt, unsigned long flags) -> uint64_t {
-      fextl::vector<iovec> Host_local_iovec(local_iov, local_iov + SanitizeIOCount(liovcnt));
-      fextl::vector<iovec> Host_remote_iovec(remote_iov, remote_iov + SanitizeIOCount(riovcnt));
+      HostIOVec Host_local_iovec(local_iov, liovcnt);
+      HostIOVec Host_remote_iovec(remote_iov, riovcnt);
 
       uint64_t Result = ::process_vm_writev(pid, Host_local_iovec.data(), liovcnt, Host_remote_iovec.data(), riovcnt, flags);
       SYSCALL_ERRNO();
@@ -552,7 +479,7 @@ namespace FEX::HLE::x32 {
       uint32_t pos_low,
       uint32_t pos_high,
       int flags) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      HostIOVec Host_iovec(iov, iovcnt);
 
       uint64_t Result = ::syscall(SYSCALL_DEF(preadv2), fd, Host_iovec.data(), iovcnt, pos_low, pos_high, flags);
       SYSCALL_ERRNO();
@@ -565,7 +492,7 @@ namespace FEX::HLE::x32 {
       uint32_t pos_low,
       uint32_t pos_high,
       int flags) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      HostIOVec Host_iovec(iov, iovcnt);
 
       uint64_t Result = ::syscall(SYSCALL_DEF(pwritev2), fd, Host_iovec.data(),iovcnt, pos_low, pos_high, flags);
       SYSCALL_ERRNO();
@@ -615,55 +542,10 @@ namespace FEX::HLE::x32 {
         tp64 = *timeout;
       }
 
-      fd_set Host_readfds;
-      fd_set Host_writefds;
-      fd_set Host_exceptfds;
+      HostFDSets Sets(nfds, readfds, writefds, exceptfds);
       sigset_t HostSet{};
-
-      FD_ZERO(&Host_readfds);
-      FD_ZERO(&Host_writefds);
-      FD_ZERO(&Host_exceptfds);
       sigemptyset(&HostSet);
 
-      // Round up to the full 32bit word
-      uint32_t NumWords = FEXCore::AlignUp(nfds, 32) / 4;
-
-      if (readfds) {
-        for (int i = 0; i < NumWords; ++i) {
-          uint32_t FD = readfds[i];
-          int32_t Rem = nfds - (i * 32);
-          for (int j = 0; j < 32 && j < Rem; ++j) {
-            if ((FD >> j) & 1) {
-              FD_SET(i * 32 + j, &Host_readfds);
-            }
-          }
-        }
-      }
-
-      if (writefds) {
-        for (int i = 0; i < NumWords; ++i) {
-          uint32_t FD = writefds[i];
-          int32_t Rem = nfds - (i * 32);
-          for (int j = 0; j < 32 && j < Rem; ++j) {
-            if ((FD >> j) & 1) {
-              FD_SET(i * 32 + j, &Host_writefds);
-            }
-          }
-        }
-      }
-
-      if (exceptfds) {
-        for (int i = 0; i < NumWords; ++i) {
-          uint32_t FD = exceptfds[i];
-          int32_t Rem = nfds - (i * 32);
-          for (int j = 0; j < 32 && j < Rem; ++j) {
-            if ((FD >> j) & 1) {
-              FD_SET(i * 32 + j, &Host_exceptfds);
-            }
-          }
-        }
-      }
-
       if (sigmaskpack && sigmaskpack->sigset) {
         uint64_t *sigmask = sigmaskpack->sigset;
         size_t sigsetsize = sigmaskpack->size;
@@ -675,40 +557,14 @@ namespace FEX::HLE::x32 {
       }
 
       uint64_t Result = ::pselect(nfds,
-        readfds ? &Host_readfds : nullptr,
-        writefds ? &Host_writefds : nullptr,
-        exceptfds ? &Host_exceptfds : nullptr,
+        Sets.Read(),
+        Sets.Write(),
+        Sets.Except(),
         timeout ? &tp64 : nullptr,
         &HostSet);
 
-      if (readfds) {
-        for (int i = 0; i < nfds; ++i) {
-          if (FD_ISSET(i, &Host_readfds)) {
-            readfds[i/32] |= 1 << (i & 31);
-          } else {
-            readfds[i/32] &= ~(1 << (i & 31));
-          }
-        }
-      }
-
-      if (writefds) {
-        for (int i = 0; i < nfds; ++i) {
-          if (FD_ISSET(i, &Host_writefds)) {
-            writefds[i/32] |= 1 << (i & 31);
-          } else {
-            writefds[i/32] &= ~(1 << (i & 31));
-          }
-        }
-      }
-
-      if (exceptfds) {
-        for (int i = 0; i < nfds; ++i) {
-          if (FD_ISSET(i, &Host_exceptfds)) {
-            exceptfds[i/32] |= 1 << (i & 31);
-          } else {
-            exceptfds[i/32] &= ~(1 << (i & 31));
-          }
-        }
+      if (Result != -1) {
+        Sets.CopyToGuest();
       }
 
       if (timeout) {
@@ -774,55 +630,10 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(pselect6_time64, [](FEXCore::Core::CpuStateFrame *Frame, int nfds, fd_set32 *readfds, fd_set32 *writefds, fd_set32 *exceptfds, struct timespec *timeout, compat_ptr<sigset_argpack32> sigmaskpack) -> uint64_t {
-      fd_set Host_readfds;
-      fd_set Host_writefds;
-      fd_set Host_exceptfds;
+      HostFDSets Sets(nfds, readfds, writefds, exceptfds);
       sigset_t HostSet{};
-
-      FD_ZERO(&Host_readfds);
-      FD_ZERO(&Host_writefds);
-      FD_ZERO(&Host_exceptfds);
       sigemptyset(&HostSet);
 
-      // Round up to the full 32bit word
-      uint32_t NumWords = FEXCore::AlignUp(nfds, 32) / 4;
-
-      if (readfds) {
-        for (int i = 0; i < NumWords; ++i) {
-          uint32_t FD = readfds[i];
-          int32_t Rem = nfds - (i * 32);
-          for (int j = 0; j < 32 && j < Rem; ++j) {
-            if ((FD >> j) & 1) {
-              FD_SET(i * 32 + j, &Host_readfds);
-            }
-          }
-        }
-      }
-
-      if (writefds) {
-        for (int i = 0; i < NumWords; ++i) {
-          uint32_t FD = writefds[i];
-          int32_t Rem = nfds - (i * 32);
-          for (int j = 0; j < 32 && j < Rem; ++j) {
-            if ((FD >> j) & 1) {
-              FD_SET(i * 32 + j, &Host_writefds);
-            }
-          }
-        }
-      }
-
-      if (exceptfds) {
-        for (int i = 0; i < NumWords; ++i) {
-          uint32_t FD = exceptfds[i];
-          int32_t Rem = nfds - (i * 32);
-          for (int j = 0; j < 32 && j < Rem; ++j) {
-            if ((FD >> j) & 1) {
-              FD_SET(i * 32 + j, &Host_exceptfds);
-            }
-          }
-        }
-      }
-
       if (sigmaskpack && sigmaskpack->sigset) {
         uint64_t *sigmask = sigmaskpack->sigset;
         size_t sigsetsize = sigmaskpack->size;
@@ -834,40 +645,14 @@ namespace FEX::HLE::x32 {
       }
 
       uint64_t Result = ::pselect(nfds,
-        readfds ? &Host_readfds : nullptr,
-        writefds ? &Host_writefds : nullptr,
-        exceptfds ? &Host_exceptfds : nullptr,
+        Sets.Read(),
+        Sets.Write(),
+        Sets.Except(),
         timeout,
         &HostSet);
 
-      if (readfds) {
-        for (int i = 0; i < nfds; ++i) {
-          if (FD_ISSET(i, &Host_readfds)) {
-            readfds[i/32] |= 1 << (i & 31);
-          } else {
-            readfds[i/32] &= ~(1 << (i & 31));
-          }
-        }
-      }
-
-      if (writefds) {
-        for (int i = 0; i < nfds; ++i) {
-          if (FD_ISSET(i, &Host_writefds)) {
-            writefds[i/32] |= 1 << (i & 31);
-          } else {
-            writefds[i/32] &= ~(1 << (i & 31));
-          }
-        }
-      }
-
-      if (exceptfds) {
-        for (int i = 0; i < nfds; ++i) {
-          if (FD_ISSET(i, &Host_exceptfds)) {
-            exceptfds[i/32] |= 1 << (i & 31);
-          } else {
-            exceptfds[i/32] &= ~(1 << (i & 31));
-          }
-        }
+      if (Result != -1) {
+        Sets.CopyToGuest();
       }
 
       SYSCALL_ERRNO();
@@ -959,7 +744,7 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(vmsplice, [](FEXCore::Core::CpuStateFrame *Frame, int fd, const struct iovec32 *iov, unsigned long nr_segs, unsigned int flags) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + nr_segs);
+      HostIOVec Host_iovec(iov, nr_segs);
       uint64_t Result = ::vmsplice(fd, Host_iovec.data(), nr_segs, flags);
       SYSCALL_ERRNO();
     });
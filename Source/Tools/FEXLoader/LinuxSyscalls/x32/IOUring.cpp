@@ -0,0 +1,573 @@
+/*
+$info$
+tags: LinuxSyscalls|syscalls-x86-32
+$end_info$
+*/
+
+#include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/x32/IOUring.h"
+#include "LinuxSyscalls/x32/Marshaling.h"
+#include "LinuxSyscalls/x32/Syscalls.h"
+#include "LinuxSyscalls/x32/Types.h"
+#include "LinuxSyscalls/x64/Syscalls.h"
+
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/fextl/unordered_map.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <mutex>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Some io_uring defines for older build environments
+#ifndef IORING_SETUP_SQE128
+#define IORING_SETUP_SQE128 (1U << 10)
+#endif
+#ifndef IORING_SETUP_NO_MMAP
+#define IORING_SETUP_NO_MMAP (1U << 14)
+#endif
+#ifndef IORING_SETUP_REGISTERED_FD_ONLY
+#define IORING_SETUP_REGISTERED_FD_ONLY (1U << 15)
+#endif
+#ifndef IORING_SETUP_NO_SQARRAY
+#define IORING_SETUP_NO_SQARRAY (1U << 16)
+#endif
+#ifndef IORING_ENTER_EXT_ARG
+#define IORING_ENTER_EXT_ARG (1U << 3)
+#endif
+#ifndef IORING_ENTER_REGISTERED_RING
+#define IORING_ENTER_REGISTERED_RING (1U << 4)
+#endif
+#ifndef IORING_REGISTER_USE_REGISTERED_RING
+#define IORING_REGISTER_USE_REGISTERED_RING (1U << 31)
+#endif
+#ifndef IORING_RSRC_REGISTER_SPARSE
+#define IORING_RSRC_REGISTER_SPARSE (1U << 0)
+#endif
+
+namespace FEX::HLE::x32::IOUring {
+namespace {
+  // Opcodes that are newer than the kernel headers of some build environments
+  constexpr uint8_t OP_SENDMSG_ZC = 48;
+  constexpr uint8_t OP_WAITID = 50;
+  constexpr uint8_t OP_EPOLL_WAIT = 59;
+  constexpr uint8_t OP_READV_FIXED = 60;
+  constexpr uint8_t OP_WRITEV_FIXED = 61;
+
+  constexpr uint32_t REGISTER_RING_FDS = 20;
+
+  // The kernel completes SQEs with an unknown opcode with -EINVAL, without reading the rest of the SQE
+  constexpr uint8_t INVALID_OPCODE = 0xFF;
+
+  // The kernel rejects larger buffer tables without reading them
+  constexpr uint32_t MAX_REGISTERED_BUFFERS = 1U << 14;
+
+  // What the guest set up, and where the guest mapped the submission ring and SQE array
+  struct RingState {
+    // Identifies the ring across fds the guest duplicated
+    uint64_t Id;
+    uint32_t SetupFlags;
+    uint32_t Entries;
+    io_sqring_offsets SQOffsets;
+
+    uintptr_t SQRing;
+    size_t SQRingSize;
+    uintptr_t SQEs;
+    size_t SQEsSize;
+
+    size_t SQESize() const {
+      return SetupFlags & IORING_SETUP_SQE128 ? 128 : 64;
+    }
+
+    // Both mappings exist and cover everything the kernel reads while submitting
+    bool IsMapped() const {
+      if (!SQRing || !SQEs) {
+        return false;
+      }
+
+      size_t RingEnd = std::max(SQOffsets.head, SQOffsets.tail) + sizeof(uint32_t);
+      if (!(SetupFlags & IORING_SETUP_NO_SQARRAY)) {
+        RingEnd = std::max<size_t>(RingEnd, SQOffsets.array + Entries * sizeof(uint32_t));
+      }
+
+      return RingEnd <= SQRingSize && Entries * SQESize() <= SQEsSize;
+    }
+  };
+
+  std::mutex RingsMutex;
+  fextl::unordered_map<int, RingState> Rings;
+  uint64_t NextRingId{};
+  // Lets the mmap and close hooks skip the lock for guests that never set up an io_uring
+  std::atomic<bool> HasRings{};
+
+  void ForgetFDs(unsigned int First, unsigned int Last) {
+    if (!HasRings.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    std::lock_guard lk(RingsMutex);
+    std::erase_if(Rings, [First, Last](const auto &Ring) {
+      return Ring.first >= 0 && static_cast<unsigned int>(Ring.first) >= First && static_cast<unsigned int>(Ring.first) <= Last;
+    });
+  }
+
+  io_uring_sqe *GetSQE(const RingState &Ring, uint32_t Position) {
+    uint32_t Index = Position & (Ring.Entries - 1);
+    if (!(Ring.SetupFlags & IORING_SETUP_NO_SQARRAY)) {
+      Index = reinterpret_cast<const uint32_t*>(Ring.SQRing + Ring.SQOffsets.array)[Index];
+    }
+
+    // The kernel drops out of range indices without reading an SQE
+    if (Index >= Ring.Entries) {
+      return nullptr;
+    }
+
+    return reinterpret_cast<io_uring_sqe*>(Ring.SQEs + Index * Ring.SQESize());
+  }
+
+  enum class Translation {
+    NONE,
+    // addr points to len iovecs
+    IOVEC,
+    // addr points to a msghdr
+    MSGHDR,
+    // addr points to an epoll_event
+    EPOLL_EVENT,
+    // The kernel writes a pointer sized structure back when the request completes, or reads one that isn't converted
+    UNSUPPORTED,
+  };
+
+  Translation GetTranslation(const io_uring_sqe *SQE) {
+    switch (SQE->opcode) {
+      case IORING_OP_READV:
+      case IORING_OP_WRITEV:
+      case OP_READV_FIXED:
+      case OP_WRITEV_FIXED:
+        return SQE->addr ? Translation::IOVEC : Translation::NONE;
+      case IORING_OP_SENDMSG:
+      case OP_SENDMSG_ZC: {
+        if (!SQE->addr) {
+          return Translation::NONE;
+        }
+        // Control messages need their headers resized, only plain data is converted
+        const auto *Header = reinterpret_cast<const msghdr32*>(SQE->addr);
+        return Header->msg_controllen ? Translation::UNSUPPORTED : Translation::MSGHDR;
+      }
+      case IORING_OP_RECVMSG:
+        // Writes the lengths and flags back to the msghdr on completion, which the guest reads without a syscall
+        return Translation::UNSUPPORTED;
+      case IORING_OP_EPOLL_CTL:
+        return SQE->addr && !EPOLL_EVENT_MATCHES_GUEST ? Translation::EPOLL_EVENT : Translation::NONE;
+      case OP_EPOLL_WAIT:
+        return EPOLL_EVENT_MATCHES_GUEST ? Translation::NONE : Translation::UNSUPPORTED;
+      case OP_WAITID:
+        return SQE->addr2 ? Translation::UNSUPPORTED : Translation::NONE;
+      default:
+        return Translation::NONE;
+    }
+  }
+
+  struct SavedSQE {
+    io_uring_sqe *SQE;
+    uint64_t Addr;
+    uint8_t Opcode;
+  };
+
+  /**
+   * @brief Submits the guest's pending SQEs with anything pointing at 32-bit structures converted
+   *
+   * SQEs that only hold flat buffers and fds pass through untouched, which covers most requests.
+   * The rest get their addr pointed at host copies for the duration of io_uring_enter.
+   * IORING_FEAT_SUBMIT_STABLE means the kernel doesn't read the copies after submitting,
+   * so every rewritten SQE is restored afterwards and the guest never sees a host pointer.
+   *
+   * @param Submit Called once the SQEs are rewritten, submits without waiting for completions and returns the syscall result
+   */
+  template<typename SubmitFn>
+  uint64_t SubmitTranslated(const RingState &Ring, uint32_t ToSubmit, SubmitFn &&Submit) {
+    const uint32_t Head = __atomic_load_n(reinterpret_cast<uint32_t*>(Ring.SQRing + Ring.SQOffsets.head), __ATOMIC_ACQUIRE);
+    const uint32_t Tail = __atomic_load_n(reinterpret_cast<uint32_t*>(Ring.SQRing + Ring.SQOffsets.tail), __ATOMIC_ACQUIRE);
+    const uint32_t Count = std::min({ToSubmit, Tail - Head, Ring.Entries});
+
+    // Sized up front so the host copies don't move while SQEs point at them
+    size_t NumIOVecs{};
+    size_t NumHeaders{};
+    size_t NumEvents{};
+    for (uint32_t i = 0; i < Count; ++i) {
+      const auto *SQE = GetSQE(Ring, Head + i);
+      if (!SQE) {
+        continue;
+      }
+
+      switch (GetTranslation(SQE)) {
+        case Translation::IOVEC:
+          NumIOVecs += SanitizeIOVecCount(SQE->len);
+          break;
+        case Translation::MSGHDR:
+          ++NumHeaders;
+          NumIOVecs += SanitizeIOVecCount(reinterpret_cast<const msghdr32*>(SQE->addr)->msg_iovlen);
+          break;
+        case Translation::EPOLL_EVENT:
+          ++NumEvents;
+          break;
+        default:
+          break;
+      }
+    }
+
+    ScratchArray<SavedSQE, 16> Saved(Count);
+    ScratchArray<iovec, 32> IOVecs(NumIOVecs);
+    ScratchArray<msghdr, 4> Headers(NumHeaders);
+    ScratchArray<epoll_event, 4> Events(NumEvents);
+
+    size_t NumSaved{};
+    size_t UsedIOVecs{};
+    size_t UsedHeaders{};
+    size_t UsedEvents{};
+
+    // Converts the guest's iovecs, or returns null when the guest changed the SQEs since they were sized
+    auto AllocateIOVecs = [&](const iovec32 *Guest, size_t Count) -> iovec* {
+      if (Count > NumIOVecs - UsedIOVecs) {
+        return nullptr;
+      }
+
+      iovec *Host = &IOVecs[UsedIOVecs];
+      ConvertIOVecToHost(Host, Guest, Count);
+      UsedIOVecs += Count;
+      return Host;
+    };
+
+    for (uint32_t i = 0; i < Count; ++i) {
+      auto *SQE = GetSQE(Ring, Head + i);
+      if (!SQE) {
+        continue;
+      }
+
+      const auto Type = GetTranslation(SQE);
+      if (Type == Translation::NONE) {
+        continue;
+      }
+
+      uint64_t HostAddr{};
+      switch (Type) {
+        case Translation::IOVEC: {
+          const auto *Guest = reinterpret_cast<const iovec32*>(SQE->addr);
+          HostAddr = reinterpret_cast<uint64_t>(AllocateIOVecs(Guest, SanitizeIOVecCount(SQE->len)));
+          break;
+        }
+        case Translation::MSGHDR: {
+          const auto *Guest = reinterpret_cast<const msghdr32*>(SQE->addr);
+          const size_t IOVecCount = SanitizeIOVecCount(Guest->msg_iovlen);
+          iovec *HostIOVecs = Guest->msg_iov ? AllocateIOVecs(Guest->msg_iov, IOVecCount) : nullptr;
+          if (UsedHeaders == NumHeaders || (Guest->msg_iov && !HostIOVecs)) {
+            break;
+          }
+
+          msghdr &Host = Headers[UsedHeaders++];
+          Host.msg_name = Guest->msg_name;
+          Host.msg_namelen = Guest->msg_namelen;
+          Host.msg_iov = HostIOVecs;
+          Host.msg_iovlen = Guest->msg_iovlen;
+          Host.msg_control = nullptr;
+          Host.msg_controllen = 0;
+          Host.msg_flags = Guest->msg_flags;
+          HostAddr = reinterpret_cast<uint64_t>(&Host);
+          break;
+        }
+        case Translation::EPOLL_EVENT: {
+          if (UsedEvents == NumEvents) {
+            break;
+          }
+
+          epoll_event &Host = Events[UsedEvents++];
+          Host = *reinterpret_cast<const epoll_event32*>(SQE->addr);
+          HostAddr = reinterpret_cast<uint64_t>(&Host);
+          break;
+        }
+        default:
+          break;
+      }
+
+      Saved[NumSaved++] = SavedSQE {
+        .SQE = SQE,
+        .Addr = SQE->addr,
+        .Opcode = SQE->opcode,
+      };
+
+      if (HostAddr) {
+        SQE->addr = HostAddr;
+      }
+      else {
+        SQE->opcode = INVALID_OPCODE;
+      }
+    }
+
+    const uint64_t Result = Submit();
+
+    for (size_t i = 0; i < NumSaved; ++i) {
+      Saved[i].SQE->addr = Saved[i].Addr;
+      Saved[i].SQE->opcode = Saved[i].Opcode;
+    }
+
+    return Result;
+  }
+
+  uint64_t Setup(uint32_t entries, io_uring_params *params) {
+    // SQPOLL consumes SQEs from a kernel thread, without an io_uring_enter to convert them in.
+    // NO_MMAP and REGISTERED_FD_ONLY leave no mapping or fd to find the ring by.
+    constexpr uint32_t UNSUPPORTED_FLAGS = IORING_SETUP_SQPOLL | IORING_SETUP_NO_MMAP | IORING_SETUP_REGISTERED_FD_ONLY;
+    if (params && (params->flags & UNSUPPORTED_FLAGS)) {
+      return -EINVAL;
+    }
+
+    uint64_t Result = ::syscall(SYSCALL_DEF(io_uring_setup), entries, params);
+    if (Result == -1) {
+      return -errno;
+    }
+
+    std::lock_guard lk(RingsMutex);
+    Rings.insert_or_assign(static_cast<int>(Result), RingState {
+      .Id = NextRingId++,
+      .SetupFlags = params->flags,
+      .Entries = params->sq_entries,
+      .SQOffsets = params->sq_off,
+    });
+    HasRings.store(true, std::memory_order_relaxed);
+
+    return Result;
+  }
+
+  uint64_t Enter(unsigned int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags, void *argp, size_t argsz) {
+    auto DoEnter = [&]() -> uint64_t {
+      uint64_t Result = ::syscall(SYSCALL_DEF(io_uring_enter), fd, to_submit, min_complete, flags, argp, argsz);
+      SYSCALL_ERRNO();
+    };
+
+    // Registered ring fds are refused, so an index from the guest never matches a ring and passes through
+    if (!to_submit || (flags & IORING_ENTER_REGISTERED_RING) || !HasRings.load(std::memory_order_relaxed)) {
+      return DoEnter();
+    }
+
+    RingState Ring;
+    {
+      std::lock_guard lk(RingsMutex);
+      auto it = Rings.find(fd);
+      if (it == Rings.end() || !it->second.IsMapped()) {
+        return DoEnter();
+      }
+      Ring = it->second;
+    }
+
+    // Submitting and waiting are separate calls, so the SQEs are restored before the guest could see any completion.
+    // Only waiting uses the extended argument, its timeout and signal mask.
+    const uint64_t Submitted = SubmitTranslated(Ring, to_submit, [&]() -> uint64_t {
+      uint64_t Result = ::syscall(SYSCALL_DEF(io_uring_enter), fd, to_submit, 0,
+                                  flags & ~(IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG), nullptr, 0);
+      SYSCALL_ERRNO();
+    });
+
+    // Like the kernel, only wait once everything was submitted
+    if (!(flags & IORING_ENTER_GETEVENTS) || Submitted != to_submit) {
+      return Submitted;
+    }
+
+    // The kernel returns the submission count over whatever waiting returned
+    ::syscall(SYSCALL_DEF(io_uring_enter), fd, 0, min_complete, flags, argp, argsz);
+    return Submitted;
+  }
+
+  uint64_t RegisterBuffers(unsigned int fd, unsigned int opcode, const iovec32 *Guest, uint32_t Count, void *arg, uint32_t nr_args, uint64_t *HostData) {
+    if (Count > MAX_REGISTERED_BUFFERS) {
+      return -EINVAL;
+    }
+
+    ScratchArray<iovec, 8> Host(Guest ? Count : 0);
+    if (Guest) {
+      ConvertIOVecToHost(Host.data(), Guest, Count);
+    }
+
+    if (HostData) {
+      *HostData = Guest ? reinterpret_cast<uint64_t>(Host.data()) : 0;
+    }
+    else {
+      arg = Guest ? Host.data() : nullptr;
+    }
+
+    uint64_t Result = ::syscall(SYSCALL_DEF(io_uring_register), fd, opcode, arg, nr_args);
+    SYSCALL_ERRNO();
+  }
+
+  uint64_t Register(unsigned int fd, unsigned int opcode, void *arg, uint32_t nr_args) {
+    switch (opcode & ~IORING_REGISTER_USE_REGISTERED_RING) {
+      case IORING_REGISTER_BUFFERS:
+        return RegisterBuffers(fd, opcode, reinterpret_cast<const iovec32*>(arg), nr_args, arg, nr_args, nullptr);
+      case IORING_REGISTER_BUFFERS2: {
+        if (!arg || nr_args != sizeof(io_uring_rsrc_register)) {
+          break;
+        }
+
+        auto HostRegister = *reinterpret_cast<const io_uring_rsrc_register*>(arg);
+        if (HostRegister.flags & IORING_RSRC_REGISTER_SPARSE) {
+          break;
+        }
+
+        return RegisterBuffers(fd, opcode, reinterpret_cast<const iovec32*>(HostRegister.data), HostRegister.nr, &HostRegister, nr_args, &HostRegister.data);
+      }
+      case IORING_REGISTER_BUFFERS_UPDATE: {
+        if (!arg || nr_args != sizeof(io_uring_rsrc_update2)) {
+          break;
+        }
+
+        auto HostUpdate = *reinterpret_cast<const io_uring_rsrc_update2*>(arg);
+        return RegisterBuffers(fd, opcode, reinterpret_cast<const iovec32*>(HostUpdate.data), HostUpdate.nr, &HostUpdate, nr_args, &HostUpdate.data);
+      }
+      case REGISTER_RING_FDS:
+        // io_uring_enter would get a ring index instead of an fd, and there would be no way to find the guest's mappings
+        return -EINVAL;
+      default:
+        break;
+    }
+
+    // Everything else is made of fds and 64-bit fields that match between guest and host
+    uint64_t Result = ::syscall(SYSCALL_DEF(io_uring_register), fd, opcode, arg, nr_args);
+    SYSCALL_ERRNO();
+  }
+}
+
+  void TrackMmap(uintptr_t Base, size_t Length, int fd, off_t Offset) {
+    if (fd < 0 || (Offset != IORING_OFF_SQ_RING && Offset != IORING_OFF_SQES) || !HasRings.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    std::lock_guard lk(RingsMutex);
+    auto it = Rings.find(fd);
+    if (it == Rings.end()) {
+      return;
+    }
+
+    const uint64_t Id = it->second.Id;
+    for (auto &[RingFD, State] : Rings) {
+      if (State.Id != Id) {
+        continue;
+      }
+
+      if (Offset == IORING_OFF_SQ_RING) {
+        State.SQRing = Base;
+        State.SQRingSize = Length;
+      }
+      else {
+        State.SQEs = Base;
+        State.SQEsSize = Length;
+      }
+    }
+  }
+
+  void TrackMunmap(uintptr_t Base, size_t Length) {
+    if (!HasRings.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    auto Overlaps = [Base, Length](uintptr_t MapBase, size_t MapLength) {
+      return MapBase && MapBase < Base + Length && Base < MapBase + MapLength;
+    };
+
+    std::lock_guard lk(RingsMutex);
+    for (auto &[RingFD, State] : Rings) {
+      if (Overlaps(State.SQRing, State.SQRingSize)) {
+        State.SQRing = 0;
+      }
+
+      if (Overlaps(State.SQEs, State.SQEsSize)) {
+        State.SQEs = 0;
+      }
+    }
+  }
+
+  void TrackMremap(uintptr_t OldBase, size_t OldLength, uintptr_t NewBase, size_t NewLength) {
+    if (!HasRings.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    // Mappings keep their offset into the range, and lose whatever a shrink cut off
+    auto Move = [=](uintptr_t &MapBase, size_t &MapLength) {
+      if (!MapBase || MapBase >= OldBase + OldLength || OldBase >= MapBase + MapLength) {
+        return;
+      }
+
+      const uintptr_t Offset = MapBase - OldBase;
+      if (MapBase < OldBase || MapBase + MapLength > OldBase + OldLength || Offset >= NewLength) {
+        // Only partly moved, or shrunk away
+        MapBase = 0;
+        return;
+      }
+
+      // The kernel marks the rings VM_DONTEXPAND, so they only ever move or shrink
+      MapBase = NewBase + Offset;
+      MapLength = std::min(MapLength, NewLength - Offset);
+    };
+
+    std::lock_guard lk(RingsMutex);
+    for (auto &[RingFD, State] : Rings) {
+      Move(State.SQRing, State.SQRingSize);
+      Move(State.SQEs, State.SQEsSize);
+    }
+  }
+
+  void TrackFDDuplication(int fd, int NewFD) {
+    if (!HasRings.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    std::lock_guard lk(RingsMutex);
+    auto it = Rings.find(fd);
+    if (it == Rings.end()) {
+      Rings.erase(NewFD);
+      return;
+    }
+
+    const RingState Alias = it->second;
+    Rings.insert_or_assign(NewFD, Alias);
+  }
+
+  void TrackClose(int fd) {
+    ForgetFDs(fd, fd);
+  }
+
+  void TrackCloseRange(unsigned int first, unsigned int last) {
+    ForgetFDs(first, last);
+  }
+}
+
+namespace FEX::HLE::x32 {
+  void RegisterIOUring(FEX::HLE::SyscallHandler *Handler) {
+    using namespace FEXCore::IR;
+
+    // The SQEs are converted in place, which needs the kernel to be done with them once io_uring_enter returns
+    if (Handler->IsHostKernelVersionAtLeast(5, 5, 0)) {
+      REGISTER_SYSCALL_IMPL_X32_FLAGS(io_uring_setup, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+        [](FEXCore::Core::CpuStateFrame *Frame, uint32_t entries, void* params) -> uint64_t {
+        return IOUring::Setup(entries, reinterpret_cast<io_uring_params*>(params));
+      });
+
+      REGISTER_SYSCALL_IMPL_X32_FLAGS(io_uring_enter, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+        [](FEXCore::Core::CpuStateFrame *Frame, unsigned int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags, void *argp, size_t argsz) -> uint64_t {
+        return IOUring::Enter(fd, to_submit, min_complete, flags, argp, argsz);
+      });
+
+      REGISTER_SYSCALL_IMPL_X32_FLAGS(io_uring_register, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+        [](FEXCore::Core::CpuStateFrame *Frame, unsigned int fd, unsigned int opcode, void *arg, uint32_t nr_args) -> uint64_t {
+        return IOUring::Register(fd, opcode, arg, nr_args);
+      });
+    }
+    else {
+      REGISTER_SYSCALL_IMPL_X32(io_uring_setup, UnimplementedSyscallSafe);
+      REGISTER_SYSCALL_IMPL_X32(io_uring_enter, UnimplementedSyscallSafe);
+      REGISTER_SYSCALL_IMPL_X32(io_uring_register, UnimplementedSyscallSafe);
+    }
+  }
+}
@@ -0,0 +1,33 @@
+/*
+$info$
+tags: LinuxSyscalls|syscalls-x86-32
+$end_info$
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace FEX::HLE::x32::IOUring {
+  /**
+   * @brief Records where the guest mapped the submission ring or SQE array of one of its io_urings
+   *
+   * io_uring_enter translates the guest's SQEs through these mappings.
+   */
+  void TrackMmap(uintptr_t Base, size_t Length, int fd, off_t Offset);
+
+  // Forgets any io_uring mappings overlapping the unmapped range
+  void TrackMunmap(uintptr_t Base, size_t Length);
+
+  // Moves io_uring mappings inside the remapped range along with it
+  void TrackMremap(uintptr_t OldBase, size_t OldLength, uintptr_t NewBase, size_t NewLength);
+
+  // Makes NewFD refer to the same ring as fd, or to no ring when fd isn't one
+  void TrackFDDuplication(int fd, int NewFD);
+
+  // Forgets the rings behind fds that are closed or replaced, before the fd number can be reused
+  void TrackClose(int fd);
+  void TrackCloseRange(unsigned int first, unsigned int last);
+}
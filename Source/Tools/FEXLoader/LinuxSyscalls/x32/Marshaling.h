@@ -0,0 +1,232 @@
+/*
+$info$
+tags: LinuxSyscalls|syscalls-x86-32
+$end_info$
+*/
+
+#pragma once
+
+#include "LinuxSyscalls/x32/Types.h"
+
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits.h>
+#include <sys/epoll.h>
+#include <sys/select.h>
+#include <sys/uio.h>
+#include <type_traits>
+
+namespace FEX::HLE::x32 {
+  /**
+   * @brief Scratch storage for converting guest arrays to their host layout
+   *
+   * Arrays of up to InlineCount elements live on the stack.
+   * Larger arrays use a per-thread buffer that grows to the largest size the thread has needed,
+   * so event loops calling the same syscall over and over don't allocate.
+   *
+   * The contents are uninitialized. A nested user of the same buffer, like a syscall from a signal handler,
+   * gets its own allocation instead.
+   */
+  template<typename T, size_t InlineCount>
+  class ScratchArray final {
+    static_assert(std::is_trivial_v<T>, "Scratch arrays are never constructed");
+
+  public:
+    explicit ScratchArray(size_t Count) {
+      if (Count <= InlineCount) {
+        Data = Inline;
+        return;
+      }
+
+      auto &Thread = ThreadBuffer;
+      if (!Thread.InUse && Count <= MAX_RETAINED_SIZE / sizeof(T)) {
+        if (Thread.Storage.size() < Count) {
+          Thread.Storage.resize(Count);
+        }
+
+        Thread.InUse = true;
+        OwnsThreadBuffer = true;
+        Data = Thread.Storage.data();
+      }
+      else {
+        Temporary.resize(Count);
+        Data = Temporary.data();
+      }
+    }
+
+    ~ScratchArray() {
+      if (OwnsThreadBuffer) {
+        ThreadBuffer.InUse = false;
+      }
+    }
+
+    ScratchArray(const ScratchArray&) = delete;
+    ScratchArray &operator=(const ScratchArray&) = delete;
+
+    T *data() { return Data; }
+    T &operator[](size_t idx) { return Data[idx]; }
+
+  private:
+    // Anything larger is allocated per call instead of being held on to for the lifetime of the thread
+    constexpr static size_t MAX_RETAINED_SIZE = 1024 * 1024;
+
+    struct ThreadStorage {
+      fextl::vector<T> Storage;
+      bool InUse;
+    };
+    static inline thread_local ThreadStorage ThreadBuffer{};
+
+    T Inline[InlineCount];
+    T *Data;
+    bool OwnsThreadBuffer{};
+    fextl::vector<T> Temporary;
+  };
+
+  // The kernel rejects any larger count without reading the array, so there is no need to convert more
+  constexpr size_t SanitizeIOVecCount(int64_t Count) {
+    return std::clamp<int64_t>(Count, 0, UIO_MAXIOV);
+  }
+
+  /**
+   * @brief Converts an array of guest iovecs to the host layout
+   *
+   * Both layouts are a pair of words per iovec, so this is only a zero extension of each 32-bit word.
+   * Kept as a flat loop of fixed size copies so the compiler vectorizes it.
+   */
+  inline void ConvertIOVecToHost(iovec *Host, const iovec32 *Guest, size_t Count) {
+    static_assert(sizeof(iovec32) == sizeof(uint32_t) * 2);
+    static_assert(sizeof(iovec) == sizeof(uint64_t) * 2);
+
+    for (size_t i = 0; i < Count; ++i) {
+      uint32_t Narrow[2];
+      memcpy(Narrow, &Guest[i], sizeof(Narrow));
+      const uint64_t Wide[2] = {Narrow[0], Narrow[1]};
+      memcpy(&Host[i], Wide, sizeof(Wide));
+    }
+  }
+
+  // Guest iovecs converted to a host array, for the readv family of syscalls
+  template<size_t InlineCount = 8>
+  class HostIOVec final {
+  public:
+    HostIOVec(const iovec32 *Guest, int64_t Count)
+      : Array {SanitizeIOVecCount(Count)}
+      , IsNull {Guest == nullptr} {
+      if (Guest) {
+        ConvertIOVecToHost(Array.data(), Guest, SanitizeIOVecCount(Count));
+      }
+    }
+
+    // A null guest array stays null so the kernel returns EFAULT
+    iovec *data() { return IsNull ? nullptr : Array.data(); }
+
+  private:
+    ScratchArray<iovec, InlineCount> Array;
+    bool IsNull;
+  };
+
+  // The x86-64 epoll_event is packed and matches the 32-bit layout, other hosts pad it to 16 bytes
+  constexpr bool EPOLL_EVENT_MATCHES_GUEST = sizeof(epoll_event) == sizeof(epoll_event32);
+
+  /**
+   * @brief Converts an array of host epoll events to the packed guest layout
+   *
+   * On hosts with the padded layout this drops the padding word of every event,
+   * which the compiler turns in to interleaved loads and stores.
+   */
+  inline void ConvertEPollEventsToGuest(epoll_event32 *Guest, const epoll_event *Host, size_t Count) {
+    if constexpr (EPOLL_EVENT_MATCHES_GUEST) {
+      memcpy(Guest, Host, Count * sizeof(epoll_event32));
+    }
+    else {
+      for (size_t i = 0; i < Count; ++i) {
+        uint32_t Words[3];
+        Words[0] = Host[i].events;
+        memcpy(&Words[1], &Host[i].data.u64, sizeof(uint64_t));
+        memcpy(&Guest[i], Words, sizeof(Words));
+      }
+    }
+  }
+
+  /**
+   * @brief Waits for epoll events on a host event array and copies them to the guest
+   *
+   * @param Wait Called with the host event array, returns the syscall result
+   */
+  template<typename WaitFn>
+  uint64_t WaitForEPollEvents(compat_ptr<epoll_event32> events, int maxevents, WaitFn &&Wait) {
+    if constexpr (EPOLL_EVENT_MATCHES_GUEST) {
+      // The kernel can write straight in to the guest's array
+      epoll_event32 *GuestEvents = events;
+      return Wait(reinterpret_cast<epoll_event*>(GuestEvents));
+    }
+    else {
+      ScratchArray<epoll_event, 32> Events(std::max(0, maxevents));
+      uint64_t Result = Wait(Events.data());
+
+      if (Result != -1) {
+        ConvertEPollEventsToGuest(events, Events.data(), Result);
+      }
+      return Result;
+    }
+  }
+
+  /**
+   * @brief Host copies of the guest's select fd sets
+   *
+   * A guest fd_set is an array of 32-bit words and a host fd_set an array of 64-bit words.
+   * On little-endian both have fd N at bit N % 8 of byte N / 8, so converting is a copy of the words that cover nfds.
+   * Sized by nfds rather than FD_SETSIZE, so programs with more than 1024 fds work too.
+   */
+  class HostFDSets final {
+  public:
+    HostFDSets(int nfds, fd_set32 *readfds, fd_set32 *writefds, fd_set32 *exceptfds)
+      : GuestWords {static_cast<size_t>((std::max(0, nfds) + 31) / 32)}
+      , HostWords {(GuestWords + 1) / 2}
+      , Guest {readfds, writefds, exceptfds}
+      , Storage {HostWords * NUM_SETS} {
+      for (size_t i = 0; i < NUM_SETS; ++i) {
+        if (Guest[i] && HostWords) {
+          // Clears the upper half of the last host word when the guest set ends halfway through it
+          Storage[i * HostWords + HostWords - 1] = 0;
+          memcpy(&Storage[i * HostWords], Guest[i], GuestWords * sizeof(fd_set32));
+        }
+      }
+    }
+
+    fd_set *Read() { return Get(0); }
+    fd_set *Write() { return Get(1); }
+    fd_set *Except() { return Get(2); }
+
+    // The kernel writes back every word that covers nfds, so the guest gets the same
+    void CopyToGuest() {
+      for (size_t i = 0; i < NUM_SETS; ++i) {
+        if (Guest[i]) {
+          memcpy(Guest[i], &Storage[i * HostWords], GuestWords * sizeof(fd_set32));
+        }
+      }
+    }
+
+  private:
+    constexpr static size_t NUM_SETS = 3;
+
+    fd_set *Get(size_t Set) {
+      if (!Guest[Set]) {
+        return nullptr;
+      }
+
+      // An fd_set sized array can be larger than the storage, but the kernel only accesses the words that cover nfds
+      return reinterpret_cast<fd_set*>(&Storage[Set * HostWords]);
+    }
+
+    size_t GuestWords;
+    size_t HostWords;
+    fd_set32 *Guest[NUM_SETS];
+    // Covers FD_SETSIZE fds without touching the heap
+    ScratchArray<uint64_t, NUM_SETS * FD_SETSIZE / 64> Storage;
+  };
+}
@@ -5,6 +5,7 @@ $end_info$
 */
 
 #include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/x32/IOUring.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 #include <FEXCore/Core/Context.h>
@@ -29,6 +30,7 @@ namespace FEX::HLE::x32 {
 
     if (!FEX::HLE::HasSyscallError(Result)) {
       FEX::HLE::_SyscallHandler->TrackMmap(Thread, Result, length, prot, flags, fd, offset);
+      FEX::HLE::x32::IOUring::TrackMmap(Result, length, fd, offset);
       return (void *)Result;
     } else {
       errno = -Result;
@@ -44,6 +46,7 @@ namespace FEX::HLE::x32 {
 
     if (Result == 0) {
       FEX::HLE::_SyscallHandler->TrackMunmap(Thread, (uintptr_t)addr, length);
+      FEX::HLE::x32::IOUring::TrackMunmap((uintptr_t)addr, length);
       return Result;
     } else {
       errno = -Result;
@@ -96,6 +99,7 @@ namespace FEX::HLE::x32 {
 
       if (!FEX::HLE::HasSyscallError(Result)) {
         FEX::HLE::_SyscallHandler->TrackMremap(Frame->Thread, (uintptr_t)old_address, old_size, new_size, flags, Result);
+        FEX::HLE::x32::IOUring::TrackMremap((uintptr_t)old_address, old_size, Result, new_size);
       }
 
       return Result;
@@ -5,13 +5,14 @@ $end_info$
 */
 
 #include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/x32/Marshaling.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/Types.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 
 #include <FEXCore/Utils/LogManager.h>
-#include <FEXCore/fextl/vector.h>
 
+#include <algorithm>
 #include <alloca.h>
 #include <cstdint>
 #include <cstring>
@@ -123,10 +124,7 @@ namespace FEX::HLE::x32 {
 
   static uint64_t SendMsg(int sockfd, const struct msghdr32 *msg, int flags) {
     struct msghdr HostHeader{};
-    fextl::vector<iovec> Host_iovec(msg->msg_iovlen);
-    for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-      Host_iovec[i] = msg->msg_iov[i];
-    }
+    HostIOVec Host_iovec(msg->msg_iov, msg->msg_iovlen);
 
     HostHeader.msg_name = msg->msg_name;
     HostHeader.msg_namelen = msg->msg_namelen;
@@ -179,10 +177,7 @@ namespace FEX::HLE::x32 {
 
   static uint64_t RecvMsg(int sockfd, struct msghdr32 *msg, int flags) {
     struct msghdr HostHeader{};
-    fextl::vector<iovec> Host_iovec(msg->msg_iovlen);
-    for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-      Host_iovec[i] = msg->msg_iov[i];
-    }
+    HostIOVec Host_iovec(msg->msg_iov, msg->msg_iovlen);
 
     HostHeader.msg_name = msg->msg_name;
     HostHeader.msg_namelen = msg->msg_namelen;
@@ -197,10 +192,7 @@ namespace FEX::HLE::x32 {
 
     uint64_t Result = ::recvmsg(sockfd, &HostHeader, flags);
     if (Result != -1) {
-      for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-        msg->msg_iov[i] = Host_iovec[i];
-      }
-
+      // The kernel doesn't write to the iovec array, so it doesn't need to be copied back
       msg->msg_namelen = HostHeader.msg_namelen;
       msg->msg_controllen = HostHeader.msg_controllen;
       msg->msg_flags = HostHeader.msg_flags;
@@ -238,31 +230,26 @@ namespace FEX::HLE::x32 {
     SYSCALL_ERRNO();
   }
 
-  void ConvertHeaderToHost(fextl::vector<iovec> &iovec, struct msghdr *Host, const struct msghdr32 *Guest) {
-    size_t CurrentIOVecSize = iovec.size();
-    iovec.resize(CurrentIOVecSize + Guest->msg_iovlen);
-    for (size_t i = 0; i < Guest->msg_iovlen; ++i) {
-      iovec[CurrentIOVecSize + i] = Guest->msg_iov[i];
+  // Iovecs and control are sized by the caller for the guest's msg_iovlen and twice the guest's msg_controllen
+  static void ConvertHeaderToHost(iovec *Host_iovec, void *Control, struct msghdr *Host, const struct msghdr32 *Guest) {
+    if (Guest->msg_iov) {
+      ConvertIOVecToHost(Host_iovec, Guest->msg_iov, SanitizeIOVecCount(Guest->msg_iovlen));
     }
 
     Host->msg_name = Guest->msg_name;
     Host->msg_namelen = Guest->msg_namelen;
 
-    Host->msg_iov = &iovec[CurrentIOVecSize];
+    Host->msg_iov = Guest->msg_iov ? Host_iovec : nullptr;
     Host->msg_iovlen = Guest->msg_iovlen;
 
-    // XXX: This could result in a stack overflow
-    Host->msg_control = alloca(Guest->msg_controllen*2);
+    Host->msg_control = Control;
     Host->msg_controllen = Guest->msg_controllen*2;
 
     Host->msg_flags = Guest->msg_flags;
   }
 
-  void ConvertHeaderToGuest(struct msghdr32 *Guest, struct msghdr *Host) {
-    for (size_t i = 0; i < Guest->msg_iovlen; ++i) {
-      Guest->msg_iov[i] = Host->msg_iov[i];
-    }
-
+  static void ConvertHeaderToGuest(struct msghdr32 *Guest, struct msghdr *Host) {
+    // The kernel doesn't write to the iovec array, so it doesn't need to be copied back
     Guest->msg_namelen = Host->msg_namelen;
     Guest->msg_controllen = Host->msg_controllen;
     Guest->msg_flags = Host->msg_flags;
@@ -299,11 +286,30 @@ namespace FEX::HLE::x32 {
   }
 
   static uint64_t RecvMMsg(int sockfd, compat_ptr<mmsghdr_32> msgvec, uint32_t vlen, int flags, struct timespec *timeout_ts) {
-    fextl::vector<iovec> Host_iovec;
-    fextl::vector<struct mmsghdr> HostMHeader(vlen);
+    // The kernel handles at most UIO_MAXIOV messages per call
+    vlen = std::min<uint32_t>(vlen, UIO_MAXIOV);
+
+    // Everything is sized up front so the host headers can point in to the arrays
+    size_t NumIOVecs{};
+    size_t ControlSize{};
+    for (size_t i = 0; i < vlen; ++i) {
+      NumIOVecs += SanitizeIOVecCount(msgvec[i].msg_hdr.msg_iovlen);
+      ControlSize += msgvec[i].msg_hdr.msg_controllen * 2;
+    }
+
+    ScratchArray<struct mmsghdr, 8> HostMHeader(vlen);
+    ScratchArray<iovec, 16> Host_iovec(NumIOVecs);
+    ScratchArray<uint8_t, 256> Control(ControlSize);
+
+    size_t CurrentIOVec{};
+    size_t CurrentControl{};
     for (size_t i = 0; i < vlen; ++i) {
-      ConvertHeaderToHost(Host_iovec, &HostMHeader[i].msg_hdr, &msgvec[i].msg_hdr);
+      const msghdr32 &Guest = msgvec[i].msg_hdr;
+      ConvertHeaderToHost(&Host_iovec[CurrentIOVec], &Control[CurrentControl], &HostMHeader[i].msg_hdr, &Guest);
       HostMHeader[i].msg_len = msgvec[i].msg_len;
+
+      CurrentIOVec += SanitizeIOVecCount(Guest.msg_iovlen);
+      CurrentControl += Guest.msg_controllen * 2;
     }
     uint64_t Result = ::recvmmsg(sockfd, HostMHeader.data(), vlen, flags, timeout_ts);
     if (Result != -1) {
@@ -315,6 +321,101 @@ namespace FEX::HLE::x32 {
     SYSCALL_ERRNO();
   }
 
+  static uint64_t SendMMsg(int sockfd, compat_ptr<mmsghdr_32> msgvec, uint32_t vlen, int flags) {
+    // The kernel handles at most UIO_MAXIOV messages per call
+    vlen = std::min<uint32_t>(vlen, UIO_MAXIOV);
+
+    // Calculate the number of iovecs and controllen first so nothing has to grow while converting
+    size_t NumIOVecs{};
+    size_t Controllen_size{};
+    for (size_t i = 0; i < vlen; ++i) {
+      msghdr32 &guest = msgvec[i].msg_hdr;
+
+      Controllen_size += guest.msg_controllen * 2;
+      NumIOVecs += SanitizeIOVecCount(guest.msg_iovlen);
+    }
+
+    ScratchArray<struct mmsghdr, 8> HostMmsg(vlen);
+    ScratchArray<iovec, 16> Host_iovec(NumIOVecs);
+    ScratchArray<uint8_t, 256> Controllen(Controllen_size);
+    memset(Controllen.data(), 0, Controllen_size);
+
+    size_t current_iov{};
+    size_t current_controllen_offset{};
+    for (size_t i = 0; i < vlen; ++i) {
+      msghdr32 &guest = msgvec[i].msg_hdr;
+      struct msghdr &msg = HostMmsg[i].msg_hdr;
+      msg.msg_name = guest.msg_name;
+      msg.msg_namelen = guest.msg_namelen;
+
+      if (guest.msg_iov) {
+        ConvertIOVecToHost(&Host_iovec[current_iov], guest.msg_iov, SanitizeIOVecCount(guest.msg_iovlen));
+        msg.msg_iov = &Host_iovec[current_iov];
+      }
+      else {
+        msg.msg_iov = nullptr;
+      }
+      msg.msg_iovlen = guest.msg_iovlen;
+      current_iov += SanitizeIOVecCount(guest.msg_iovlen);
+
+      msg.msg_control = nullptr;
+      if (guest.msg_controllen) {
+        msg.msg_control = &Controllen[current_controllen_offset];
+        current_controllen_offset += guest.msg_controllen * 2;
+      }
+      msg.msg_controllen = guest.msg_controllen;
+
+      msg.msg_flags = guest.msg_flags;
+
+      if (msg.msg_controllen) {
+        void *CurrentGuestPtr = guest.msg_control;
+        struct cmsghdr *CurrentHost = reinterpret_cast<struct cmsghdr*>(msg.msg_control);
+
+        for (cmsghdr32 *msghdr_guest = reinterpret_cast<cmsghdr32*>(CurrentGuestPtr);
+            CurrentGuestPtr != 0;
+            msghdr_guest = reinterpret_cast<cmsghdr32*>(CurrentGuestPtr)) {
+
+          CurrentHost->cmsg_level = msghdr_guest->cmsg_level;
+          CurrentHost->cmsg_type = msghdr_guest->cmsg_type;
+
+          if (msghdr_guest->cmsg_len) {
+            size_t SizeIncrease = (CMSG_LEN(0) - sizeof(cmsghdr32));
+            CurrentHost->cmsg_len = msghdr_guest->cmsg_len + SizeIncrease;
+            msg.msg_controllen += SizeIncrease;
+            memcpy(CMSG_DATA(CurrentHost), msghdr_guest->cmsg_data, msghdr_guest->cmsg_len - sizeof(cmsghdr32));
+          }
+
+          // Go to next host
+          CurrentHost = CMSG_NXTHDR(&msg, CurrentHost);
+
+          // Go to next msg
+          if (msghdr_guest->cmsg_len < sizeof(cmsghdr32)) {
+            CurrentGuestPtr = nullptr;
+          }
+          else {
+            CurrentGuestPtr = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(CurrentGuestPtr) + msghdr_guest->cmsg_len);
+            CurrentGuestPtr = reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(CurrentGuestPtr) + 3) & ~3ULL);
+            if (CurrentGuestPtr >= reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(static_cast<void*>(guest.msg_control)) + guest.msg_controllen)) {
+              CurrentGuestPtr = nullptr;
+            }
+          }
+        }
+      }
+
+      HostMmsg[i].msg_len = msgvec[i].msg_len;
+    }
+
+    uint64_t Result = ::sendmmsg(sockfd, HostMmsg.data(), vlen, flags);
+
+    if (Result != -1) {
+      // Update guest msglen
+      for (size_t i = 0; i < Result; ++i) {
+        msgvec[i].msg_len = HostMmsg[i].msg_len;
+      }
+    }
+    SYSCALL_ERRNO();
+  }
+
   static uint64_t SetSockOpt(int sockfd, int level, int optname, compat_ptr<void> optval, int optlen) {
     uint64_t Result{};
 
@@ -697,91 +798,7 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(sendmmsg, [](FEXCore::Core::CpuStateFrame *Frame, int sockfd, compat_ptr<mmsghdr_32> msgvec, uint32_t vlen, int flags) -> uint64_t {
-      fextl::vector<iovec> Host_iovec;
-      fextl::vector<struct mmsghdr> HostMmsg(vlen);
-
-      // Walk the iovec and convert them
-      // Calculate controllen at the same time
-      size_t Controllen_size{};
-      for (size_t i = 0; i < vlen; ++i) {
-        msghdr32 &guest = msgvec[i].msg_hdr;
-
-        Controllen_size += guest.msg_controllen * 2;
-        for (size_t j = 0; j < guest.msg_iovlen; ++j) {
-          iovec guest_iov = guest.msg_iov[j];
-          Host_iovec.emplace_back(guest_iov);
-        }
-      }
-
-      fextl::vector<uint8_t> Controllen(Controllen_size);
-
-      size_t current_iov{};
-      size_t current_controllen_offset{};
-      for (size_t i = 0; i < vlen; ++i) {
-        msghdr32 &guest = msgvec[i].msg_hdr;
-        struct msghdr &msg = HostMmsg[i].msg_hdr;
-        msg.msg_name = guest.msg_name;
-        msg.msg_namelen = guest.msg_namelen;
-
-        msg.msg_iov = &Host_iovec.at(current_iov);
-        msg.msg_iovlen = guest.msg_iovlen;
-        current_iov += msg.msg_iovlen;
-
-        if (guest.msg_controllen) {
-          msg.msg_control = &Controllen.at(current_controllen_offset);
-          current_controllen_offset += guest.msg_controllen * 2;
-        }
-        msg.msg_controllen = guest.msg_controllen;
-
-        msg.msg_flags = guest.msg_flags;
-
-        if (msg.msg_controllen) {
-          void *CurrentGuestPtr = guest.msg_control;
-          struct cmsghdr *CurrentHost = reinterpret_cast<struct cmsghdr*>(msg.msg_control);
-
-          for (cmsghdr32 *msghdr_guest = reinterpret_cast<cmsghdr32*>(CurrentGuestPtr);
-              CurrentGuestPtr != 0;
-              msghdr_guest = reinterpret_cast<cmsghdr32*>(CurrentGuestPtr)) {
-
-            CurrentHost->cmsg_level = msghdr_guest->cmsg_level;
-            CurrentHost->cmsg_type = msghdr_guest->cmsg_type;
-
-            if (msghdr_guest->cmsg_len) {
-              size_t SizeIncrease = (CMSG_LEN(0) - sizeof(cmsghdr32));
-              CurrentHost->cmsg_len = msghdr_guest->cmsg_len + SizeIncrease;
-              msg.msg_controllen += SizeIncrease;
-              memcpy(CMSG_DATA(CurrentHost), msghdr_guest->cmsg_data, msghdr_guest->cmsg_len - sizeof(cmsghdr32));
-            }
-
-            // Go to next host
-            CurrentHost = CMSG_NXTHDR(&msg, CurrentHost);
-
-            // Go to next msg
-            if (msghdr_guest->cmsg_len < sizeof(cmsghdr32)) {
-              CurrentGuestPtr = nullptr;
-            }
-            else {
-              CurrentGuestPtr = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(CurrentGuestPtr) + msghdr_guest->cmsg_len);
-              CurrentGuestPtr = reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(CurrentGuestPtr) + 3) & ~3ULL);
-              if (CurrentGuestPtr >= reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(static_cast<void*>(guest.msg_control)) + guest.msg_controllen)) {
-                CurrentGuestPtr = nullptr;
-              }
-            }
-          }
-        }
-
-        HostMmsg[i].msg_len = msgvec[i].msg_len;
-      }
-
-      uint64_t Result = ::sendmmsg(sockfd, HostMmsg.data(), vlen, flags);
-
-      if (Result != -1) {
-        // Update guest msglen
-        for (size_t i = 0; i < Result; ++i) {
-          msgvec[i].msg_len = HostMmsg[i].msg_len;
-        }
-      }
-      SYSCALL_ERRNO();
+      return SendMMsg(sockfd, msgvec, vlen, flags);
     });
 
     REGISTER_SYSCALL_IMPL_X32(recvmmsg, [](FEXCore::Core::CpuStateFrame *Frame, int sockfd, compat_ptr<mmsghdr_32> msgvec, uint32_t vlen, int flags, timespec32 *timeout_ts) -> uint64_t {
@@ -28,6 +28,7 @@ namespace FEX::HLE::x32 {
   void RegisterFS(FEX::HLE::SyscallHandler *Handler);
   void RegisterInfo(FEX::HLE::SyscallHandler *Handler);
   void RegisterIO(FEX::HLE::SyscallHandler *Handler);
+  void RegisterIOUring(FEX::HLE::SyscallHandler *Handler);
   void RegisterMemory(FEX::HLE::SyscallHandler *Handler);
   void RegisterMsg(FEX::HLE::SyscallHandler *Handler);
   void RegisterNotImplemented(FEX::HLE::SyscallHandler *Handler);
@@ -66,7 +67,6 @@ namespace FEX::HLE::x32 {
     FEX::HLE::RegisterFS(this);
     FEX::HLE::RegisterInfo(this);
     FEX::HLE::RegisterIO(this);
-    FEX::HLE::RegisterIOUring(this);
     FEX::HLE::RegisterKey(this);
     FEX::HLE::RegisterMemory(this);
     FEX::HLE::RegisterMsg(this);
@@ -88,6 +88,7 @@ namespace FEX::HLE::x32 {
     FEX::HLE::x32::RegisterFS(this);
     FEX::HLE::x32::RegisterInfo(this);
     FEX::HLE::x32::RegisterIO(this);
+    FEX::HLE::x32::RegisterIOUring(this);
     FEX::HLE::x32::RegisterMemory(this);
     FEX::HLE::x32::RegisterMsg(this);
     FEX::HLE::x32::RegisterNotImplemented(this);
@@ -29,6 +29,8 @@ namespace FEXCore::Core {
 
 namespace FEX::HLE::x32 {
   void RegisterTime(FEX::HLE::SyscallHandler *Handler) {
+    using namespace FEXCore::IR;
+
 
     REGISTER_SYSCALL_IMPL_X32(time, [](FEXCore::Core::CpuStateFrame *Frame, FEX::HLE::x32::old_time32_t *tloc) -> uint64_t {
       time_t Host{};
@@ -130,7 +132,8 @@ namespace FEX::HLE::x32 {
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_X32(clock_nanosleep, [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clockid, int flags, const timespec32 *request, timespec32 *remain) -> uint64_t {
+    REGISTER_SYSCALL_IMPL_X32_FLAGS(clock_nanosleep, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+      [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clockid, int flags, const timespec32 *request, timespec32 *remain) -> uint64_t {
       struct timespec req64{};
       struct timespec *req64_ptr{};
 
@@ -15,6 +15,7 @@ namespace FEX::HLE::x64 {
   void RegisterFD(FEX::HLE::SyscallHandler *Handler);
   void RegisterInfo(FEX::HLE::SyscallHandler *Handler);
   void RegisterIO(FEX::HLE::SyscallHandler *Handler);
+  void RegisterIOUring(FEX::HLE::SyscallHandler *Handler);
   void RegisterIoctl(FEX::HLE::SyscallHandler *Handler);
   void RegisterMemory(FEX::HLE::SyscallHandler *Handler);
   void RegisterMsg(FEX::HLE::SyscallHandler *Handler);
@@ -53,7 +54,6 @@ namespace FEX::HLE::x64 {
     FEX::HLE::RegisterFS(this);
     FEX::HLE::RegisterInfo(this);
     FEX::HLE::RegisterIO(this);
-    FEX::HLE::RegisterIOUring(this);
     FEX::HLE::RegisterKey(this);
     FEX::HLE::RegisterMemory(this);
     FEX::HLE::RegisterMsg(this);
@@ -74,6 +74,7 @@ namespace FEX::HLE::x64 {
     FEX::HLE::x64::RegisterFD(this);
     FEX::HLE::x64::RegisterInfo(this);
     FEX::HLE::x64::RegisterIO(this);
+    FEX::HLE::x64::RegisterIOUring(this);
     FEX::HLE::x64::RegisterIoctl(this);
     FEX::HLE::x64::RegisterMemory(this);
     FEX::HLE::x64::RegisterMsg(this);
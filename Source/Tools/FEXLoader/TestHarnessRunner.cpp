@@ -253,6 +253,9 @@ int main(int argc, char **argv, char **const envp) {
 
   auto CTX = FEXCore::Context::Context::CreateNewContext();
 
+  // Scripts/guest_benchmark_runner.py reports compile throughput
+  CTX->EnableCompileTimeStats();
+
   CTX->InitializeContext();
 
 #ifndef _WIN32
@@ -345,6 +348,13 @@ int main(int argc, char **argv, char **const envp) {
   LogMan::Msg::IFmt("Faulted? {}", LongJumpHandler::DidFault ? "Yes" : "No");
   LogMan::Msg::IFmt("Passed? {}", Passed ? "Yes" : "No");
 
+  if (Core != FEXCore::Config::CONFIG_CUSTOM) {
+    // Consumed by Scripts/guest_benchmark_runner.py
+    const auto Stats = CTX->GetJITCodeStats();
+    LogMan::Msg::IFmt("JITStats: Blocks={} GuestInstructions={} GuestBytes={} HostCodeBytes={} CompileNanoseconds={}",
+      Stats.BlocksCompiled, Stats.GuestInstructions, Stats.GuestBytes, Stats.HostCodeBytes, Stats.CompileNanoseconds);
+  }
+
 
   SignalDelegation.reset();
 
@@ -1,4 +1,5 @@
 #include "VDSO_Emulation.h"
+#include "VDSO_HostHandlers.h"
 #include "FEXCore/IR/IR.h"
 #include "LinuxSyscalls/x32/Types.h"
 
@@ -19,19 +20,6 @@
 
 namespace FEX::VDSO {
   FEXCore::Context::VDSOSigReturn VDSOPointers{};
-  namespace VDSOHandlers {
-    using TimeType = decltype(::time)*;
-    using GetTimeOfDayType = decltype(::gettimeofday)*;
-    using ClockGetTimeType = decltype(::clock_gettime)*;
-    using ClockGetResType = decltype(::clock_getres)*;
-    using GetCPUType = decltype(FHU::Syscalls::getcpu)*;
-
-    TimeType TimePtr;
-    GetTimeOfDayType GetTimeOfDayPtr;
-    ClockGetTimeType ClockGetTimePtr;
-    ClockGetResType ClockGetResPtr;
-    GetCPUType GetCPUPtr;
-  }
 
   using HandlerPtr = void(*)(void*);
   namespace x64 {
@@ -98,58 +86,6 @@ namespace FEX::VDSO {
       }
     }
 
-    namespace VDSO {
-      // VDSO handlers
-      static void time(void* ArgsRV) {
-        struct ArgsRV_t {
-          time_t *a_0;
-          uint64_t rv;
-        } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
-
-        args->rv = VDSOHandlers::TimePtr(args->a_0);
-      }
-
-      static void gettimeofday(void* ArgsRV) {
-        struct ArgsRV_t {
-          struct timeval *tv;
-          struct timezone *tz;
-          uint64_t rv;
-        } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
-
-        args->rv = VDSOHandlers::GetTimeOfDayPtr(args->tv, args->tz);
-      }
-
-      static void clock_gettime(void* ArgsRV) {
-        struct ArgsRV_t {
-          clockid_t clk_id;
-          struct timespec *tp;
-          uint64_t rv;
-        } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
-
-        args->rv = VDSOHandlers::ClockGetTimePtr(args->clk_id, args->tp);
-      }
-
-      static void clock_getres(void* ArgsRV) {
-        struct ArgsRV_t {
-          clockid_t clk_id;
-          struct timespec *tp;
-          uint64_t rv;
-        } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
-
-        args->rv = VDSOHandlers::ClockGetResPtr(args->clk_id, args->tp);
-      }
-
-      static void getcpu(void* ArgsRV) {
-        struct ArgsRV_t {
-          uint32_t *cpu;
-          uint32_t *node;
-          uint64_t rv;
-        } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
-
-        args->rv = VDSOHandlers::GetCPUPtr(args->cpu, args->node);
-      }
-    }
-
     HandlerPtr Handler_time = FEX::VDSO::x64::glibc::time;
     HandlerPtr Handler_gettimeofday = FEX::VDSO::x64::glibc::gettimeofday;
     HandlerPtr Handler_clock_gettime = FEX::VDSO::x64::glibc::clock_gettime;
@@ -510,25 +446,9 @@ namespace FEX::VDSO {
     fextl::string ThunkGuestPath{};
     if (Is64Bit) {
       ThunkGuestPath = fextl::fmt::format("{}/libVDSO-guest.so", ThunkGuestLibs());
-
-      // Set the Thunk definition pointers for x86-64
-      VDSODefinitions[0].ThunkFunction = FEX::VDSO::x64::Handler_time;
-      VDSODefinitions[1].ThunkFunction = FEX::VDSO::x64::Handler_gettimeofday;
-      VDSODefinitions[2].ThunkFunction = FEX::VDSO::x64::Handler_clock_gettime;
-      VDSODefinitions[3].ThunkFunction = FEX::VDSO::x64::Handler_clock_gettime;
-      VDSODefinitions[4].ThunkFunction = FEX::VDSO::x64::Handler_clock_getres;
-      VDSODefinitions[5].ThunkFunction = FEX::VDSO::x64::Handler_getcpu;
     }
     else {
       ThunkGuestPath = fextl::fmt::format("{}/libVDSO-guest.so", ThunkGuestLibs32());
-
-      // Set the Thunk definition pointers for x86
-      VDSODefinitions[0].ThunkFunction = FEX::VDSO::x32::Handler_time;
-      VDSODefinitions[1].ThunkFunction = FEX::VDSO::x32::Handler_gettimeofday;
-      VDSODefinitions[2].ThunkFunction = FEX::VDSO::x32::Handler_clock_gettime;
-      VDSODefinitions[3].ThunkFunction = FEX::VDSO::x32::Handler_clock_gettime64;
-      VDSODefinitions[4].ThunkFunction = FEX::VDSO::x32::Handler_clock_getres;
-      VDSODefinitions[5].ThunkFunction = FEX::VDSO::x32::Handler_getcpu;
     }
 
     // Load VDSO if we can
@@ -547,6 +467,7 @@ namespace FEX::VDSO {
         VDSOBase = Handler->GuestMmap(nullptr, nullptr, VDSOSize, PROT_READ, MAP_PRIVATE, VDSOFD, 0);
 
         // Since we found our VDSO thunk library, find our host VDSO function implementations.
+        // This needs to happen before the thunk definitions are filled in, otherwise the glibc handlers are always used.
         LoadHostVDSO();
 
       }
@@ -554,6 +475,34 @@ namespace FEX::VDSO {
       LoadGuestVDSOSymbols(Is64Bit, reinterpret_cast<char*>(VDSOBase));
     }
 
+    if (Is64Bit) {
+      // Set the Thunk definition pointers for x86-64
+      VDSODefinitions[0].ThunkFunction = FEX::VDSO::x64::Handler_time;
+      VDSODefinitions[1].ThunkFunction = FEX::VDSO::x64::Handler_gettimeofday;
+      VDSODefinitions[2].ThunkFunction = FEX::VDSO::x64::Handler_clock_gettime;
+      VDSODefinitions[3].ThunkFunction = FEX::VDSO::x64::Handler_clock_gettime;
+      VDSODefinitions[4].ThunkFunction = FEX::VDSO::x64::Handler_clock_getres;
+      VDSODefinitions[5].ThunkFunction = FEX::VDSO::x64::Handler_getcpu;
+
+      // The x86-64 VDSO handlers directly forward to the host VDSO, which is built with -mgeneral-regs-only.
+      // These can skip the vector register spill in the JIT. The glibc fallbacks make no such guarantee.
+      VDSODefinitions[0].GPROnly = FEX::VDSO::x64::Handler_time == FEX::VDSO::x64::VDSO::time;
+      VDSODefinitions[1].GPROnly = FEX::VDSO::x64::Handler_gettimeofday == FEX::VDSO::x64::VDSO::gettimeofday;
+      VDSODefinitions[2].GPROnly = FEX::VDSO::x64::Handler_clock_gettime == FEX::VDSO::x64::VDSO::clock_gettime;
+      VDSODefinitions[3].GPROnly = VDSODefinitions[2].GPROnly;
+      VDSODefinitions[4].GPROnly = FEX::VDSO::x64::Handler_clock_getres == FEX::VDSO::x64::VDSO::clock_getres;
+      VDSODefinitions[5].GPROnly = FEX::VDSO::x64::Handler_getcpu == FEX::VDSO::x64::VDSO::getcpu;
+    }
+    else {
+      // Set the Thunk definition pointers for x86
+      VDSODefinitions[0].ThunkFunction = FEX::VDSO::x32::Handler_time;
+      VDSODefinitions[1].ThunkFunction = FEX::VDSO::x32::Handler_gettimeofday;
+      VDSODefinitions[2].ThunkFunction = FEX::VDSO::x32::Handler_clock_gettime;
+      VDSODefinitions[3].ThunkFunction = FEX::VDSO::x32::Handler_clock_gettime64;
+      VDSODefinitions[4].ThunkFunction = FEX::VDSO::x32::Handler_clock_getres;
+      VDSODefinitions[5].ThunkFunction = FEX::VDSO::x32::Handler_getcpu;
+    }
+
     return VDSOBase;
   }
 
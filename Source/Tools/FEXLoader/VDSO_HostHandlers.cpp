@@ -0,0 +1,65 @@
+// Kept apart from VDSO_Emulation.cpp so these can be built with -mgeneral-regs-only.
+// The Arm64 JIT relies on that to skip the vector register spill around the calls.
+
+#include "VDSO_HostHandlers.h"
+
+namespace FEX::VDSO {
+  namespace VDSOHandlers {
+    TimeType TimePtr;
+    GetTimeOfDayType GetTimeOfDayPtr;
+    ClockGetTimeType ClockGetTimePtr;
+    ClockGetResType ClockGetResPtr;
+    GetCPUType GetCPUPtr;
+  }
+
+  namespace x64::VDSO {
+    void time(void* ArgsRV) {
+      struct ArgsRV_t {
+        time_t *a_0;
+        uint64_t rv;
+      } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+
+      args->rv = VDSOHandlers::TimePtr(args->a_0);
+    }
+
+    void gettimeofday(void* ArgsRV) {
+      struct ArgsRV_t {
+        struct timeval *tv;
+        struct timezone *tz;
+        uint64_t rv;
+      } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+
+      args->rv = VDSOHandlers::GetTimeOfDayPtr(args->tv, args->tz);
+    }
+
+    void clock_gettime(void* ArgsRV) {
+      struct ArgsRV_t {
+        clockid_t clk_id;
+        struct timespec *tp;
+        uint64_t rv;
+      } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+
+      args->rv = VDSOHandlers::ClockGetTimePtr(args->clk_id, args->tp);
+    }
+
+    void clock_getres(void* ArgsRV) {
+      struct ArgsRV_t {
+        clockid_t clk_id;
+        struct timespec *tp;
+        uint64_t rv;
+      } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+
+      args->rv = VDSOHandlers::ClockGetResPtr(args->clk_id, args->tp);
+    }
+
+    void getcpu(void* ArgsRV) {
+      struct ArgsRV_t {
+        uint32_t *cpu;
+        uint32_t *node;
+        uint64_t rv;
+      } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+
+      args->rv = VDSOHandlers::GetCPUPtr(args->cpu, args->node);
+    }
+  }
+}
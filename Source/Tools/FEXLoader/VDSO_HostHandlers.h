@@ -0,0 +1,33 @@
+#pragma once
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <cstdint>
+#include <sys/time.h>
+#include <time.h>
+
+namespace FEX::VDSO {
+  // Host vDSO implementations, only set when the host vDSO provides them
+  namespace VDSOHandlers {
+    using TimeType = decltype(::time)*;
+    using GetTimeOfDayType = decltype(::gettimeofday)*;
+    using ClockGetTimeType = decltype(::clock_gettime)*;
+    using ClockGetResType = decltype(::clock_getres)*;
+    using GetCPUType = decltype(FHU::Syscalls::getcpu)*;
+
+    extern TimeType TimePtr;
+    extern GetTimeOfDayType GetTimeOfDayPtr;
+    extern ClockGetTimeType ClockGetTimePtr;
+    extern ClockGetResType ClockGetResPtr;
+    extern GetCPUType GetCPUPtr;
+  }
+
+  // x86-64 thunk handlers that directly forward to the host vDSO.
+  // Built with -mgeneral-regs-only, these are marked GPROnly when the host vDSO provides them.
+  namespace x64::VDSO {
+    void time(void* ArgsRV);
+    void gettimeofday(void* ArgsRV);
+    void clock_gettime(void* ArgsRV);
+    void clock_getres(void* ArgsRV);
+    void getcpu(void* ArgsRV);
+  }
+}
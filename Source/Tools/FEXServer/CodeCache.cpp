@@ -0,0 +1,87 @@
+#include "CodeCache.h"
+
+#include <FEXCore/fextl/fmt.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace CodeCache {
+  constexpr size_t static MAX_CODE_CACHE_ENTRIES = 256;
+
+  struct Entry {
+    int FD;
+    // Connection that is filling the cache in, -1 once it has gone away
+    int CreatorSocket;
+  };
+
+  // Entries are only handed out once the creating process has sealed them.
+  static std::unordered_map<std::string, Entry> Entries{};
+
+  static bool IsSealed(int FD) {
+    const int Seals = fcntl(FD, F_GET_SEALS);
+    return Seals != -1 && (Seals & F_SEAL_WRITE);
+  }
+
+  int OpenForRead(const std::string &Key) {
+    auto it = Entries.find(Key);
+    if (it == Entries.end() || !IsSealed(it->second.FD)) {
+      // Unsealed means the creating process is still filling it in.
+      return -1;
+    }
+
+    // The memfd's own description has its offset at the end of what the creator wrote.
+    // Reopening it through procfs gives the reader a new description starting at 0.
+    const auto Path = fextl::fmt::format("/proc/self/fd/{}", it->second.FD);
+    return open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+  }
+
+  int Create(const std::string &Key, int CreatorSocket) {
+    auto it = Entries.find(Key);
+    if (it != Entries.end()) {
+      if (IsSealed(it->second.FD) || it->second.CreatorSocket != -1) {
+        // Already published, or another process is still filling it in.
+        return -1;
+      }
+
+      // The previous creator went away without sealing it. Replace it.
+      close(it->second.FD);
+      Entries.erase(it);
+    }
+
+    if (Entries.size() >= MAX_CODE_CACHE_ENTRIES) {
+      Clear();
+    }
+
+    int FD = memfd_create("FEXCodeCache", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (FD == -1) {
+      return -1;
+    }
+
+    Entries.emplace(Key, Entry {
+      .FD = FD,
+      .CreatorSocket = CreatorSocket,
+    });
+    return FD;
+  }
+
+  void ClientDisconnected(int Socket) {
+    for (auto &[Key, Entry] : Entries) {
+      if (Entry.CreatorSocket == Socket) {
+        Entry.CreatorSocket = -1;
+      }
+    }
+  }
+
+  void Clear() {
+    for (auto &[Key, Entry] : Entries) {
+      close(Entry.FD);
+    }
+    Entries.clear();
+  }
+
+  size_t Count() {
+    return Entries.size();
+  }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Code cache memfds shared between FEX processes, keyed by the client provided cache key.
+// Only used from the FEXServer's request thread.
+namespace CodeCache {
+  /**
+   * @brief Opens the sealed code cache for a key
+   *
+   * Every reader gets its own file description, so reads start at offset 0 regardless of what the creator did.
+   *
+   * @return Read-only FD the caller needs to close, or -1 if there is no sealed cache for the key
+   */
+  int OpenForRead(const std::string &Key);
+
+  /**
+   * @brief Creates a code cache for a client to fill in and seal
+   *
+   * @param CreatorSocket - Connection of the client that fills it in
+   *
+   * @return Writable memfd owned by the cache, or -1 if the key is already published or still being filled in
+   */
+  int Create(const std::string &Key, int CreatorSocket);
+
+  // Lets the caches a disconnected client never sealed be created again
+  void ClientDisconnected(int Socket);
+
+  void Clear();
+
+  // Number of memfds held open by the cache
+  size_t Count();
+}
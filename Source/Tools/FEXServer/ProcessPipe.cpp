@@ -1,4 +1,5 @@
 #include "FEXHeaderUtils/Syscalls.h"
+#include "CodeCache.h"
 #include "Logger.h"
 #include "SquashFS.h"
 
@@ -281,6 +282,36 @@ namespace ProcessPipe {
     sendmsg(Socket, &msg, 0);
   }
 
+  void HandleGetCodeCache(int Socket, const std::string &Key) {
+    int FD = CodeCache::OpenForRead(Key);
+    if (FD == -1) {
+      SendEmptyErrorPacket(Socket);
+      return;
+    }
+
+    SendFDSuccessPacket(Socket, FD);
+    close(FD);
+  }
+
+  void HandleCreateCodeCache(int Socket, const std::string &Key) {
+    const size_t CachedFDs = CodeCache::Count();
+    int FD = CodeCache::Create(Key, Socket);
+
+    // Creation can replace or drop older caches
+    NumFilesOpened += CodeCache::Count();
+    NumFilesOpened -= CachedFDs;
+
+    if (FD == -1) {
+      SendEmptyErrorPacket(Socket);
+      return;
+    }
+
+    SendFDSuccessPacket(Socket, FD);
+
+    // Check if we need to increase the FD limit.
+    CheckRaiseFDLimit();
+  }
+
   void HandleSocketData(int Socket) {
     std::vector<uint8_t> Data(1500);
     size_t CurrentRead{};
@@ -426,6 +457,29 @@ namespace ProcessPipe {
 
           CurrentOffset += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
           break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_CODE_CACHE_FD:
+        case FEXServerClient::PacketType::TYPE_CREATE_CODE_CACHE_FD: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          if (Remaining < sizeof(Req->CodeCache) ||
+              Remaining - sizeof(Req->CodeCache) < Req->CodeCache.KeyLength) {
+            // Truncated packet, consume everything.
+            LogMan::Msg::EFmt("[FEXServer] Truncated code cache packet received 0x{:x} bytes", Remaining);
+            SendEmptyErrorPacket(Socket);
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          std::string Key(Req->CodeCache.Key, Req->CodeCache.KeyLength);
+          if (Req->Header.Type == FEXServerClient::PacketType::TYPE_GET_CODE_CACHE_FD) {
+            HandleGetCodeCache(Socket, Key);
+          }
+          else {
+            HandleCreateCodeCache(Socket, Key);
+          }
+
+          CurrentOffset += sizeof(Req->CodeCache) + Req->CodeCache.KeyLength;
+          break;
         }
           // Invalid
         case FEXServerClient::PacketType::TYPE_ERROR:
@@ -445,6 +499,8 @@ namespace ProcessPipe {
 
     // Close the server socket so no more connections can be started
     close(ServerSocketFD);
+
+    CodeCache::Clear();
   }
 
   void WaitForRequests() {
@@ -493,6 +549,7 @@ namespace ProcessPipe {
                 // Error or hangup, close the socket and erase it from our list
                 Erase = true;
                 close(Event.fd);
+                CodeCache::ClientDisconnected(Event.fd);
               }
             }
 
@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+
+#include "Common/FEXServerClient.h"
+#include "FEXServer/CodeCache.h"
+
+#include <array>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Client connections are only used as identifiers by the cache
+constexpr int CreatorSocket = 100;
+constexpr int ReaderSocket = 101;
+
+constexpr std::array<char, 8> Data {'F', 'E', 'X', 'C', 'a', 'c', 'h', 'e'};
+
+// Create hands out the cache's own fd, which only Clear closes.
+// Clears the cache however the test case ends, including a failed REQUIRE.
+class ScopedCodeCache final {
+public:
+  ScopedCodeCache() {
+    CodeCache::Clear();
+  }
+
+  ~ScopedCodeCache() {
+    CodeCache::Clear();
+  }
+};
+
+// OpenForRead hands out a new fd that belongs to the caller
+class ScopedFD final {
+public:
+  explicit ScopedFD(int FD) : FD {FD} {}
+  ~ScopedFD() {
+    if (FD != -1) {
+      close(FD);
+    }
+  }
+
+  ScopedFD(const ScopedFD&) = delete;
+  ScopedFD &operator=(const ScopedFD&) = delete;
+
+  int Get() const { return FD; }
+
+private:
+  int FD;
+};
+
+TEST_CASE("CodeCache - Create, fill, seal and fetch") {
+  ScopedCodeCache Cache;
+
+  const int WriteFD = CodeCache::Create("Key", CreatorSocket);
+  REQUIRE(WriteFD != -1);
+
+  // Nothing to read until the creator seals it, and nobody else can create it meanwhile
+  CHECK(ScopedFD(CodeCache::OpenForRead("Key")).Get() == -1);
+  CHECK(CodeCache::Create("Key", ReaderSocket) == -1);
+
+  // The creator's writes leave its offset at the end of the file
+  REQUIRE(write(WriteFD, Data.data(), Data.size()) == Data.size());
+  REQUIRE(FEXServerClient::SealCodeCacheFD(WriteFD));
+
+  // Once sealed it can't be created again
+  CHECK(CodeCache::Create("Key", ReaderSocket) == -1);
+
+  // The second client reads from the start of its own file description
+  const ScopedFD ReadFD {CodeCache::OpenForRead("Key")};
+  REQUIRE(ReadFD.Get() != -1);
+  CHECK((fcntl(ReadFD.Get(), F_GETFL) & O_ACCMODE) == O_RDONLY);
+
+  std::array<char, Data.size()> Read{};
+  CHECK(read(ReadFD.Get(), Read.data(), Read.size()) == Read.size());
+  CHECK(Read == Data);
+
+  CHECK(CodeCache::Count() == 1);
+  CodeCache::Clear();
+  CHECK(CodeCache::Count() == 0);
+}
+
+TEST_CASE("CodeCache - Unsealed cache of a disconnected creator") {
+  ScopedCodeCache Cache;
+
+  const int FirstFD = CodeCache::Create("Key", CreatorSocket);
+  REQUIRE(FirstFD != -1);
+
+  // Another client's disconnect doesn't release it
+  CodeCache::ClientDisconnected(ReaderSocket);
+  CHECK(CodeCache::Create("Key", ReaderSocket) == -1);
+
+  // The creator going away without sealing lets the next client create it
+  CodeCache::ClientDisconnected(CreatorSocket);
+  const int SecondFD = CodeCache::Create("Key", ReaderSocket);
+  REQUIRE(SecondFD != -1);
+  CHECK(CodeCache::Count() == 1);
+
+  REQUIRE(write(SecondFD, Data.data(), Data.size()) == Data.size());
+  REQUIRE(FEXServerClient::SealCodeCacheFD(SecondFD));
+  const ScopedFD ReadFD {CodeCache::OpenForRead("Key")};
+  REQUIRE(ReadFD.Get() != -1);
+}
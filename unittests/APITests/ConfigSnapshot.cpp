@@ -0,0 +1,267 @@
+#include <catch2/catch.hpp>
+
+#include "Common/ConfigSnapshot.h"
+
+#include <FEXCore/Config/Config.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace Snapshot = FEX::Config::Snapshot;
+
+namespace {
+  // Snapshot directories are only removed at exit, so a new one never reuses the inode of a previous snapshot
+  struct TestDirectory {
+    TestDirectory() {
+      char Template[] = "/tmp/FEXConfigSnapshot.XXXXXX";
+      REQUIRE(mkdtemp(Template) != nullptr);
+      Path = Template;
+    }
+
+    ~TestDirectory() {
+      std::filesystem::remove_all(Path);
+    }
+
+    // Gives every test its own snapshot
+    std::string NewDataDirectory(const char *Name) {
+      auto DataDirectory = Path + "/" + Name;
+      std::filesystem::create_directories(DataDirectory);
+      FEXCore::Config::SetDataDirectory(DataDirectory);
+      return DataDirectory;
+    }
+
+    std::string Path;
+  };
+
+  // Created by the first test that needs it
+  TestDirectory &GetDirectory() {
+    static TestDirectory Directory;
+    return Directory;
+  }
+
+  void WriteJSON(const std::string &Path, const std::string &Contents) {
+    // Replacing the file changes its inode, so it never looks unchanged to the snapshot
+    const auto TmpPath = Path + ".tmp";
+    std::ofstream(TmpPath) << Contents;
+    std::filesystem::rename(TmpPath, Path);
+  }
+
+  std::string ConfigJSON(const std::string &Value) {
+    return "{\"Config\": {\"RootFS\": \"" + Value + "\", \"Multiblock\": \"1\"}, \"ThunksDB\": {\"GL\": 1 }}";
+  }
+
+  std::string_view Lookup(const Snapshot::ParsedFile &File, std::string_view Key0, std::string_view Key1) {
+    for (const auto &Entry : File.Entries) {
+      if (Entry.Matches(Key0, Key1)) {
+        return Entry.Value;
+      }
+    }
+    return {};
+  }
+
+  // Each process maps the snapshot once and keeps what it found there, so only a new process sees changes to it
+  template<typename F>
+  void RunInChild(F &&Func) {
+    const pid_t Child = fork();
+    REQUIRE(Child != -1);
+    if (Child == 0) {
+      _exit(Func() ? 0 : 1);
+    }
+
+    int Status;
+    REQUIRE(waitpid(Child, &Status, 0) == Child);
+    CHECK(WIFEXITED(Status));
+    CHECK(WEXITSTATUS(Status) == 0);
+  }
+
+  std::vector<char> ReadFile(const std::string &Path) {
+    std::ifstream Stream(Path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(Stream), {});
+  }
+
+  void ReplaceFile(const std::string &Path, const std::vector<char> &Data) {
+    const auto TmpPath = Path + ".tmp";
+    std::ofstream(TmpPath, std::ios::binary).write(Data.data(), Data.size());
+    std::filesystem::rename(TmpPath, Path);
+  }
+}
+
+TEST_CASE("ConfigSnapshot - Round trip") {
+  const auto DataDirectory = GetDirectory().NewDataDirectory("RoundTrip");
+  const fextl::string Filename = (DataDirectory + "/Config.json").c_str();
+  WriteJSON(Filename.c_str(), ConfigJSON("/rootfs"));
+
+  Snapshot::ParsedFile Parsed;
+  REQUIRE(Snapshot::LoadFile(Filename, &Parsed));
+  CHECK_FALSE(Parsed.FromSnapshot());
+
+  Snapshot::ParsedFile Cached;
+  REQUIRE(Snapshot::LoadFile(Filename, &Cached));
+  CHECK(Cached.FromSnapshot());
+
+  REQUIRE(Cached.Entries.size() == Parsed.Entries.size());
+  CHECK(Lookup(Cached, "Config", "RootFS") == "/rootfs");
+  CHECK(Lookup(Cached, "Config", "Multiblock") == "1");
+  CHECK(Lookup(Cached, "ThunksDB", "GL") == "1");
+
+  // A changed file is parsed again
+  WriteJSON(Filename.c_str(), ConfigJSON("/other_rootfs"));
+  Snapshot::ParsedFile Changed;
+  REQUIRE(Snapshot::LoadFile(Filename, &Changed));
+  CHECK_FALSE(Changed.FromSnapshot());
+  CHECK(Lookup(Changed, "Config", "RootFS") == "/other_rootfs");
+}
+
+TEST_CASE("ConfigSnapshot - Misses keep the other files") {
+  const auto DataDirectory = GetDirectory().NewDataDirectory("Misses");
+  const fextl::string First = (DataDirectory + "/First.json").c_str();
+  const fextl::string Second = (DataDirectory + "/Second.json").c_str();
+  WriteJSON(First.c_str(), ConfigJSON("/first"));
+  WriteJSON(Second.c_str(), ConfigJSON("/second"));
+
+  Snapshot::ParsedFile File;
+  REQUIRE(Snapshot::LoadFile(First, &File));
+  REQUIRE(Snapshot::LoadFile(Second, &File));
+
+  // Storing the second file must not have dropped the first
+  Snapshot::ParsedFile FirstCached;
+  REQUIRE(Snapshot::LoadFile(First, &FirstCached));
+  CHECK(FirstCached.FromSnapshot());
+  CHECK(Lookup(FirstCached, "Config", "RootFS") == "/first");
+
+  Snapshot::ParsedFile SecondCached;
+  REQUIRE(Snapshot::LoadFile(Second, &SecondCached));
+  CHECK(SecondCached.FromSnapshot());
+  CHECK(Lookup(SecondCached, "Config", "RootFS") == "/second");
+}
+
+TEST_CASE("ConfigSnapshot - Corrupt snapshots are rejected") {
+  const auto DataDirectory = GetDirectory().NewDataDirectory("Corrupt");
+  const fextl::string Filename = (DataDirectory + "/Config.json").c_str();
+  const auto SnapshotPath = DataDirectory + "/ConfigSnapshot.bin";
+  WriteJSON(Filename.c_str(), ConfigJSON("/rootfs"));
+
+  // This process never loads the file itself, or it would keep finding it in its own mapping
+  RunInChild([&]() {
+    Snapshot::ParsedFile File;
+    return Snapshot::LoadFile(Filename, &File);
+  });
+  const auto Valid = ReadFile(SnapshotPath);
+
+  // SnapshotHeader is 24 bytes, followed by the first file's 40 byte FileBlockHeader and then its path length
+  constexpr size_t BlockSizeOffset = 24 + 36;
+  constexpr size_t PathLengthOffset = 24 + 40;
+  REQUIRE(Valid.size() > PathLengthOffset + sizeof(uint32_t));
+
+  const auto Corrupt = [&](size_t Offset, uint32_t Value) {
+    auto Data = Valid;
+    memcpy(&Data[Offset], &Value, sizeof(Value));
+    return Data;
+  };
+
+  const std::vector<char> Cases[] = {
+    // Block too small for its own header
+    Corrupt(BlockSizeOffset, 0),
+    Corrupt(BlockSizeOffset, 8),
+    // Block ends before its path
+    Corrupt(BlockSizeOffset, 40),
+    Corrupt(BlockSizeOffset, 40 + sizeof(uint32_t) + 2),
+    // Block past the end of the snapshot
+    Corrupt(BlockSizeOffset, 0xFFFF'FFFF),
+    // Path past the end of the block
+    Corrupt(PathLengthOffset, 0xFFFF'FFF0),
+    // Truncated
+    std::vector<char>(Valid.begin(), Valid.begin() + PathLengthOffset),
+  };
+
+  for (const auto &Data : Cases) {
+    ReplaceFile(SnapshotPath, Data);
+
+    // Misses, and the snapshot gets rewritten
+    RunInChild([&]() {
+      Snapshot::ParsedFile Reparsed;
+      return Snapshot::LoadFile(Filename, &Reparsed) && !Reparsed.FromSnapshot() &&
+             Lookup(Reparsed, "Config", "RootFS") == "/rootfs";
+    });
+
+    RunInChild([&]() {
+      Snapshot::ParsedFile Cached;
+      return Snapshot::LoadFile(Filename, &Cached) && Cached.FromSnapshot();
+    });
+  }
+}
+
+TEST_CASE("ConfigSnapshot - Concurrent misses") {
+  const auto DataDirectory = GetDirectory().NewDataDirectory("Concurrent");
+  constexpr int NumProcesses = 8;
+
+  std::vector<fextl::string> Filenames;
+  for (int i = 0; i < NumProcesses; ++i) {
+    Filenames.emplace_back((DataDirectory + "/Config" + std::to_string(i) + ".json").c_str());
+    WriteJSON(Filenames.back().c_str(), ConfigJSON("/rootfs" + std::to_string(i)));
+  }
+
+  // Every process misses on its own file at about the same time
+  std::vector<pid_t> Children;
+  for (int i = 0; i < NumProcesses; ++i) {
+    const pid_t Child = fork();
+    REQUIRE(Child != -1);
+    if (Child == 0) {
+      Snapshot::ParsedFile File;
+      _exit(Snapshot::LoadFile(Filenames[i], &File) && !File.FromSnapshot() ? 0 : 1);
+    }
+    Children.push_back(Child);
+  }
+
+  for (auto Child : Children) {
+    int Status;
+    REQUIRE(waitpid(Child, &Status, 0) == Child);
+    CHECK(WIFEXITED(Status));
+    CHECK(WEXITSTATUS(Status) == 0);
+  }
+
+  // None of them dropped another's file
+  for (int i = 0; i < NumProcesses; ++i) {
+    Snapshot::ParsedFile File;
+    REQUIRE(Snapshot::LoadFile(Filenames[i], &File));
+    CHECK(File.FromSnapshot());
+    CHECK(Lookup(File, "Config", "RootFS") == "/rootfs" + std::to_string(i));
+  }
+}
+
+TEST_CASE("ConfigSnapshot - Empty objects") {
+  const auto DataDirectory = GetDirectory().NewDataDirectory("Empty");
+  const fextl::string Filename = (DataDirectory + "/ThunksDB.json").c_str();
+  WriteJSON(Filename.c_str(), "{\"DB\": {\"Empty\": {}, \"GL\": {\"Library\": \"libGL-guest.so\", \"Depends\": []}}}");
+
+  // A library declared with an empty object has to show up just like one with members
+  auto Check = [](const Snapshot::ParsedFile &File) {
+    bool FoundEmpty = false;
+    bool FoundDepends = false;
+    for (const auto &Entry : File.Entries) {
+      if (Entry.Depth == 2 && Entry.Matches("DB", "Empty")) {
+        FoundEmpty = Entry.EmptyContainer && Entry.Value.empty();
+      }
+      else if (Entry.Depth == 3 && Entry.Matches("DB", "GL") && Entry.Keys[2] == "Depends") {
+        FoundDepends = Entry.EmptyContainer;
+      }
+    }
+    return FoundEmpty && FoundDepends && File.Entries.size() == 3;
+  };
+
+  Snapshot::ParsedFile Parsed;
+  REQUIRE(Snapshot::LoadFile(Filename, &Parsed));
+  CHECK_FALSE(Parsed.FromSnapshot());
+  CHECK(Check(Parsed));
+
+  Snapshot::ParsedFile Cached;
+  REQUIRE(Snapshot::LoadFile(Filename, &Cached));
+  CHECK(Cached.FromSnapshot());
+  CHECK(Check(Cached));
+}
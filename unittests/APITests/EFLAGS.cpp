@@ -0,0 +1,94 @@
+#include <catch2/catch.hpp>
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/X86Enums.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+using namespace FEXCore;
+
+namespace {
+  // Only bits up to ID are stored
+  constexpr uint32_t NUM_STORED_BITS = X86State::RFLAG_ID_LOC + 1;
+
+  uint32_t LoadNZCV(const Core::CPUState &State) {
+    uint32_t NZCV;
+    memcpy(&NZCV, &State.flags[X86State::FLAG_NZCV_OFFSET], sizeof(NZCV));
+    return NZCV;
+  }
+
+  void StoreNZCV(Core::CPUState &State, uint32_t NZCV) {
+    memcpy(&State.flags[X86State::FLAG_NZCV_OFFSET], &NZCV, sizeof(NZCV));
+  }
+}
+
+TEST_CASE("EFLAGS - Round trip") {
+  auto State = std::make_unique<Core::CPUState>();
+
+  // The reserved bit always reads as set
+  for (uint32_t EFLAGS = 0; EFLAGS < (1U << NUM_STORED_BITS); ++EFLAGS) {
+    State->SetEFLAGS(EFLAGS);
+    const uint32_t Result = State->GetEFLAGS();
+    if (Result != (EFLAGS | (1U << X86State::RFLAG_RESERVED_LOC))) {
+      FAIL_CHECK("EFLAGS 0x" << std::hex << EFLAGS << " read back as 0x" << Result);
+    }
+  }
+}
+
+TEST_CASE("EFLAGS - Default state") {
+  auto State = std::make_unique<Core::CPUState>();
+  CHECK(State->GetEFLAGS() == ((1U << X86State::RFLAG_RESERVED_LOC) | (1U << X86State::RFLAG_IF_LOC)));
+}
+
+TEST_CASE("EFLAGS - NZCV word") {
+  auto State = std::make_unique<Core::CPUState>();
+
+  // The JIT reads and writes CF, ZF, SF and OF as bits of the NZCV word
+  const struct {
+    unsigned RFLAG;
+    unsigned NZCV;
+  } Flags[] = {
+    {X86State::RFLAG_CF_LOC, X86State::NZCV_CF_LOC},
+    {X86State::RFLAG_ZF_LOC, X86State::NZCV_ZF_LOC},
+    {X86State::RFLAG_SF_LOC, X86State::NZCV_SF_LOC},
+    {X86State::RFLAG_OF_LOC, X86State::NZCV_OF_LOC},
+  };
+
+  for (const auto &Flag : Flags) {
+    State->SetEFLAGS(1U << Flag.RFLAG);
+    CHECK(LoadNZCV(*State) == (1U << Flag.NZCV));
+    CHECK(State->flags[Flag.RFLAG] == 0);
+
+    StoreNZCV(*State, 1U << Flag.NZCV);
+    CHECK(State->GetEFLAGS() == ((1U << X86State::RFLAG_RESERVED_LOC) | (1U << Flag.RFLAG)));
+  }
+
+  // The bits below are free for the JIT to use
+  StoreNZCV(*State, 0x0FFF'FFFF);
+  CHECK(State->GetEFLAGS() == (1U << X86State::RFLAG_RESERVED_LOC));
+}
+
+TEST_CASE("EFLAGS - Raw flag bytes") {
+  auto State = std::make_unique<Core::CPUState>();
+  State->SetEFLAGS(0);
+
+  // The JIT stores the result byte for PF, set for even parity
+  State->flags[X86State::RFLAG_PF_LOC] = 0b0110;
+  CHECK(State->GetEFLAGS() & (1U << X86State::RFLAG_PF_LOC));
+  State->flags[X86State::RFLAG_PF_LOC] = 0b0111;
+  CHECK_FALSE(State->GetEFLAGS() & (1U << X86State::RFLAG_PF_LOC));
+
+  // AF is bit 4 of its byte
+  State->flags[X86State::RFLAG_AF_LOC] = 0x10;
+  CHECK(State->GetEFLAGS() & (1U << X86State::RFLAG_AF_LOC));
+  State->flags[X86State::RFLAG_AF_LOC] = 0xEF;
+  CHECK_FALSE(State->GetEFLAGS() & (1U << X86State::RFLAG_AF_LOC));
+
+  // Every other flag only uses the bottom bit of its byte
+  State->flags[X86State::RFLAG_DF_LOC] = 0xFE;
+  CHECK_FALSE(State->GetEFLAGS() & (1U << X86State::RFLAG_DF_LOC));
+  State->flags[X86State::RFLAG_DF_LOC] = 0x01;
+  CHECK(State->GetEFLAGS() & (1U << X86State::RFLAG_DF_LOC));
+}
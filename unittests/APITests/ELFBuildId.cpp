@@ -0,0 +1,203 @@
+#include <catch2/catch.hpp>
+#include "Common/ELFBuildId.h"
+
+#include <cstring>
+#include <elf.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+// The build-id keys AOTIR caches, so malformed notes must be rejected without reading past the segment.
+
+namespace {
+void AppendNote(std::vector<uint8_t> &Notes, uint32_t Type, const char *Name, uint32_t NameSize,
+                const std::vector<uint8_t> &Desc, size_t Alignment = 4) {
+  const Elf64_Nhdr Note {
+    .n_namesz = NameSize,
+    .n_descsz = static_cast<uint32_t>(Desc.size()),
+    .n_type = Type,
+  };
+
+  const auto Append = [&](const void *Data, size_t Size) {
+    Notes.insert(Notes.end(), static_cast<const uint8_t*>(Data), static_cast<const uint8_t*>(Data) + Size);
+  };
+
+  // Laid out the way the linker does, the header isn't padded
+  Append(&Note, sizeof(Note));
+  Append(Name, NameSize);
+  Notes.resize(FEXCore::AlignUp(Notes.size(), Alignment));
+  Append(Desc.data(), Desc.size());
+  Notes.resize(FEXCore::AlignUp(Notes.size(), Alignment));
+}
+
+void AppendBuildId(std::vector<uint8_t> &Notes, size_t Alignment = 4) {
+  AppendNote(Notes, NT_GNU_BUILD_ID, "GNU", 4, {0xde, 0xad, 0xbe, 0xef, 0x01}, Alignment);
+}
+
+fextl::string Parse(const std::vector<uint8_t> &Notes, size_t Alignment = 4) {
+  return FEXCore::ELF::ParseBuildIdNote(Notes.data(), Notes.size(), Alignment);
+}
+
+// An ELF file with only a header, program headers and one note segment
+template<typename ElfEhdr, typename ElfPhdr>
+std::vector<uint8_t> MakeELF(const std::vector<uint8_t> &Notes, unsigned char Class) {
+  ElfEhdr Header {};
+  memcpy(Header.e_ident, ELFMAG, SELFMAG);
+  Header.e_ident[EI_CLASS] = Class;
+  Header.e_phoff = sizeof(ElfEhdr);
+  Header.e_phentsize = sizeof(ElfPhdr);
+  Header.e_phnum = 2;
+
+  ElfPhdr ProgramHeaders[2] {};
+  ProgramHeaders[0].p_type = PT_LOAD;
+  ProgramHeaders[1].p_type = PT_NOTE;
+  ProgramHeaders[1].p_offset = sizeof(ElfEhdr) + sizeof(ProgramHeaders);
+  ProgramHeaders[1].p_filesz = Notes.size();
+  ProgramHeaders[1].p_align = 4;
+
+  std::vector<uint8_t> File(sizeof(Header) + sizeof(ProgramHeaders));
+  memcpy(File.data(), &Header, sizeof(Header));
+  memcpy(File.data() + sizeof(Header), ProgramHeaders, sizeof(ProgramHeaders));
+  File.insert(File.end(), Notes.begin(), Notes.end());
+  return File;
+}
+
+class MemFD final {
+public:
+  explicit MemFD(const std::vector<uint8_t> &Contents) {
+    FD = memfd_create("ELFBuildId", MFD_CLOEXEC);
+    REQUIRE(FD != -1);
+    REQUIRE(write(FD, Contents.data(), Contents.size()) == static_cast<ssize_t>(Contents.size()));
+  }
+
+  ~MemFD() {
+    close(FD);
+  }
+
+  int FD;
+};
+}
+
+TEST_CASE("ELFBuildId - Note parsing") {
+  std::vector<uint8_t> Notes;
+
+  SECTION("Only note") {
+    AppendBuildId(Notes);
+    CHECK(Parse(Notes) == "deadbeef01");
+  }
+
+  SECTION("After another note") {
+    AppendNote(Notes, NT_GNU_ABI_TAG, "GNU", 4, {0, 0, 0, 0, 3, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0});
+    AppendBuildId(Notes);
+    CHECK(Parse(Notes) == "deadbeef01");
+  }
+
+  SECTION("8 byte aligned") {
+    AppendNote(Notes, NT_GNU_PROPERTY_TYPE_0, "GNU", 4, {1, 2, 3, 4, 5}, 8);
+    AppendBuildId(Notes, 8);
+    CHECK(Parse(Notes, 8) == "deadbeef01");
+  }
+
+  SECTION("No build-id") {
+    AppendNote(Notes, NT_GNU_ABI_TAG, "GNU", 4, {0, 0, 0, 0});
+    CHECK(Parse(Notes).empty());
+  }
+
+  SECTION("Build-id type from another owner") {
+    AppendNote(Notes, NT_GNU_BUILD_ID, "FEX", 4, {1, 2, 3, 4});
+    CHECK(Parse(Notes).empty());
+  }
+
+  SECTION("Empty descriptor") {
+    AppendNote(Notes, NT_GNU_BUILD_ID, "GNU", 4, {});
+    CHECK(Parse(Notes).empty());
+  }
+
+  SECTION("Empty segment") {
+    CHECK(Parse(Notes).empty());
+  }
+}
+
+TEST_CASE("ELFBuildId - Truncated and malformed notes") {
+  std::vector<uint8_t> Notes;
+  AppendBuildId(Notes);
+
+  SECTION("Truncated descriptor") {
+    // Only part of the descriptor is inside the segment
+    CHECK(FEXCore::ELF::ParseBuildIdNote(Notes.data(), Notes.size() - 4, 4).empty());
+  }
+
+  SECTION("Truncated header") {
+    CHECK(FEXCore::ELF::ParseBuildIdNote(Notes.data(), sizeof(Elf64_Nhdr) - 1, 4).empty());
+  }
+
+  SECTION("Descriptor size past the segment") {
+    Elf64_Nhdr Note;
+    memcpy(&Note, Notes.data(), sizeof(Note));
+    Note.n_descsz = 0xFFFF'FFFF;
+    memcpy(Notes.data(), &Note, sizeof(Note));
+    CHECK(Parse(Notes).empty());
+  }
+
+  SECTION("Name size past the segment") {
+    Elf64_Nhdr Note;
+    memcpy(&Note, Notes.data(), sizeof(Note));
+    Note.n_namesz = 0xFFFF'FFFF;
+    memcpy(Notes.data(), &Note, sizeof(Note));
+    CHECK(Parse(Notes).empty());
+  }
+
+  SECTION("Malformed note before the build-id") {
+    // A descriptor size that skips over the build-id, nothing after it is read
+    std::vector<uint8_t> Malformed;
+    AppendNote(Malformed, NT_GNU_ABI_TAG, "GNU", 4, {0, 0, 0, 0});
+    Elf64_Nhdr Note;
+    memcpy(&Note, Malformed.data(), sizeof(Note));
+    Note.n_descsz = 0x100;
+    memcpy(Malformed.data(), &Note, sizeof(Note));
+    Malformed.insert(Malformed.end(), Notes.begin(), Notes.end());
+    CHECK(Parse(Malformed).empty());
+  }
+}
+
+TEST_CASE("ELFBuildId - ELF files") {
+  std::vector<uint8_t> Notes;
+  AppendBuildId(Notes);
+
+  SECTION("64-bit") {
+    MemFD File(MakeELF<Elf64_Ehdr, Elf64_Phdr>(Notes, ELFCLASS64));
+    CHECK(FEXCore::ELF::GetBuildId<Elf64_Ehdr, Elf64_Phdr>(File.FD) == "deadbeef01");
+  }
+
+  SECTION("32-bit") {
+    MemFD File(MakeELF<Elf32_Ehdr, Elf32_Phdr>(Notes, ELFCLASS32));
+    CHECK(FEXCore::ELF::GetBuildId<Elf32_Ehdr, Elf32_Phdr>(File.FD) == "deadbeef01");
+  }
+
+  SECTION("Wrong class") {
+    // Program headers of the wrong size are rejected
+    MemFD File(MakeELF<Elf32_Ehdr, Elf32_Phdr>(Notes, ELFCLASS32));
+    CHECK(FEXCore::ELF::GetBuildId<Elf64_Ehdr, Elf64_Phdr>(File.FD).empty());
+  }
+
+  SECTION("Truncated note segment") {
+    auto Contents = MakeELF<Elf64_Ehdr, Elf64_Phdr>(Notes, ELFCLASS64);
+    Contents.resize(Contents.size() - 1);
+    MemFD File(Contents);
+    CHECK(FEXCore::ELF::GetBuildId<Elf64_Ehdr, Elf64_Phdr>(File.FD).empty());
+  }
+
+  SECTION("Truncated program headers") {
+    auto Contents = MakeELF<Elf64_Ehdr, Elf64_Phdr>(Notes, ELFCLASS64);
+    Contents.resize(sizeof(Elf64_Ehdr) + sizeof(Elf64_Phdr));
+    MemFD File(Contents);
+    CHECK(FEXCore::ELF::GetBuildId<Elf64_Ehdr, Elf64_Phdr>(File.FD).empty());
+  }
+
+  SECTION("Truncated header") {
+    auto Contents = MakeELF<Elf64_Ehdr, Elf64_Phdr>(Notes, ELFCLASS64);
+    Contents.resize(sizeof(Elf64_Ehdr) - 1);
+    MemFD File(Contents);
+    CHECK(FEXCore::ELF::GetBuildId<Elf64_Ehdr, Elf64_Phdr>(File.FD).empty());
+  }
+}
@@ -0,0 +1,128 @@
+#include <catch2/catch.hpp>
+#include "Common/RecyclePool.h"
+
+#include <FEXCore/fextl/memory.h>
+
+#include <algorithm>
+#include <array>
+
+// Exited guest threads hand their code buffers and lookup caches to these pools for new threads to reuse.
+
+namespace {
+constexpr size_t MaxEntries = 4;
+
+struct Buffer {
+  size_t Size;
+  int ID;
+};
+}
+
+TEST_CASE("RecyclePool - Freed entries are reused") {
+  FEXCore::RecyclePool<fextl::unique_ptr<int>, MaxEntries> Pool;
+  CHECK_FALSE(Pool.Take());
+
+  auto Entry = fextl::make_unique<int>(1);
+  const auto Allocation = Entry.get();
+  REQUIRE(Pool.Recycle(std::move(Entry)));
+  CHECK(Pool.Size() == 1);
+
+  // The same allocation comes back out, not a copy of it
+  auto Reused = Pool.Take();
+  REQUIRE(Reused);
+  CHECK(Reused->get() == Allocation);
+  CHECK(**Reused == 1);
+  CHECK(Pool.Size() == 0);
+  CHECK_FALSE(Pool.Take());
+
+  // And can be recycled again once the next owner is done with it
+  REQUIRE(Pool.Recycle(std::move(*Reused)));
+  auto ReusedAgain = Pool.Take();
+  REQUIRE(ReusedAgain);
+  CHECK(ReusedAgain->get() == Allocation);
+}
+
+TEST_CASE("RecyclePool - Pool limit") {
+  FEXCore::RecyclePool<fextl::unique_ptr<int>, MaxEntries> Pool;
+
+  std::array<int*, MaxEntries> Allocations;
+  for (size_t i = 0; i < MaxEntries; ++i) {
+    auto Entry = fextl::make_unique<int>(i);
+    Allocations[i] = Entry.get();
+    REQUIRE(Pool.Recycle(std::move(Entry)));
+  }
+  CHECK(Pool.Size() == MaxEntries);
+
+  // A full pool leaves the entry with the caller to free
+  auto Rejected = fextl::make_unique<int>(MaxEntries);
+  const auto RejectedAllocation = Rejected.get();
+  CHECK_FALSE(Pool.Recycle(std::move(Rejected)));
+  CHECK(Rejected.get() == RejectedAllocation);
+  CHECK(Pool.Size() == MaxEntries);
+
+  // Taking one out makes room again
+  auto Taken = Pool.Take();
+  REQUIRE(Taken);
+  REQUIRE(Pool.Recycle(std::move(Rejected)));
+  CHECK(Pool.Size() == MaxEntries);
+
+  // Exactly the entries the pool accepted come back out
+  auto Expected = Allocations;
+  *std::find(Expected.begin(), Expected.end(), Taken->get()) = RejectedAllocation;
+
+  std::array<fextl::unique_ptr<int>, MaxEntries> Entries;
+  std::array<int*, MaxEntries> Reused;
+  for (size_t i = 0; i < MaxEntries; ++i) {
+    auto Entry = Pool.Take();
+    REQUIRE(Entry);
+    Entries[i] = std::move(*Entry);
+    Reused[i] = Entries[i].get();
+  }
+  CHECK_FALSE(Pool.Take());
+
+  std::sort(Expected.begin(), Expected.end());
+  std::sort(Reused.begin(), Reused.end());
+  CHECK(Reused == Expected);
+}
+
+TEST_CASE("RecyclePool - Taking a code buffer that fits") {
+  FEXCore::RecyclePool<Buffer, MaxEntries> Pool;
+  REQUIRE(Pool.Recycle({.Size = 0x1000, .ID = 0}));
+  REQUIRE(Pool.Recycle({.Size = 0x4000, .ID = 1}));
+  REQUIRE(Pool.Recycle({.Size = 0x2000, .ID = 2}));
+
+  const auto Fits = [](size_t Size) {
+    return [Size](const Buffer &Recycled) {
+      return Recycled.Size >= Size;
+    };
+  };
+
+  // Nothing is big enough, the pool is left alone
+  CHECK_FALSE(Pool.Take(Fits(0x8000)));
+  CHECK(Pool.Size() == 3);
+
+  auto Taken = Pool.Take(Fits(0x2000));
+  REQUIRE(Taken);
+  CHECK(Taken->ID == 1);
+
+  Taken = Pool.Take(Fits(0x2000));
+  REQUIRE(Taken);
+  CHECK(Taken->ID == 2);
+
+  CHECK_FALSE(Pool.Take(Fits(0x2000)));
+  CHECK(Pool.Size() == 1);
+}
+
+TEST_CASE("RecyclePool - Clear frees every entry") {
+  FEXCore::RecyclePool<Buffer, MaxEntries> Pool;
+  REQUIRE(Pool.Recycle({.Size = 0x1000, .ID = 0}));
+  REQUIRE(Pool.Recycle({.Size = 0x1000, .ID = 1}));
+
+  int Freed {};
+  Pool.Clear([&Freed](Buffer &Recycled) {
+    Freed |= 1 << Recycled.ID;
+  });
+
+  CHECK(Freed == 0b11);
+  CHECK(Pool.Size() == 0);
+  CHECK_FALSE(Pool.Take());
+}
@@ -0,0 +1,85 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x40000001",
+    "RBX": "0x49584546",
+    "RCX": "0x49584546",
+    "RDX": "0x554d45",
+    "R15": "0"
+  },
+  "MemoryRegions": {
+    "0x100000000": "4096"
+  }
+}
+%endif
+
+; CPUID and XGETBV with constant arguments get folded in to constants.
+; Each function is run once with constant arguments and once with arguments loaded from memory,
+; which always calls the handler. Any difference is accumulated in to r15.
+
+mov rdi, 0x100000000
+mov r15, 0
+
+%macro compare_cpuid 2
+  mov eax, %1
+  mov ecx, %2
+  cpuid
+  mov [rdi + 0], eax
+  mov [rdi + 4], ebx
+  mov [rdi + 8], ecx
+  mov [rdi + 12], edx
+
+  mov dword [rdi + 16], %1
+  mov dword [rdi + 20], %2
+  mov eax, [rdi + 16]
+  mov ecx, [rdi + 20]
+  cpuid
+  xor eax, [rdi + 0]
+  xor ebx, [rdi + 4]
+  xor ecx, [rdi + 8]
+  xor edx, [rdi + 12]
+  or eax, ebx
+  or eax, ecx
+  or eax, edx
+  or r15d, eax
+%endmacro
+
+compare_cpuid 0x0, 0
+compare_cpuid 0x1, 0
+compare_cpuid 0x6, 0
+compare_cpuid 0x7, 0
+compare_cpuid 0x7, 1
+compare_cpuid 0xD, 0
+compare_cpuid 0xD, 1
+compare_cpuid 0x8000_0000, 0
+compare_cpuid 0x8000_0001, 0
+compare_cpuid 0x8000_0008, 0
+compare_cpuid 0x4000_0001, 0
+
+; XGETBV is only available with OSXSAVE
+mov eax, 1
+mov ecx, 0
+cpuid
+bt ecx, 27
+jnc no_xgetbv
+
+mov ecx, 0
+xgetbv
+mov [rdi + 0], eax
+mov [rdi + 4], edx
+
+mov dword [rdi + 16], 0
+mov ecx, [rdi + 16]
+xgetbv
+xor eax, [rdi + 0]
+xor edx, [rdi + 4]
+or eax, edx
+or r15d, eax
+
+no_xgetbv:
+; The folded values are FEX's, the hypervisor information leaf has a known signature
+mov eax, 0x4000_0000
+mov ecx, 0
+cpuid
+
+hlt
@@ -0,0 +1,59 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM0": ["0x92D299A97E8797B7", "0xDE826B0791ED3CAA"],
+    "XMM1": ["0xEC224FF0D5135B97", "0x0F57BE26A65CA8BF"],
+    "XMM2": ["0x617F844ED171DD4B", "0x763010CE8781196F"],
+    "XMM3": ["0x13A706C0D086D143", "0x60C4C08C3A7C8E96"],
+    "XMM4": ["0x0123456789ABCDEF", "0xFEDCBA9876543210"]
+  }
+}
+%endif
+
+; AES rounds are translated as a round with the XOR applied first, and ConstProp folds
+; the XOR between rounds in to the next round. PCLMUL cross product pairs are rewritten too.
+; Every round of the chains takes its key from the folded XOR, so no zero key is left.
+; IR-CHECK: = VAESEncRound
+; IR-CHECK: = VAESDecLastRound
+; IR-CHECK-NOT: = VectorZero
+; The cross products become a rotate and the 0x00 and 0x11 products.
+; IR-CHECK: = VExtr
+; IR-CHECK: = PCLMUL .*#0x11\b
+; IR-CHECK-NOT: = PCLMUL .*#0x(1|10)\b
+lea rdx, [rel .data]
+movaps xmm5, [rdx + 16]
+movaps xmm6, [rdx + 32]
+movaps xmm7, [rdx + 48]
+
+; Whitening and a round chain, with an intermediate state that stays visible
+movaps xmm0, [rdx]
+pxor xmm0, xmm5
+aesenc xmm0, xmm6
+movaps xmm1, xmm0
+aesenc xmm0, xmm7
+aesenclast xmm0, xmm5
+
+; Decryption chain with a round that uses the state as its key
+movaps xmm2, [rdx]
+pxor xmm2, xmm6
+aesdec xmm2, xmm7
+aesdec xmm2, xmm2
+aesdeclast xmm2, xmm5
+
+; Cross products of a carryless multiply
+movaps xmm3, [rdx + 64]
+movaps xmm4, xmm3
+pclmulqdq xmm3, xmm6, 0x10
+pclmulqdq xmm4, xmm6, 0x01
+pxor xmm3, xmm4
+movaps xmm4, [rdx + 64]
+
+hlt
+
+align 16
+.data:
+dq 0x0011223344556677, 0x8899AABBCCDDEEFF
+dq 0x2B7E151628AED2A6, 0xABF7158809CF4F3C
+dq 0xA0FAFE1788542CB1, 0x23A339392A6C7605
+dq 0xF2C295F27A96B943, 0x5935807A7359F67F
+dq 0x0123456789ABCDEF, 0xFEDCBA9876543210
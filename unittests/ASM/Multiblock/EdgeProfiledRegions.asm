@@ -0,0 +1,61 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x302EE",
+    "RBX": "0x3",
+    "RCX": "0x0",
+    "RDX": "0x0",
+    "R15": "0x3"
+  },
+  "Env": { "FEX_MULTIBLOCKEDGETHRESHOLD" : "8" }
+}
+%endif
+
+; Regions get recompiled with their hot branch targets partway through each phase.
+; The rare and error paths stay side exits of the recompiled regions.
+; Between phases the hot path's add is patched. The formed region holds a copy of it,
+; so a stale region or a profile that outlived the invalidation gives the wrong sum.
+mov rax, 0
+mov rbx, 0
+mov rdx, 0
+mov r15, 0
+
+phase:
+mov rcx, 200
+
+loop_top:
+test rcx, 3
+jz quarter
+
+hot_add:
+; add rax, 1
+db 0x48, 0x83, 0xC0, 0x01
+jmp next
+
+quarter:
+sub rax, 1
+
+next:
+cmp rcx, 100
+jne no_rare
+inc rbx
+add rax, 0x10000
+
+no_rare:
+cmp rcx, 0x10000
+ja error
+dec rcx
+jnz loop_top
+
+; The next phase adds one more on the hot path
+inc byte [rel hot_add + 3]
+inc r15
+cmp r15, 3
+jb phase
+jmp done
+
+error:
+mov rdx, -1
+
+done:
+hlt
@@ -0,0 +1,148 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x0",
+    "R14": "0x4C0"
+  }
+}
+%endif
+
+; REP MOVS of every element size against the same copy done one MOVS at a time.
+; The counts go from nothing to 160 bytes, so they cover copies shorter than, exactly and longer than
+; a 32 byte loop iteration and sizes that aren't a multiple of 32.
+; Both the aligned and an unaligned source and destination are copied, in both directions.
+; RAX counts the bytes and final registers that differ, R14 the cases that ran.
+
+%define SRC    0xe0000000
+%define BUF1   0xe0004000
+%define BUF2   0xe0006000
+%define WINDOW 512
+
+; %1 = instruction, %2 = direction flag
+%macro movs_case 2
+  call reset_buffers
+
+  mov rsi, SRC + 0x100 + %2 * 0x200
+  add rsi, r12
+  mov rdi, BUF1 + 0x100 + %2 * 0x80
+  lea rdi, [rdi + r12 * 2 + 1]
+  mov rcx, r13
+%if %2
+  std
+%else
+  cld
+%endif
+  rep %1
+  mov r8, rsi
+  mov r9, rdi
+  mov r10, rcx
+
+  mov rsi, SRC + 0x100 + %2 * 0x200
+  add rsi, r12
+  mov rdi, BUF2 + 0x100 + %2 * 0x80
+  lea rdi, [rdi + r12 * 2 + 1]
+  mov rcx, r13
+%%element:
+  test rcx, rcx
+  jz %%element_done
+  %1
+  dec rcx
+  jmp %%element
+%%element_done:
+  cld
+
+  cmp r8, rsi
+  je %%rsi_same
+  inc r15
+%%rsi_same:
+  sub r9, BUF1 - BUF2
+  cmp r9, rdi
+  je %%rdi_same
+  inc r15
+%%rdi_same:
+  test r10, r10
+  jz %%rcx_same
+  inc r15
+%%rcx_same:
+
+  call compare_buffers
+  inc r14
+%endmacro
+
+; %1 = instruction, %2 = element size, %3 = direction flag
+%macro movs_sizes 3
+  xor r12, r12
+%%offset:
+  xor r13, r13
+%%count:
+  movs_case %1, %3
+  inc r13
+  cmp r13, 160 / %2
+  jbe %%count
+  add r12, 3
+  cmp r12, 3
+  jbe %%offset
+%endmacro
+
+call fill_source
+xor r14, r14
+xor r15, r15
+
+movs_sizes movsb, 1, 0
+movs_sizes movsw, 2, 0
+movs_sizes movsd, 4, 0
+movs_sizes movsq, 8, 0
+movs_sizes movsb, 1, 1
+movs_sizes movsw, 2, 1
+movs_sizes movsd, 4, 1
+movs_sizes movsq, 8, 1
+
+mov rax, r15
+hlt
+
+; Bytes that don't repeat within the buffers
+fill_source:
+  mov rdi, SRC
+  xor ecx, ecx
+.loop:
+  mov eax, ecx
+  imul eax, eax, 37
+  mov edx, ecx
+  shr edx, 8
+  imul edx, edx, 101
+  add eax, edx
+  add eax, 11
+  mov [rdi + rcx], al
+  inc ecx
+  cmp ecx, 0x2000
+  jb .loop
+  ret
+
+reset_buffers:
+  mov rsi, SRC + 0x1000
+  mov rdi, BUF1
+  mov rdx, BUF2
+  xor ecx, ecx
+.loop:
+  mov rax, [rsi + rcx * 8]
+  mov [rdi + rcx * 8], rax
+  mov [rdx + rcx * 8], rax
+  inc ecx
+  cmp ecx, WINDOW / 8
+  jb .loop
+  ret
+
+compare_buffers:
+  mov rsi, BUF1
+  mov rdi, BUF2
+  xor ecx, ecx
+.loop:
+  mov rax, [rsi + rcx * 8]
+  cmp rax, [rdi + rcx * 8]
+  je .same
+  inc r15
+.same:
+  inc ecx
+  cmp ecx, WINDOW / 8
+  jb .loop
+  ret
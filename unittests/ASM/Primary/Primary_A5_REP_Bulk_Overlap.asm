@@ -0,0 +1,148 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x0",
+    "R14": "0x430"
+  }
+}
+%endif
+
+; REP MOVS within one buffer, against the same copy done one MOVS at a time.
+; The destination is from 33 bytes before to 33 bytes after the source, which covers
+; every distance below a 32 byte loop iteration, exactly one iteration and just past it.
+; Copies that overlap replicate the leading elements, so they can't be done 32 bytes at a time.
+; Every element size is copied in both directions.
+; RAX counts the bytes and final registers that differ, R14 the cases that ran.
+
+%define SRC    0xe0000000
+%define BUF1   0xe0004000
+%define BUF2   0xe0006000
+%define WINDOW 512
+
+; %1 = instruction, %2 = direction flag
+%macro overlap_case 2
+  call reset_buffers
+
+  mov rsi, BUF1 + 0x100 + %2 * 0x80
+  lea rdi, [rsi + r12]
+  mov rcx, r13
+%if %2
+  std
+%else
+  cld
+%endif
+  rep %1
+  mov r8, rsi
+  mov r9, rdi
+  mov r10, rcx
+
+  mov rsi, BUF2 + 0x100 + %2 * 0x80
+  lea rdi, [rsi + r12]
+  mov rcx, r13
+%%element:
+  test rcx, rcx
+  jz %%element_done
+  %1
+  dec rcx
+  jmp %%element
+%%element_done:
+  cld
+
+  sub r8, BUF1 - BUF2
+  cmp r8, rsi
+  je %%rsi_same
+  inc r15
+%%rsi_same:
+  sub r9, BUF1 - BUF2
+  cmp r9, rdi
+  je %%rdi_same
+  inc r15
+%%rdi_same:
+  test r10, r10
+  jz %%rcx_same
+  inc r15
+%%rcx_same:
+
+  call compare_buffers
+  inc r14
+%endmacro
+
+; %1 = instruction, %2 = element count, %3 = direction flag
+%macro overlap_distances 3
+  mov r13, %2
+  mov r12, -33
+%%distance:
+  overlap_case %1, %3
+  inc r12
+  cmp r12, 33
+  jle %%distance
+%endmacro
+
+; %1 = instruction, %2 = element size, %3 = direction flag
+%macro overlap_sizes 3
+  overlap_distances %1, 64 / %2, %3
+  overlap_distances %1, 100 / %2, %3
+%endmacro
+
+call fill_source
+xor r14, r14
+xor r15, r15
+
+overlap_sizes movsb, 1, 0
+overlap_sizes movsw, 2, 0
+overlap_sizes movsd, 4, 0
+overlap_sizes movsq, 8, 0
+overlap_sizes movsb, 1, 1
+overlap_sizes movsw, 2, 1
+overlap_sizes movsd, 4, 1
+overlap_sizes movsq, 8, 1
+
+mov rax, r15
+hlt
+
+; Bytes that don't repeat within the buffers
+fill_source:
+  mov rdi, SRC
+  xor ecx, ecx
+.loop:
+  mov eax, ecx
+  imul eax, eax, 37
+  mov edx, ecx
+  shr edx, 8
+  imul edx, edx, 101
+  add eax, edx
+  add eax, 11
+  mov [rdi + rcx], al
+  inc ecx
+  cmp ecx, 0x2000
+  jb .loop
+  ret
+
+reset_buffers:
+  mov rsi, SRC + 0x1000
+  mov rdi, BUF1
+  mov rdx, BUF2
+  xor ecx, ecx
+.loop:
+  mov rax, [rsi + rcx * 8]
+  mov [rdi + rcx * 8], rax
+  mov [rdx + rcx * 8], rax
+  inc ecx
+  cmp ecx, WINDOW / 8
+  jb .loop
+  ret
+
+compare_buffers:
+  mov rsi, BUF1
+  mov rdi, BUF2
+  xor ecx, ecx
+.loop:
+  mov rax, [rsi + rcx * 8]
+  cmp rax, [rdi + rcx * 8]
+  je .same
+  inc r15
+.same:
+  inc ecx
+  cmp ecx, WINDOW / 8
+  jb .loop
+  ret
@@ -0,0 +1,37 @@
+%ifdef CONFIG
+{
+  "HostFeatures": ["AVX"],
+  "RegData": {
+    "RCX": "0x0",
+    "XMM1": ["0x48C3500047C35000", "0x49C35000495BBA00", "0x4A5BBA004A189680", "0x4AC350004A958940"],
+    "XMM4": ["0x4843500047C35000", "0x48C3500048927C00", "0x49127C0048F42400", "0x49435000492AE600"]
+  }
+}
+%endif
+
+; 256-bit packed single precision multiply and accumulate.
+lea rdx, [rel .data]
+vmovaps ymm0, [rdx]
+vxorps ymm1, ymm1, ymm1
+vxorps ymm4, ymm4, ymm4
+mov rcx, 100000
+
+loop_top:
+vmulps ymm3, ymm0, ymm0
+vaddps ymm1, ymm1, ymm3
+vaddps ymm4, ymm4, ymm0
+dec rcx
+jnz loop_top
+
+hlt
+
+align 32
+.data:
+dd 0x3F800000 ; 1.0
+dd 0x40000000 ; 2.0
+dd 0x40400000 ; 3.0
+dd 0x40800000 ; 4.0
+dd 0x40A00000 ; 5.0
+dd 0x40C00000 ; 6.0
+dd 0x40E00000 ; 7.0
+dd 0x41000000 ; 8.0
@@ -0,0 +1,36 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x13880",
+    "RCX": "0x0"
+  }
+}
+%endif
+
+; Three deep call/return chain per iteration.
+jmp start
+
+func3:
+add rax, 2
+ret
+
+func2:
+call func3
+inc rax
+ret
+
+func1:
+call func2
+inc rax
+ret
+
+start:
+mov rcx, 20000
+xor rax, rax
+
+loop_top:
+call func1
+dec rcx
+jnz loop_top
+
+hlt
@@ -0,0 +1,85 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0x0",
+    "RAX": "0x2CA9FE6F",
+    "XMM0": ["0xEE4D57E79D5A47DE", "0xC8EF73DCD69A0F90"],
+    "XMM1": ["0x51490CA10F6B5C90", "0x3EEAB60E1EB28DC7"],
+    "XMM2": ["0xF7DFC5C6E20ED729", "0x0F1E2D3CE8496DFA"]
+  }
+}
+%endif
+
+; Crypto kernels the way libraries write them.
+; An AES-128 encryption and decryption of one block, a PCLMUL CRC folding step and CRC32C over the same data.
+; Every kernel is a dependency chain through the loop so the time follows the length of the host sequences.
+; The loop runs long enough that the time of a native run isn't lost in the process startup.
+lea rdx, [rel .data]
+movaps xmm0, [rdx]
+movaps xmm1, [rdx]
+movaps xmm8, [rdx + 16]
+movaps xmm9, [rdx + 32]
+movaps xmm10, [rdx + 48]
+movaps xmm11, [rdx + 64]
+movaps xmm2, [rdx + 80]
+movaps xmm3, [rdx + 96]
+mov eax, 0xFFFFFFFF
+mov rcx, 10000000
+
+loop_top:
+; Key whitening then the AES rounds
+pxor xmm0, xmm8
+aesenc xmm0, xmm9
+aesenc xmm0, xmm10
+aesenc xmm0, xmm11
+aesenc xmm0, xmm8
+aesenc xmm0, xmm9
+aesenc xmm0, xmm10
+aesenc xmm0, xmm11
+aesenc xmm0, xmm8
+aesenc xmm0, xmm9
+aesenclast xmm0, xmm10
+
+pxor xmm1, xmm8
+aesdec xmm1, xmm9
+aesdec xmm1, xmm10
+aesdec xmm1, xmm11
+aesdec xmm1, xmm8
+aesdec xmm1, xmm9
+aesdec xmm1, xmm10
+aesdec xmm1, xmm11
+aesdec xmm1, xmm8
+aesdec xmm1, xmm9
+aesdeclast xmm1, xmm10
+
+; Folds the accumulator through the constant with the two cross products
+movdqa xmm4, xmm2
+pclmulqdq xmm2, xmm3, 0x01
+pclmulqdq xmm4, xmm3, 0x10
+pxor xmm2, xmm4
+movdqa xmm4, [rdx + 112]
+pxor xmm2, xmm4
+
+crc32 rax, qword [rdx + 112]
+crc32 rax, qword [rdx + 120]
+
+dec rcx
+jnz loop_top
+
+hlt
+
+align 16
+.data:
+; Block
+dq 0x0011223344556677, 0x8899AABBCCDDEEFF
+; Round keys
+dq 0x2B7E151628AED2A6, 0xABF7158809CF4F3C
+dq 0xA0FAFE1788542CB1, 0x23A339392A6C7605
+dq 0xF2C295F27A96B943, 0x5935807A7359F67F
+dq 0x3D80477D4716FE3E, 0x1E237E446D7A883B
+; Fold accumulator
+dq 0x0123456789ABCDEF, 0xFEDCBA9876543210
+; Fold constant
+dq 0x00000001C6E41596, 0x0000000154442BD4
+; Data
+dq 0xDEADBEEFCAFEF00D, 0x0F1E2D3C4B5A6978
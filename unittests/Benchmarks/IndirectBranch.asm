@@ -0,0 +1,46 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x3D090",
+    "RBX": "0x1",
+    "RCX": "0x0"
+  }
+}
+%endif
+
+; Jump table dispatch cycling through four targets.
+mov rdx, 0xe0000000
+lea rbx, [rel target0]
+mov [rdx + 8 * 0], rbx
+lea rbx, [rel target1]
+mov [rdx + 8 * 1], rbx
+lea rbx, [rel target2]
+mov [rdx + 8 * 2], rbx
+lea rbx, [rel target3]
+mov [rdx + 8 * 3], rbx
+
+mov rcx, 100000
+xor rax, rax
+
+loop_top:
+mov rbx, rcx
+and rbx, 3
+jmp [rdx + rbx * 8]
+
+target0:
+add rax, 1
+jmp next
+target1:
+add rax, 2
+jmp next
+target2:
+add rax, 3
+jmp next
+target3:
+add rax, 4
+
+next:
+dec rcx
+jnz loop_top
+
+hlt
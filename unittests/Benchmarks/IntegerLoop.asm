@@ -0,0 +1,26 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0xD75509B0F4806940",
+    "RBX": "0xAEAA1361E901F5C5",
+    "RCX": "0x0",
+    "RDX": "0xD16E6457D21A3559"
+  }
+}
+%endif
+
+; Dependent integer ALU chain in a tight loop.
+mov rcx, 100000
+mov rax, 0
+mov rbx, 0x12345
+mov rdx, 0
+
+loop_top:
+add rax, rbx
+imul rbx, rbx, 3
+xor rdx, rax
+ror rdx, 7
+dec rcx
+jnz loop_top
+
+hlt
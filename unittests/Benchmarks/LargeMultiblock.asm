@@ -0,0 +1,25 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0xF3E58",
+    "RCX": "0x7D0"
+  }
+}
+%endif
+
+; A single large function of short branchy blocks that only runs once.
+; Execution is dominated by compiling it, so this measures compile throughput.
+xor rax, rax
+xor rcx, rcx
+
+%assign i 0
+%rep 2000
+test rcx, 1
+jnz skip_%[i]
+add rax, i
+skip_%[i]:
+inc rcx
+%assign i i+1
+%endrep
+
+hlt
@@ -0,0 +1,21 @@
+#pragma once
+
+// Shared by the guest Linux benchmarks.
+// Each loop prints one line that Scripts/guest_linux_benchmark_runner.py collects:
+//   Rate: <Name> <calls per second>
+// Correctness is covered by FEXLinuxTests, the loops here don't check their results.
+
+#include <chrono>
+#include <stdio.h>
+
+template<typename Fn>
+static void MeasureRate(const char *Name, int Iterations, Fn &&Body) {
+  const auto Start = std::chrono::steady_clock::now();
+  for (int i = 0; i < Iterations; ++i) {
+    Body();
+  }
+  const auto End = std::chrono::steady_clock::now();
+
+  const double Seconds = std::chrono::duration<double>(End - Start).count();
+  printf("Rate: %s %.0f\n", Name, Iterations / Seconds);
+}
@@ -0,0 +1,128 @@
+// Event loop style syscalls in a tight loop.
+// These are the syscalls where 32-bit guests need their arrays converted, the rates compare marshaling overhead.
+// The futex and mmap loops don't block or convert much, so their rates mostly show the cost of entering a syscall handler.
+
+#include "rate.h"
+
+#include <cstdint>
+#include <linux/futex.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+constexpr int NumFDs = 64;
+constexpr int Iterations = 20000;
+
+int main() {
+  // Every fd is readable and stays readable since nothing reads the counter
+  int FDs[NumFDs];
+  int MaxFD = 0;
+  for (int i = 0; i < NumFDs; ++i) {
+    FDs[i] = eventfd(1, EFD_CLOEXEC);
+    MaxFD = FDs[i] > MaxFD ? FDs[i] : MaxFD;
+  }
+
+  int EPFD = epoll_create1(EPOLL_CLOEXEC);
+  for (int i = 0; i < NumFDs; ++i) {
+    epoll_event Event{};
+    Event.events = EPOLLIN;
+    Event.data.u64 = i;
+    epoll_ctl(EPFD, EPOLL_CTL_ADD, FDs[i], &Event);
+  }
+
+  epoll_event Events[NumFDs]{};
+  MeasureRate("epoll_wait", Iterations, [&]() { epoll_wait(EPFD, Events, NumFDs, 0); });
+
+  pollfd PollFDs[NumFDs]{};
+  for (int i = 0; i < NumFDs; ++i) {
+    PollFDs[i].fd = FDs[i];
+    PollFDs[i].events = POLLIN;
+  }
+  MeasureRate("poll", Iterations, [&]() { poll(PollFDs, NumFDs, 0); });
+
+  fd_set Read;
+  MeasureRate("select", Iterations, [&]() {
+    FD_ZERO(&Read);
+    for (int FD : FDs) {
+      FD_SET(FD, &Read);
+    }
+
+    timeval Timeout{};
+    select(MaxFD + 1, &Read, nullptr, nullptr, &Timeout);
+  });
+
+  constexpr int NumIOVecs = 4;
+  constexpr size_t SegmentSize = 16;
+  char Send[NumIOVecs][SegmentSize]{};
+  char Receive[NumIOVecs][SegmentSize];
+  iovec SendIOV[NumIOVecs];
+  iovec ReceiveIOV[NumIOVecs];
+  for (int i = 0; i < NumIOVecs; ++i) {
+    SendIOV[i] = {Send[i], SegmentSize};
+    ReceiveIOV[i] = {Receive[NumIOVecs - 1 - i], SegmentSize};
+  }
+
+  int Pipe[2];
+  pipe(Pipe);
+  MeasureRate("writev+readv", Iterations, [&]() {
+    writev(Pipe[1], SendIOV, NumIOVecs);
+    readv(Pipe[0], ReceiveIOV, NumIOVecs);
+  });
+
+  int Sockets[2];
+  socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, Sockets);
+
+  msghdr SendHeader{};
+  SendHeader.msg_iov = SendIOV;
+  SendHeader.msg_iovlen = NumIOVecs;
+  msghdr ReceiveHeader{};
+  ReceiveHeader.msg_iov = ReceiveIOV;
+  ReceiveHeader.msg_iovlen = NumIOVecs;
+  MeasureRate("sendmsg+recvmsg", Iterations, [&]() {
+    sendmsg(Sockets[0], &SendHeader, 0);
+    recvmsg(Sockets[1], &ReceiveHeader, 0);
+  });
+
+  constexpr int NumMessages = 8;
+  mmsghdr SendHeaders[NumMessages]{};
+  mmsghdr ReceiveHeaders[NumMessages]{};
+  for (int i = 0; i < NumMessages; ++i) {
+    SendHeaders[i].msg_hdr.msg_iov = &SendIOV[i % NumIOVecs];
+    SendHeaders[i].msg_hdr.msg_iovlen = 1;
+    ReceiveHeaders[i].msg_hdr.msg_iov = &ReceiveIOV[i % NumIOVecs];
+    ReceiveHeaders[i].msg_hdr.msg_iovlen = 1;
+  }
+  MeasureRate("sendmmsg+recvmmsg", Iterations, [&]() {
+    sendmmsg(Sockets[0], SendHeaders, NumMessages, 0);
+    recvmmsg(Sockets[1], ReceiveHeaders, NumMessages, 0, nullptr);
+  });
+
+  // Nothing is waiting, so this returns straight away
+  uint32_t Futex{};
+  MeasureRate("futex_wake", Iterations, [&]() { ::syscall(SYS_futex, &Futex, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0); });
+
+  const size_t PageSize = sysconf(_SC_PAGESIZE);
+  MeasureRate("mmap+munmap", Iterations, [&]() {
+    void *Page = mmap(nullptr, PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    *static_cast<volatile uint8_t*>(Page) = 1;
+    munmap(Page, PageSize);
+  });
+
+  close(Sockets[0]);
+  close(Sockets[1]);
+  close(Pipe[0]);
+  close(Pipe[1]);
+  close(EPFD);
+  for (int FD : FDs) {
+    close(FD);
+  }
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+// Time reads through the vDSO against the same reads as plain syscalls.
+// Under FEX the vDSO calls are thunked to the host vDSO, the rates compare the cost of that path.
+
+#include "rate.h"
+
+#include <sched.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+constexpr int Iterations = 1000000;
+
+int main() {
+  timespec Time{};
+  timeval Day{};
+
+  // glibc goes through the vDSO for these
+  MeasureRate("clock_gettime_vdso", Iterations, [&]() { clock_gettime(CLOCK_MONOTONIC, &Time); });
+  MeasureRate("gettimeofday_vdso", Iterations, [&]() { gettimeofday(&Day, nullptr); });
+  MeasureRate("time_vdso", Iterations, []() { time(nullptr); });
+  MeasureRate("getcpu_vdso", Iterations, []() { sched_getcpu(); });
+
+  MeasureRate("clock_gettime_syscall", Iterations, [&]() { ::syscall(SYS_clock_gettime, CLOCK_MONOTONIC, &Time); });
+  MeasureRate("gettimeofday_syscall", Iterations, [&]() { ::syscall(SYS_gettimeofday, &Day, nullptr); });
+
+  return 0;
+}
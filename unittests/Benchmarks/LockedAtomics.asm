@@ -0,0 +1,27 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x186A0",
+    "RBX": "0x186A0",
+    "RCX": "0x0"
+  }
+}
+%endif
+
+; Locked read-modify-write operations on the same cacheline.
+mov rdx, 0xe0000000
+mov qword [rdx], 0
+mov qword [rdx + 8], 0
+mov rcx, 100000
+
+loop_top:
+mov rax, 1
+lock xadd [rdx], rax
+lock inc qword [rdx + 8]
+dec rcx
+jnz loop_top
+
+mov rax, [rdx]
+mov rbx, [rdx + 8]
+
+hlt
@@ -0,0 +1,33 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RCX": "0x0",
+    "XMM1": ["0x48C3500047C35000", "0x49C35000495BBA00"],
+    "XMM4": ["0x4843500047C35000", "0x48C3500048927C00"]
+  }
+}
+%endif
+
+; Packed single precision multiply and accumulate.
+lea rdx, [rel .data]
+movaps xmm0, [rdx]
+xorps xmm1, xmm1
+xorps xmm4, xmm4
+mov rcx, 100000
+
+loop_top:
+movaps xmm3, xmm0
+mulps xmm3, xmm0
+addps xmm1, xmm3
+addps xmm4, xmm0
+dec rcx
+jnz loop_top
+
+hlt
+
+align 16
+.data:
+dd 0x3F800000 ; 1.0
+dd 0x40000000 ; 2.0
+dd 0x40400000 ; 3.0
+dd 0x40800000 ; 4.0
@@ -0,0 +1,33 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x4141414141414141",
+    "RCX": "0x0",
+    "RSI": "0xE0000400",
+    "RDI": "0xE0000800"
+  }
+}
+%endif
+
+; REP STOSB fill followed by a REP MOVSQ copy of the same kilobyte.
+mov rdx, 0xe0000000
+mov r8, 2000
+cld
+
+loop_top:
+mov rdi, rdx
+mov rcx, 1024
+mov eax, 0x41
+rep stosb
+
+mov rsi, rdx
+lea rdi, [rdx + 1024]
+mov rcx, 128
+rep movsq
+
+dec r8
+jnz loop_top
+
+mov rax, [rdx + 2040]
+
+hlt
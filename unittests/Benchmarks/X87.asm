@@ -0,0 +1,31 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x186A0",
+    "RCX": "0x0"
+  }
+}
+%endif
+
+; x87 stack add, subtract, multiply and divide.
+; Apart from the first iteration every op has normal operands and a normal result, so it takes the X80SoftFloat fast paths.
+mov rdx, 0xe0000000
+fld1
+fldz
+mov rcx, 100000
+
+loop_top:
+fadd st0, st1
+fld st0
+fmul st0, st0
+fdiv st0, st1
+fsub st0, st2
+fstp st0
+dec rcx
+jnz loop_top
+
+fistp qword [rdx]
+fstp st0
+mov rax, [rdx]
+
+hlt
@@ -0,0 +1,19 @@
+// Forks a child that keeps running after the test has finished.
+// Scripts/fastexec_runner.py runs this with FastExec, the child must not hold on to the parent's capture.
+
+#include <catch2/catch.hpp>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+TEST_CASE("fork with a child that outlives the parent") {
+  const pid_t Child = fork();
+  REQUIRE(Child != -1);
+
+  if (Child == 0) {
+    sleep(3);
+    _exit(0);
+  }
+
+  CHECK(Child > 0);
+}
@@ -0,0 +1,412 @@
+// Drives an io_uring through the raw syscalls, with the requests that 32-bit guests need converted.
+// Checks the data that went through the ring and that the guest's SQEs are left as the guest wrote them.
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+struct Ring {
+  Ring() {
+    io_uring_params Params{};
+    FD = ::syscall(__NR_io_uring_setup, 8, &Params);
+    if (FD == -1) {
+      return;
+    }
+
+    Entries = Params.sq_entries;
+    SQRingSize = Params.sq_off.array + Params.sq_entries * sizeof(uint32_t);
+    CQRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+    SQEsSize = Params.sq_entries * sizeof(io_uring_sqe);
+
+    SQRing = static_cast<uint8_t*>(mmap(nullptr, SQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_SQ_RING));
+    CQRing = static_cast<uint8_t*>(mmap(nullptr, CQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_CQ_RING));
+    SQEs = static_cast<io_uring_sqe*>(mmap(nullptr, SQEsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_SQES));
+    REQUIRE(SQRing != MAP_FAILED);
+    REQUIRE(CQRing != MAP_FAILED);
+    REQUIRE(SQEs != MAP_FAILED);
+
+    SQOff = Params.sq_off;
+    CQOff = Params.cq_off;
+  }
+
+  ~Ring() {
+    if (FD == -1) {
+      return;
+    }
+
+    munmap(SQEs, SQEsSize);
+    munmap(CQRing, CQRingSize);
+    munmap(SQRing, SQRingSize);
+    close(FD);
+  }
+
+  uint32_t *SQWord(uint32_t Offset) { return reinterpret_cast<uint32_t*>(SQRing + Offset); }
+  uint32_t *CQWord(uint32_t Offset) { return reinterpret_cast<uint32_t*>(CQRing + Offset); }
+
+  // Each test uses a different SQE slot so the slot a request came from is checked too
+  io_uring_sqe *GetSQE(uint32_t Index) {
+    io_uring_sqe *SQE = &SQEs[Index % Entries];
+    memset(SQE, 0, sizeof(*SQE));
+    return SQE;
+  }
+
+  // Submits the SQE through EnterFD and waits for its completion
+  int32_t SubmitAndWait(io_uring_sqe *SQE, int EnterFD) {
+    const uint32_t Mask = *SQWord(SQOff.ring_mask);
+    const uint32_t Tail = *SQWord(SQOff.tail);
+    SQWord(SQOff.array)[Tail & Mask] = SQE - SQEs;
+    __atomic_store_n(SQWord(SQOff.tail), Tail + 1, __ATOMIC_RELEASE);
+
+    const long Submitted = ::syscall(__NR_io_uring_enter, EnterFD, 1, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    REQUIRE(Submitted == 1);
+
+    const uint32_t Head = *CQWord(CQOff.head);
+    REQUIRE(__atomic_load_n(CQWord(CQOff.tail), __ATOMIC_ACQUIRE) != Head);
+
+    const auto *CQEs = reinterpret_cast<const io_uring_cqe*>(CQRing + CQOff.cqes);
+    const io_uring_cqe &CQE = CQEs[Head & *CQWord(CQOff.ring_mask)];
+    CHECK(CQE.user_data == SQE->user_data);
+    const int32_t Result = CQE.res;
+    __atomic_store_n(CQWord(CQOff.head), Head + 1, __ATOMIC_RELEASE);
+    return Result;
+  }
+
+  int FD {-1};
+  uint32_t Entries{};
+  io_sqring_offsets SQOff{};
+  io_cqring_offsets CQOff{};
+  uint8_t *SQRing{};
+  uint8_t *CQRing{};
+  io_uring_sqe *SQEs{};
+  size_t SQRingSize{};
+  size_t CQRingSize{};
+  size_t SQEsSize{};
+};
+
+constexpr size_t NumSegments = 4;
+constexpr size_t SegmentSize = 16;
+
+// Requests that 32-bit guests can't have converted complete with -EINVAL instead
+constexpr bool Is32Bit = sizeof(void*) == 4;
+
+// io_uring can be disabled by the host, nothing to test then
+#define SKIP_IF_NO_IO_URING(Uring) \
+  if (Uring.FD == -1) { \
+    printf("io_uring_setup failed: %s\n", strerror(errno)); \
+    return; \
+  }
+
+TEST_CASE("io_uring: readv, writev and fixed buffers") {
+  Ring Uring;
+  SKIP_IF_NO_IO_URING(Uring);
+
+  int Pipe[2];
+  REQUIRE(pipe(Pipe) == 0);
+
+  char Send[NumSegments][SegmentSize];
+  char Receive[NumSegments][SegmentSize];
+  iovec SendIOV[NumSegments];
+  iovec ReceiveIOV[NumSegments];
+
+  // Reads in to the segments in reverse order to check every iovec is converted
+  for (size_t i = 0; i < NumSegments; ++i) {
+    memset(Send[i], 'a' + i, SegmentSize);
+    SendIOV[i] = {Send[i], SegmentSize};
+    ReceiveIOV[i] = {Receive[NumSegments - 1 - i], SegmentSize};
+  }
+
+  {
+    io_uring_sqe *SQE = Uring.GetSQE(0);
+    SQE->opcode = IORING_OP_WRITEV;
+    SQE->fd = Pipe[1];
+    SQE->addr = reinterpret_cast<uintptr_t>(SendIOV);
+    SQE->len = NumSegments;
+    SQE->user_data = 0x1234'5678'9ABC'DEF0ULL;
+    CHECK(Uring.SubmitAndWait(SQE, Uring.FD) == NumSegments * SegmentSize);
+
+    // The SQE still holds the guest's pointer
+    CHECK(SQE->addr == reinterpret_cast<uintptr_t>(SendIOV));
+    CHECK(SQE->opcode == IORING_OP_WRITEV);
+  }
+
+  {
+    // Through a duplicate of the ring fd
+    const int DupFD = dup(Uring.FD);
+    REQUIRE(DupFD != -1);
+
+    io_uring_sqe *SQE = Uring.GetSQE(1);
+    SQE->opcode = IORING_OP_READV;
+    SQE->fd = Pipe[0];
+    SQE->addr = reinterpret_cast<uintptr_t>(ReceiveIOV);
+    SQE->len = NumSegments;
+    SQE->user_data = 2;
+    CHECK(Uring.SubmitAndWait(SQE, DupFD) == NumSegments * SegmentSize);
+    close(DupFD);
+
+    for (size_t i = 0; i < NumSegments; ++i) {
+      CHECK(memcmp(Receive[NumSegments - 1 - i], Send[i], SegmentSize) == 0);
+    }
+  }
+
+  {
+    char Fixed[2][SegmentSize];
+    memset(Fixed[0], 'x', SegmentSize);
+    memset(Fixed[1], 'y', SegmentSize);
+    iovec FixedIOV[2] = {{Fixed[0], SegmentSize}, {Fixed[1], SegmentSize}};
+    REQUIRE(::syscall(__NR_io_uring_register, Uring.FD, IORING_REGISTER_BUFFERS, FixedIOV, 2) == 0);
+
+    io_uring_sqe *SQE = Uring.GetSQE(2);
+    SQE->opcode = IORING_OP_WRITE_FIXED;
+    SQE->fd = Pipe[1];
+    SQE->addr = reinterpret_cast<uintptr_t>(Fixed[1]);
+    SQE->len = SegmentSize;
+    SQE->buf_index = 1;
+    SQE->user_data = 3;
+    CHECK(Uring.SubmitAndWait(SQE, Uring.FD) == SegmentSize);
+
+    char Data[SegmentSize];
+    REQUIRE(read(Pipe[0], Data, SegmentSize) == SegmentSize);
+    CHECK(memcmp(Data, Fixed[1], SegmentSize) == 0);
+
+    CHECK(::syscall(__NR_io_uring_register, Uring.FD, IORING_UNREGISTER_BUFFERS, nullptr, 0) == 0);
+  }
+
+  close(Pipe[0]);
+  close(Pipe[1]);
+}
+
+TEST_CASE("io_uring: sendmsg and recvmsg") {
+  Ring Uring;
+  SKIP_IF_NO_IO_URING(Uring);
+
+  int Sockets[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_DGRAM, 0, Sockets) == 0);
+
+  char Send[NumSegments][SegmentSize];
+  iovec SendIOV[NumSegments];
+  for (size_t i = 0; i < NumSegments; ++i) {
+    memset(Send[i], 'k' + i, SegmentSize);
+    SendIOV[i] = {Send[i], SegmentSize};
+  }
+
+  {
+    msghdr Header{};
+    Header.msg_iov = SendIOV;
+    Header.msg_iovlen = NumSegments;
+
+    io_uring_sqe *SQE = Uring.GetSQE(3);
+    SQE->opcode = IORING_OP_SENDMSG;
+    SQE->fd = Sockets[0];
+    SQE->addr = reinterpret_cast<uintptr_t>(&Header);
+    SQE->user_data = 4;
+    CHECK(Uring.SubmitAndWait(SQE, Uring.FD) == NumSegments * SegmentSize);
+    CHECK(SQE->addr == reinterpret_cast<uintptr_t>(&Header));
+    CHECK(SQE->opcode == IORING_OP_SENDMSG);
+
+    // One datagram with every segment in order
+    char Receive[NumSegments * SegmentSize];
+    REQUIRE(recv(Sockets[1], Receive, sizeof(Receive), 0) == sizeof(Receive));
+    for (size_t i = 0; i < NumSegments; ++i) {
+      CHECK(memcmp(&Receive[i * SegmentSize], Send[i], SegmentSize) == 0);
+    }
+  }
+
+  {
+    // Control data would need its headers resized
+    const int Passed = Sockets[0];
+    alignas(cmsghdr) char Control[CMSG_SPACE(sizeof(int))]{};
+    msghdr Header{};
+    Header.msg_iov = SendIOV;
+    Header.msg_iovlen = 1;
+    Header.msg_control = Control;
+    Header.msg_controllen = sizeof(Control);
+    cmsghdr *Message = CMSG_FIRSTHDR(&Header);
+    Message->cmsg_level = SOL_SOCKET;
+    Message->cmsg_type = SCM_RIGHTS;
+    Message->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(Message), &Passed, sizeof(int));
+
+    io_uring_sqe *SQE = Uring.GetSQE(4);
+    SQE->opcode = IORING_OP_SENDMSG;
+    SQE->fd = Sockets[0];
+    SQE->addr = reinterpret_cast<uintptr_t>(&Header);
+    SQE->user_data = 5;
+    CHECK(Uring.SubmitAndWait(SQE, Uring.FD) == (Is32Bit ? -EINVAL : SegmentSize));
+    CHECK(SQE->opcode == IORING_OP_SENDMSG);
+
+    if (!Is32Bit) {
+      char Receive[SegmentSize];
+      REQUIRE(recv(Sockets[1], Receive, sizeof(Receive), 0) == SegmentSize);
+    }
+  }
+
+  {
+    // The lengths written back to the msghdr on completion can't be converted
+    char Receive[SegmentSize];
+    iovec ReceiveIOV = {Receive, SegmentSize};
+    msghdr Header{};
+    Header.msg_iov = &ReceiveIOV;
+    Header.msg_iovlen = 1;
+    REQUIRE(send(Sockets[0], Send[0], SegmentSize, 0) == SegmentSize);
+
+    io_uring_sqe *SQE = Uring.GetSQE(5);
+    SQE->opcode = IORING_OP_RECVMSG;
+    SQE->fd = Sockets[1];
+    SQE->addr = reinterpret_cast<uintptr_t>(&Header);
+    SQE->user_data = 6;
+    CHECK(Uring.SubmitAndWait(SQE, Uring.FD) == (Is32Bit ? -EINVAL : SegmentSize));
+    CHECK(SQE->opcode == IORING_OP_RECVMSG);
+    CHECK(SQE->addr == reinterpret_cast<uintptr_t>(&Header));
+  }
+
+  close(Sockets[0]);
+  close(Sockets[1]);
+}
+
+TEST_CASE("io_uring: epoll_ctl") {
+  Ring Uring;
+  SKIP_IF_NO_IO_URING(Uring);
+
+  int Pipe[2];
+  REQUIRE(pipe(Pipe) == 0);
+  const int EpollFD = epoll_create1(EPOLL_CLOEXEC);
+  REQUIRE(EpollFD != -1);
+
+  // The 32-bit epoll_event is packed, the data has to come through the conversion intact
+  epoll_event Event{};
+  Event.events = EPOLLIN;
+  Event.data.u64 = 0xFEDC'BA98'7654'3210ULL;
+
+  io_uring_sqe *SQE = Uring.GetSQE(6);
+  SQE->opcode = IORING_OP_EPOLL_CTL;
+  SQE->fd = EpollFD;
+  SQE->len = EPOLL_CTL_ADD;
+  SQE->off = Pipe[0];
+  SQE->addr = reinterpret_cast<uintptr_t>(&Event);
+  SQE->user_data = 7;
+  const int32_t Result = Uring.SubmitAndWait(SQE, Uring.FD);
+  if (Result == -EINVAL && SQE->opcode == IORING_OP_EPOLL_CTL) {
+    // Older kernels don't have the opcode
+    printf("IORING_OP_EPOLL_CTL not supported\n");
+  }
+  else {
+    CHECK(Result == 0);
+    CHECK(SQE->addr == reinterpret_cast<uintptr_t>(&Event));
+
+    REQUIRE(write(Pipe[1], "x", 1) == 1);
+    epoll_event Ready{};
+    REQUIRE(epoll_wait(EpollFD, &Ready, 1, 1000) == 1);
+    CHECK(Ready.events == EPOLLIN);
+    CHECK(Ready.data.u64 == Event.data.u64);
+  }
+
+  close(EpollFD);
+  close(Pipe[0]);
+  close(Pipe[1]);
+}
+
+TEST_CASE("io_uring: buffers update") {
+  Ring Uring;
+  SKIP_IF_NO_IO_URING(Uring);
+
+  int Pipe[2];
+  REQUIRE(pipe(Pipe) == 0);
+
+  char First[SegmentSize];
+  char Second[SegmentSize];
+  memset(First, '1', SegmentSize);
+  memset(Second, '2', SegmentSize);
+
+  iovec Buffers[2] = {{First, SegmentSize}, {First, SegmentSize}};
+  io_uring_rsrc_register Register{};
+  Register.nr = 2;
+  Register.data = reinterpret_cast<uintptr_t>(Buffers);
+  if (::syscall(__NR_io_uring_register, Uring.FD, IORING_REGISTER_BUFFERS2, &Register, sizeof(Register)) != 0) {
+    // Needs 5.13
+    printf("IORING_REGISTER_BUFFERS2 failed: %s\n", strerror(errno));
+    close(Pipe[0]);
+    close(Pipe[1]);
+    return;
+  }
+
+  // Replaces the second buffer
+  iovec Update = {Second, SegmentSize};
+  io_uring_rsrc_update2 Update2{};
+  Update2.offset = 1;
+  Update2.data = reinterpret_cast<uintptr_t>(&Update);
+  Update2.nr = 1;
+  CHECK(::syscall(__NR_io_uring_register, Uring.FD, IORING_REGISTER_BUFFERS_UPDATE, &Update2, sizeof(Update2)) == 1);
+
+  io_uring_sqe *SQE = Uring.GetSQE(7);
+  SQE->opcode = IORING_OP_WRITE_FIXED;
+  SQE->fd = Pipe[1];
+  SQE->addr = reinterpret_cast<uintptr_t>(Second);
+  SQE->len = SegmentSize;
+  SQE->buf_index = 1;
+  SQE->user_data = 8;
+  CHECK(Uring.SubmitAndWait(SQE, Uring.FD) == SegmentSize);
+
+  char Data[SegmentSize];
+  REQUIRE(read(Pipe[0], Data, SegmentSize) == SegmentSize);
+  CHECK(memcmp(Data, Second, SegmentSize) == 0);
+
+  CHECK(::syscall(__NR_io_uring_register, Uring.FD, IORING_UNREGISTER_BUFFERS, nullptr, 0) == 0);
+  close(Pipe[0]);
+  close(Pipe[1]);
+}
+
+TEST_CASE("io_uring: moved SQE array") {
+  Ring Uring;
+  SKIP_IF_NO_IO_URING(Uring);
+
+  // Moves the SQEs to a new address, requests have to be found through the new mapping
+  void *Target = mmap(nullptr, Uring.SQEsSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  REQUIRE(Target != MAP_FAILED);
+  void *Moved = mremap(Uring.SQEs, Uring.SQEsSize, Uring.SQEsSize, MREMAP_MAYMOVE | MREMAP_FIXED, Target);
+  if (Moved == MAP_FAILED) {
+    // Some kernels don't let the ring mappings move
+    printf("mremap of the SQEs failed: %s\n", strerror(errno));
+    munmap(Target, Uring.SQEsSize);
+    return;
+  }
+  REQUIRE(Moved == Target);
+  Uring.SQEs = static_cast<io_uring_sqe*>(Moved);
+
+  int Pipe[2];
+  REQUIRE(pipe(Pipe) == 0);
+
+  char Send[NumSegments][SegmentSize];
+  iovec SendIOV[NumSegments];
+  for (size_t i = 0; i < NumSegments; ++i) {
+    memset(Send[i], 'p' + i, SegmentSize);
+    SendIOV[i] = {Send[i], SegmentSize};
+  }
+
+  io_uring_sqe *SQE = Uring.GetSQE(0);
+  SQE->opcode = IORING_OP_WRITEV;
+  SQE->fd = Pipe[1];
+  SQE->addr = reinterpret_cast<uintptr_t>(SendIOV);
+  SQE->len = NumSegments;
+  SQE->user_data = 9;
+  CHECK(Uring.SubmitAndWait(SQE, Uring.FD) == NumSegments * SegmentSize);
+  CHECK(SQE->addr == reinterpret_cast<uintptr_t>(SendIOV));
+
+  char Data[NumSegments * SegmentSize];
+  REQUIRE(read(Pipe[0], Data, sizeof(Data)) == sizeof(Data));
+  for (size_t i = 0; i < NumSegments; ++i) {
+    CHECK(memcmp(&Data[i * SegmentSize], Send[i], SegmentSize) == 0);
+  }
+
+  close(Pipe[0]);
+  close(Pipe[1]);
+}
@@ -0,0 +1,80 @@
+// FEX caches path lookups in a read-only rootfs, including the lookups that found nothing.
+// Mounting over a directory inside the rootfs has to invalidate them, as does unmounting it again.
+// Needs a rootfs and an unprivileged user and mount namespace, without either there is nothing to check.
+
+#include <catch2/catch.hpp>
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string>
+#include <sys/mount.h>
+#include <unistd.h>
+
+static bool Exists(const char *Path) {
+  return access(Path, F_OK) == 0;
+}
+
+static bool WriteFile(const char *Path, const std::string &Contents) {
+  const int FD = open(Path, O_WRONLY | O_CLOEXEC);
+  if (FD == -1) {
+    return false;
+  }
+  const bool Written = write(FD, Contents.data(), Contents.size()) == static_cast<ssize_t>(Contents.size());
+  close(FD);
+  return Written;
+}
+
+TEST_CASE("rootfs path cache: mounts invalidate lookups") {
+  // Opening /etc goes through the rootfs, the fd's link is where it really is
+  const int EtcFD = open("/etc", O_PATH | O_DIRECTORY | O_CLOEXEC);
+  REQUIRE(EtcFD != -1);
+  char FDPath[64];
+  snprintf(FDPath, sizeof(FDPath), "/proc/self/fd/%d", EtcFD);
+  char EtcPathBuffer[PATH_MAX]{};
+  const ssize_t Size = readlink(FDPath, EtcPathBuffer, sizeof(EtcPathBuffer) - 1);
+  close(EtcFD);
+  REQUIRE(Size > 0);
+
+  const std::string EtcPath(EtcPathBuffer, Size);
+  if (EtcPath == "/etc") {
+    WARN("/etc isn't in a rootfs");
+    return;
+  }
+
+  const uid_t Uid = getuid();
+  const gid_t Gid = getgid();
+  if (unshare(CLONE_NEWUSER | CLONE_NEWNS) != 0) {
+    WARN("Can't create a user and mount namespace");
+    return;
+  }
+  // The files created in the tmpfs need an owner that maps back out of the namespace
+  REQUIRE(WriteFile("/proc/self/setgroups", "deny"));
+  REQUIRE(WriteFile("/proc/self/uid_map", "0 " + std::to_string(Uid) + " 1"));
+  REQUIRE(WriteFile("/proc/self/gid_map", "0 " + std::to_string(Gid) + " 1"));
+  REQUIRE(mount(nullptr, "/", nullptr, MS_REC | MS_PRIVATE, nullptr) == 0);
+
+  constexpr const char *Marker = "/etc/fex-rootfs-path-cache-marker";
+  const std::string HostMarker = EtcPath + "/fex-rootfs-path-cache-marker";
+
+  // Looked up more than once so the miss is cached
+  for (int i = 0; i < 3; ++i) {
+    REQUIRE(!Exists(Marker));
+  }
+
+  REQUIRE(mount("tmpfs", EtcPath.c_str(), "tmpfs", 0, nullptr) == 0);
+  const int MarkerFD = open(HostMarker.c_str(), O_CREAT | O_WRONLY | O_CLOEXEC, 0644);
+  REQUIRE(MarkerFD != -1);
+  close(MarkerFD);
+
+  for (int i = 0; i < 3; ++i) {
+    CHECK(Exists(Marker));
+  }
+
+  REQUIRE(umount2(EtcPath.c_str(), MNT_DETACH) == 0);
+
+  for (int i = 0; i < 3; ++i) {
+    CHECK(!Exists(Marker));
+  }
+}
@@ -0,0 +1,275 @@
+// Event loop style syscalls where 32-bit guests need their arrays converted, each checked with one call.
+// The throughput of the same calls is measured by unittests/Benchmarks/Linux/syscall-rate.cpp.
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+
+constexpr int NumFDs = 64;
+
+// Every fd is readable and stays readable since nothing reads the counter
+struct ReadyFDs {
+  ReadyFDs() {
+    for (int i = 0; i < NumFDs; ++i) {
+      int FD = eventfd(1, EFD_CLOEXEC);
+      REQUIRE(FD != -1);
+      FDs.push_back(FD);
+    }
+  }
+
+  ~ReadyFDs() {
+    for (int FD : FDs) {
+      close(FD);
+    }
+  }
+
+  int MaxFD() const {
+    int Max = 0;
+    for (int FD : FDs) {
+      Max = FD > Max ? FD : Max;
+    }
+    return Max;
+  }
+
+  std::vector<int> FDs;
+};
+
+static uint64_t EventData(int i) {
+  // Uses both halves so a truncated or misplaced data field is noticed
+  return (static_cast<uint64_t>(0xFE00 + i) << 32) | static_cast<uint64_t>(i);
+}
+
+TEST_CASE("syscall arrays: epoll_wait") {
+  ReadyFDs Ready;
+  int EPFD = epoll_create1(EPOLL_CLOEXEC);
+  REQUIRE(EPFD != -1);
+
+  for (int i = 0; i < NumFDs; ++i) {
+    epoll_event Event{};
+    Event.events = EPOLLIN;
+    Event.data.u64 = EventData(i);
+    REQUIRE(epoll_ctl(EPFD, EPOLL_CTL_ADD, Ready.FDs[i], &Event) == 0);
+  }
+
+  epoll_event Events[NumFDs]{};
+  REQUIRE(epoll_wait(EPFD, Events, NumFDs, 0) == NumFDs);
+
+  uint64_t Seen{};
+  for (const auto &Event : Events) {
+    CHECK(Event.events == EPOLLIN);
+    const uint32_t Index = Event.data.u64 & 0xFFFF'FFFF;
+    REQUIRE(Index < NumFDs);
+    CHECK(Event.data.u64 == EventData(Index));
+    Seen |= 1ULL << Index;
+  }
+  CHECK(Seen == ~0ULL);
+
+  close(EPFD);
+}
+
+TEST_CASE("syscall arrays: poll") {
+  ReadyFDs Ready;
+  pollfd PollFDs[NumFDs]{};
+  for (int i = 0; i < NumFDs; ++i) {
+    PollFDs[i].fd = Ready.FDs[i];
+    PollFDs[i].events = POLLIN;
+  }
+
+  REQUIRE(poll(PollFDs, NumFDs, 0) == NumFDs);
+
+  for (const auto &PollFD : PollFDs) {
+    CHECK(PollFD.revents == POLLIN);
+  }
+}
+
+TEST_CASE("syscall arrays: select") {
+  ReadyFDs Ready;
+  const int NFDs = Ready.MaxFD() + 1;
+  REQUIRE(NFDs <= FD_SETSIZE);
+
+  fd_set Read;
+  FD_ZERO(&Read);
+  for (int FD : Ready.FDs) {
+    FD_SET(FD, &Read);
+  }
+
+  timeval Timeout{};
+  REQUIRE(select(NFDs, &Read, nullptr, nullptr, &Timeout) == NumFDs);
+
+  int Set = 0;
+  for (int FD = 0; FD < NFDs; ++FD) {
+    Set += FD_ISSET(FD, &Read) ? 1 : 0;
+  }
+  CHECK(Set == NumFDs);
+}
+
+TEST_CASE("syscall arrays: select with nfds past FD_SETSIZE") {
+  // The kernel takes sets of any size, glibc's fd_set just can't describe them
+  constexpr int HighFD = FD_SETSIZE + 40;
+  constexpr int NFDs = HighFD + 1;
+
+  rlimit Limit{};
+  REQUIRE(getrlimit(RLIMIT_NOFILE, &Limit) == 0);
+  if (Limit.rlim_max != RLIM_INFINITY && Limit.rlim_max < static_cast<rlim_t>(NFDs)) {
+    WARN("RLIMIT_NOFILE is too low to open an fd past FD_SETSIZE");
+    return;
+  }
+  if (Limit.rlim_cur != RLIM_INFINITY && Limit.rlim_cur < static_cast<rlim_t>(NFDs)) {
+    Limit.rlim_cur = NFDs;
+    REQUIRE(setrlimit(RLIMIT_NOFILE, &Limit) == 0);
+  }
+
+  // A readable fd either side of the glibc limit, and one past it that isn't readable
+  const int LowFD = eventfd(1, EFD_CLOEXEC);
+  REQUIRE(LowFD != -1);
+  REQUIRE(dup3(LowFD, HighFD, O_CLOEXEC) == HighFD);
+  int Pipe[2];
+  REQUIRE(pipe2(Pipe, O_CLOEXEC) == 0);
+  const int IdleFD = HighFD - 8;
+  REQUIRE(dup3(Pipe[0], IdleFD, O_CLOEXEC) == IdleFD);
+
+  uint32_t Read[(NFDs + 31) / 32]{};
+  auto Set = [&](int FD) { Read[FD / 32] |= 1U << (FD % 32); };
+  auto IsSet = [&](int FD) { return (Read[FD / 32] >> (FD % 32)) & 1; };
+  Set(LowFD);
+  Set(IdleFD);
+  Set(HighFD);
+
+  timeval Timeout{};
+  REQUIRE(::syscall(SYS__newselect, NFDs, Read, nullptr, nullptr, &Timeout) == 2);
+
+  CHECK(IsSet(LowFD));
+  CHECK(IsSet(HighFD));
+  CHECK(!IsSet(IdleFD));
+  int Count = 0;
+  for (int FD = 0; FD < NFDs; ++FD) {
+    Count += IsSet(FD);
+  }
+  CHECK(Count == 2);
+
+  close(IdleFD);
+  close(HighFD);
+  close(LowFD);
+  close(Pipe[0]);
+  close(Pipe[1]);
+}
+
+TEST_CASE("syscall arrays: readv and writev") {
+  int Pipe[2];
+  REQUIRE(pipe2(Pipe, O_CLOEXEC) == 0);
+
+  constexpr int NumIOVecs = 4;
+  constexpr size_t SegmentSize = 16;
+
+  char Write[NumIOVecs][SegmentSize];
+  char Read[NumIOVecs][SegmentSize]{};
+  iovec WriteIOV[NumIOVecs];
+  iovec ReadIOV[NumIOVecs];
+
+  // Reads in to the segments in reverse order to check every iovec is converted
+  for (int i = 0; i < NumIOVecs; ++i) {
+    memset(Write[i], 'a' + i, SegmentSize);
+    WriteIOV[i] = {Write[i], SegmentSize};
+    ReadIOV[i] = {Read[NumIOVecs - 1 - i], SegmentSize};
+  }
+
+  REQUIRE(writev(Pipe[1], WriteIOV, NumIOVecs) == NumIOVecs * SegmentSize);
+  REQUIRE(readv(Pipe[0], ReadIOV, NumIOVecs) == NumIOVecs * SegmentSize);
+
+  for (int i = 0; i < NumIOVecs; ++i) {
+    CHECK(memcmp(Read[NumIOVecs - 1 - i], Write[i], SegmentSize) == 0);
+    // The guest's iovec array is left alone
+    CHECK(ReadIOV[i].iov_base == Read[NumIOVecs - 1 - i]);
+    CHECK(ReadIOV[i].iov_len == SegmentSize);
+  }
+
+  close(Pipe[0]);
+  close(Pipe[1]);
+}
+
+TEST_CASE("syscall arrays: sendmsg and recvmsg") {
+  int Sockets[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, Sockets) == 0);
+
+  constexpr int NumIOVecs = 4;
+  constexpr size_t SegmentSize = 16;
+
+  char Send[NumIOVecs][SegmentSize];
+  char Receive[NumIOVecs][SegmentSize];
+  iovec SendIOV[NumIOVecs];
+  iovec ReceiveIOV[NumIOVecs];
+
+  // Receives in to the segments in reverse order to check every iovec is converted
+  for (int i = 0; i < NumIOVecs; ++i) {
+    memset(Send[i], 'a' + i, SegmentSize);
+    SendIOV[i] = {Send[i], SegmentSize};
+    ReceiveIOV[i] = {Receive[NumIOVecs - 1 - i], SegmentSize};
+  }
+
+  msghdr SendHeader{};
+  SendHeader.msg_iov = SendIOV;
+  SendHeader.msg_iovlen = NumIOVecs;
+
+  msghdr ReceiveHeader{};
+  ReceiveHeader.msg_iov = ReceiveIOV;
+  ReceiveHeader.msg_iovlen = NumIOVecs;
+
+  REQUIRE(sendmsg(Sockets[0], &SendHeader, 0) == NumIOVecs * SegmentSize);
+  REQUIRE(recvmsg(Sockets[1], &ReceiveHeader, 0) == NumIOVecs * SegmentSize);
+
+  for (int i = 0; i < NumIOVecs; ++i) {
+    CHECK(memcmp(Receive[NumIOVecs - 1 - i], Send[i], SegmentSize) == 0);
+    // The guest's iovec array is left alone
+    CHECK(ReceiveIOV[i].iov_base == Receive[NumIOVecs - 1 - i]);
+    CHECK(ReceiveIOV[i].iov_len == SegmentSize);
+  }
+
+  close(Sockets[0]);
+  close(Sockets[1]);
+}
+
+TEST_CASE("syscall arrays: sendmmsg and recvmmsg") {
+  int Sockets[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, Sockets) == 0);
+
+  constexpr int NumMessages = 8;
+  uint32_t Send[NumMessages];
+  uint32_t Receive[NumMessages]{};
+  iovec SendIOV[NumMessages];
+  iovec ReceiveIOV[NumMessages];
+  mmsghdr SendHeaders[NumMessages]{};
+  mmsghdr ReceiveHeaders[NumMessages]{};
+
+  for (int i = 0; i < NumMessages; ++i) {
+    Send[i] = 0xCAFE'0000 + i;
+    SendIOV[i] = {&Send[i], sizeof(Send[i])};
+    ReceiveIOV[i] = {&Receive[i], sizeof(Receive[i])};
+    SendHeaders[i].msg_hdr.msg_iov = &SendIOV[i];
+    SendHeaders[i].msg_hdr.msg_iovlen = 1;
+    ReceiveHeaders[i].msg_hdr.msg_iov = &ReceiveIOV[i];
+    ReceiveHeaders[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  REQUIRE(sendmmsg(Sockets[0], SendHeaders, NumMessages, 0) == NumMessages);
+  REQUIRE(recvmmsg(Sockets[1], ReceiveHeaders, NumMessages, 0, nullptr) == NumMessages);
+
+  for (int i = 0; i < NumMessages; ++i) {
+    CHECK(ReceiveHeaders[i].msg_len == sizeof(uint32_t));
+    CHECK(Receive[i] == Send[i]);
+  }
+
+  close(Sockets[0]);
+  close(Sockets[1]);
+}
@@ -0,0 +1,87 @@
+// Runs a block of JIT code and prints its address, then leaves FEX's buffered symbol for it in a state where it
+// used to be lost or written twice.
+// Scripts/jit_symbols_runner.py picks the test case and checks the perf map, run on their own these are skipped.
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+extern char **environ;
+
+// Generated at runtime so it isn't part of any file, FEX names its block JIT_0x<address>
+static void RunMarkerBlock() {
+  const size_t PageSize = sysconf(_SC_PAGESIZE);
+  void *Page = mmap(nullptr, PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  REQUIRE(Page != MAP_FAILED);
+
+  // mov eax, 42; ret
+  constexpr uint8_t Code[] = {0xB8, 0x2A, 0x00, 0x00, 0x00, 0xC3};
+  memcpy(Page, Code, sizeof(Code));
+  REQUIRE(mprotect(Page, PageSize, PROT_READ | PROT_EXEC) == 0);
+  REQUIRE(reinterpret_cast<int (*)()>(Page)() == 42);
+
+  printf("Marker: 0x%lx\n", static_cast<unsigned long>(reinterpret_cast<uintptr_t>(Page)));
+  fflush(stdout);
+}
+
+TEST_CASE("jit symbols: idle", "[.]") {
+  RunMarkerBlock();
+
+  // Blocks without compiling anything until the runner has seen the symbol
+  char Byte;
+  CHECK(read(STDIN_FILENO, &Byte, 1) == 0);
+}
+
+TEST_CASE("jit symbols: exec", "[.]") {
+  RunMarkerBlock();
+
+  // The new image mustn't name its blocks, it would truncate the perf map of the same pid
+  std::vector<char*> Env;
+  for (char **Var = environ; *Var; ++Var) {
+    if (strncmp(*Var, "FEX_BLOCKJITNAMING=", strlen("FEX_BLOCKJITNAMING=")) != 0) {
+      Env.push_back(*Var);
+    }
+  }
+  char NoNaming[] = "FEX_BLOCKJITNAMING=0";
+  Env.push_back(NoNaming);
+  Env.push_back(nullptr);
+
+  char Program[] = "jit-symbols";
+  char TestCase[] = "jit symbols: exec target";
+  char *const Args[] = {Program, TestCase, nullptr};
+  execve("/proc/self/exe", Args, Env.data());
+  FAIL("execve failed");
+}
+
+TEST_CASE("jit symbols: exec target", "[.]") {
+  SUCCEED();
+}
+
+TEST_CASE("jit symbols: crash", "[.]") {
+  RunMarkerBlock();
+
+  volatile int *Null = nullptr;
+  *Null = 0;
+}
+
+TEST_CASE("jit symbols: fork", "[.]") {
+  RunMarkerBlock();
+
+  // The child exiting must not write the parent's buffered symbol as well
+  const pid_t Child = fork();
+  REQUIRE(Child != -1);
+  if (Child == 0) {
+    _exit(0);
+  }
+
+  int Status{};
+  REQUIRE(waitpid(Child, &Status, 0) == Child);
+  CHECK(WIFEXITED(Status));
+  CHECK(WEXITSTATUS(Status) == 0);
+}
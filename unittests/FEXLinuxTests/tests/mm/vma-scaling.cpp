@@ -0,0 +1,131 @@
+// Mapping churn and SMC faults across a large number of mappings, with an increasing number of threads.
+// Every operation goes through FEX's VMA tracking, the rates are printed to compare how well it scales.
+// Sized to run with the rest of the tests, raise the constants locally for a meaningful rate.
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+constexpr size_t NumMappings = 2048;
+constexpr int Iterations = 200;
+constexpr int MaxThreads = 4;
+
+// One page per mapping, with alternating protections so neighbouring mappings never merge
+struct Mappings {
+  Mappings() {
+    PageSize = sysconf(_SC_PAGESIZE);
+    Pages.reserve(NumMappings);
+
+    const auto Start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < NumMappings; ++i) {
+      const int Prot = (i & 1) ? PROT_READ : PROT_READ | PROT_WRITE;
+      void *Page = mmap(nullptr, PageSize, Prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      REQUIRE(Page != MAP_FAILED);
+      Pages.push_back(static_cast<uint8_t*>(Page));
+    }
+    const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+    printf("mmap: %zu mappings in %.3f s (%.0f calls/s)\n", NumMappings, Seconds, NumMappings / Seconds);
+  }
+
+  ~Mappings() {
+    const auto Start = std::chrono::steady_clock::now();
+    for (auto Page : Pages) {
+      munmap(Page, PageSize);
+    }
+    const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+    printf("munmap: %zu mappings in %.3f s (%.0f calls/s)\n", NumMappings, Seconds, NumMappings / Seconds);
+  }
+
+  size_t PageSize;
+  std::vector<uint8_t*> Pages;
+};
+
+// Runs Body(Thread, Iteration) on every thread and prints the combined rate
+// Catch2 assertions aren't thread safe, so Body returns false on failure and the failures are checked once the threads are joined
+template<typename Fn>
+static void MeasureThreads(const char *Name, int Threads, Fn &&Body) {
+  std::atomic<int> Ready{};
+  std::vector<std::thread> Workers;
+  std::vector<int> Failures(Threads);
+
+  const auto Start = std::chrono::steady_clock::now();
+  for (int t = 0; t < Threads; ++t) {
+    Workers.emplace_back([&, t]() {
+      ++Ready;
+      while (Ready.load() != Threads);
+
+      for (int i = 0; i < Iterations; ++i) {
+        if (!Body(t, i)) {
+          ++Failures[t];
+        }
+      }
+    });
+  }
+
+  for (auto &Worker : Workers) {
+    Worker.join();
+  }
+  const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+  const int Total = Threads * Iterations;
+  printf("%s, %d threads: %d ops in %.3f s (%.0f ops/s)\n", Name, Threads, Total, Seconds, Total / Seconds);
+
+  for (int t = 0; t < Threads; ++t) {
+    INFO(Name << ", " << Threads << " threads, thread " << t);
+    CHECK(Failures[t] == 0);
+  }
+}
+
+TEST_CASE("vma scaling: mprotect") {
+  Mappings Maps;
+
+  for (int Threads = 1; Threads <= MaxThreads; Threads *= 2) {
+    // Each thread toggles the even, writable, pages in its own slice of the mappings
+    const size_t Slice = NumMappings / Threads;
+    MeasureThreads("mprotect", Threads, [&](int Thread, int Iteration) {
+      uint8_t *Page = Maps.Pages[Thread * Slice + ((Iteration * 2) % Slice)];
+      return mprotect(Page, Maps.PageSize, PROT_READ) == 0 &&
+             mprotect(Page, Maps.PageSize, PROT_READ | PROT_WRITE) == 0;
+    });
+  }
+
+  // The tracked protections still allow writing to the writable pages
+  for (size_t i = 0; i < NumMappings; i += 2) {
+    Maps.Pages[i][0] = static_cast<uint8_t>(i);
+  }
+  for (size_t i = 0; i < NumMappings; i += 2) {
+    CHECK(Maps.Pages[i][0] == static_cast<uint8_t>(i));
+  }
+}
+
+TEST_CASE("vma scaling: SMC faults") {
+  Mappings Maps;
+
+  // A page per thread, somewhere in the middle of the mappings
+  uint8_t *Code[MaxThreads];
+  for (int t = 0; t < MaxThreads; ++t) {
+    Code[t] = Maps.Pages[(t * 2 + 1) * (NumMappings / (MaxThreads * 2)) & ~size_t{1}];
+    REQUIRE(mprotect(Code[t], Maps.PageSize, PROT_READ | PROT_WRITE | PROT_EXEC) == 0);
+  }
+
+  for (int Threads = 1; Threads <= MaxThreads; Threads *= 2) {
+    // Running the code write protects the page, writing it again then faults and looks up the mapping
+    MeasureThreads("smc fault", Threads, [&](int Thread, int Iteration) {
+      uint8_t *Page = Code[Thread];
+      // mov eax, Iteration; ret
+      Page[0] = 0xB8;
+      memcpy(&Page[1], &Iteration, sizeof(Iteration));
+      Page[5] = 0xC3;
+
+      auto Fn = reinterpret_cast<int (*)()>(Page);
+      return Fn() == Iteration;
+    });
+  }
+}
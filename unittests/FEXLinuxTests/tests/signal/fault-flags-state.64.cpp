@@ -0,0 +1,87 @@
+// A fault in the middle of a block has to see the flags set by the instructions before it in the same block.
+// The JIT keeps CF, ZF, SF and OF in registers within a block, they must reach the signal frame and come back from it.
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <signal.h>
+#include <ucontext.h>
+
+extern "C" {
+  extern char FlagsFaultInstruction[];
+
+  // Sets RFLAGS to Flags, faults on a load from Address, then returns RFLAGS after the fault.
+  // The test after the fault overwrites the flags again in the same block, DF is cleared before returning.
+  uint64_t SetFlagsAndFault(uint64_t *Address, uint64_t Flags);
+}
+
+__attribute__((naked, nocf_check))
+uint64_t SetFlagsAndFault(uint64_t *Address, uint64_t Flags) {
+  __asm volatile(R"(
+  push %rsi;
+  popfq;
+  FlagsFaultInstruction:
+  mov (%rdi), %ecx;
+  pushfq;
+  pop %rax;
+  test %eax, %eax;
+  cld;
+  ret;
+  )");
+}
+
+// CF, PF, AF, ZF, SF, DF and OF
+constexpr uint64_t FLAGS_MASK = 0xCD5;
+// Reserved bit and IF
+constexpr uint64_t FLAGS_FIXED = 0x202;
+// Length of the faulting mov
+constexpr greg_t FAULT_INSTRUCTION_SIZE = 2;
+
+static volatile bool Handled{};
+static volatile uint64_t HandlerFlags{};
+static volatile uint64_t RestoredFlags{};
+
+static void Handler(int, siginfo_t *, void *ucontext) {
+  auto Context = reinterpret_cast<ucontext_t*>(ucontext);
+  if (Context->uc_mcontext.gregs[REG_RIP] != reinterpret_cast<greg_t>(FlagsFaultInstruction)) {
+    return;
+  }
+
+  HandlerFlags = Context->uc_mcontext.gregs[REG_EFL];
+  Context->uc_mcontext.gregs[REG_EFL] = (Context->uc_mcontext.gregs[REG_EFL] & ~FLAGS_MASK) | RestoredFlags;
+  Context->uc_mcontext.gregs[REG_RIP] += FAULT_INSTRUCTION_SIZE;
+  Handled = true;
+}
+
+// Spreads the seven bits of Index over the bits of FLAGS_MASK
+static uint64_t FlagsFromIndex(uint32_t Index) {
+  uint64_t Flags{};
+  uint32_t Bit{};
+  for (uint32_t i = 0; i < 64; ++i) {
+    if (FLAGS_MASK & (1ULL << i)) {
+      Flags |= static_cast<uint64_t>((Index >> Bit++) & 1) << i;
+    }
+  }
+  return Flags;
+}
+
+TEST_CASE("Fault sees and restores flags from the same block") {
+  struct sigaction act{};
+  act.sa_sigaction = Handler;
+  act.sa_flags = SA_SIGINFO;
+  REQUIRE(sigaction(SIGSEGV, &act, nullptr) == 0);
+
+  for (uint32_t i = 0; i < (1U << 7); ++i) {
+    const uint64_t Flags = FlagsFromIndex(i);
+    // The handler returns with the inverse flags
+    RestoredFlags = ~Flags & FLAGS_MASK;
+    Handled = false;
+
+    const uint64_t Result = SetFlagsAndFault(nullptr, Flags | FLAGS_FIXED);
+
+    REQUIRE(Handled);
+    CHECK((HandlerFlags & FLAGS_MASK) == Flags);
+    CHECK((HandlerFlags & FLAGS_FIXED) == FLAGS_FIXED);
+    CHECK((Result & FLAGS_MASK) == RestoredFlags);
+  }
+}
@@ -0,0 +1,54 @@
+// High frequency SIGPROF timer while the guest hammers syscalls that take FEX's signal-deferring locks.
+// Checks that signals keep being delivered and reports the throughput to compare signal handling overhead.
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <stdio.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+static volatile sig_atomic_t SignalCount = 0;
+
+static void sigprof_handler(int) {
+  SignalCount = SignalCount + 1;
+}
+
+TEST_CASE("setitimer: SIGPROF storm over mmap") {
+  struct sigaction act {};
+  act.sa_handler = &sigprof_handler;
+  act.sa_flags = SA_RESTART;
+  REQUIRE(sigaction(SIGPROF, &act, nullptr) == 0);
+
+  // Asks for 20 kHz, the kernel clamps this to its tick rate
+  itimerval timer {};
+  timer.it_interval.tv_usec = 50;
+  timer.it_value.tv_usec = 50;
+  REQUIRE(setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+
+  constexpr int TargetSignals = 500;
+  constexpr size_t Size = 4096 * 4;
+
+  size_t Iterations = 0;
+  const auto Start = std::chrono::steady_clock::now();
+  while (SignalCount < TargetSignals) {
+    // mmap, mprotect and munmap all go through FEX's VMA tracking with signals deferred
+    void *Ptr = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    REQUIRE(Ptr != MAP_FAILED);
+    memset(Ptr, static_cast<int>(Iterations), Size);
+    REQUIRE(mprotect(Ptr, Size, PROT_READ) == 0);
+    REQUIRE(munmap(Ptr, Size) == 0);
+    ++Iterations;
+  }
+  const auto End = std::chrono::steady_clock::now();
+
+  timer = {};
+  REQUIRE(setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+
+  const double Seconds = std::chrono::duration<double>(End - Start).count();
+  printf("%d signals, %zu iterations in %.3f s (%.0f iterations/s)\n", static_cast<int>(SignalCount), Iterations, Seconds, Iterations / Seconds);
+
+  CHECK(SignalCount >= TargetSignals);
+}
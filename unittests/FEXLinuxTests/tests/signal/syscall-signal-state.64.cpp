@@ -0,0 +1,175 @@
+// A signal interrupting a blocking syscall has to see the guest registers from the point of the syscall.
+// The JIT can call syscall handlers without leaving the code buffer, which must not leave the state stale.
+// The syscalls that take that path also have to return their results and leave the registers alone when nothing interrupts them.
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <errno.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+constexpr uint64_t EXPECTED_RBX = 0x1111'2222'3333'4444ULL;
+constexpr uint64_t EXPECTED_R12 = 0x5555'6666'7777'8888ULL;
+constexpr uint64_t EXPECTED_R13 = 0x9999'AAAA'BBBB'CCCCULL;
+constexpr uint64_t EXPECTED_R14 = 0xDDDD'EEEE'FFFF'0000ULL;
+constexpr uint64_t EXPECTED_R15 = 0x0123'4567'89AB'CDEFULL;
+
+static volatile bool Handled{};
+static greg_t HandlerRegs[NGREG]{};
+
+static void Handler(int, siginfo_t *, void *ucontext) {
+  auto Context = reinterpret_cast<ucontext_t*>(ucontext);
+  for (int i = 0; i < NGREG; ++i) {
+    HandlerRegs[i] = Context->uc_mcontext.gregs[i];
+  }
+  Handled = true;
+}
+
+// Waits on the futex until the timer signal interrupts it, with known values in the callee saved registers
+static int64_t FutexWaitWithRegisters(uint32_t *Futex, const timespec *Timeout) {
+  register uint64_t rax asm("rax") = SYS_futex;
+  register uint64_t rdi asm("rdi") = reinterpret_cast<uint64_t>(Futex);
+  register uint64_t rsi asm("rsi") = FUTEX_WAIT_PRIVATE;
+  register uint64_t rdx asm("rdx") = *Futex;
+  register uint64_t r10 asm("r10") = reinterpret_cast<uint64_t>(Timeout);
+  register uint64_t rbx asm("rbx") = EXPECTED_RBX;
+  register uint64_t r12 asm("r12") = EXPECTED_R12;
+  register uint64_t r13 asm("r13") = EXPECTED_R13;
+  register uint64_t r14 asm("r14") = EXPECTED_R14;
+  register uint64_t r15 asm("r15") = EXPECTED_R15;
+
+  __asm volatile("syscall"
+    : "+r"(rax), "+r"(rbx), "+r"(r12), "+r"(r13), "+r"(r14), "+r"(r15)
+    : "r"(rdi), "r"(rsi), "r"(rdx), "r"(r10)
+    : "rcx", "r11", "memory");
+
+  return rax;
+}
+
+TEST_CASE("Signal during blocking syscall sees current registers") {
+  struct sigaction act{};
+  act.sa_sigaction = Handler;
+  // No SA_RESTART, the futex wait returns EINTR once the handler has run
+  act.sa_flags = SA_SIGINFO;
+  REQUIRE(sigaction(SIGALRM, &act, nullptr) == 0);
+
+  itimerval Timer{};
+  Timer.it_value.tv_usec = 10'000;
+  REQUIRE(setitimer(ITIMER_REAL, &Timer, nullptr) == 0);
+
+  uint32_t Futex{};
+  const timespec Timeout{5, 0};
+  const int64_t Result = FutexWaitWithRegisters(&Futex, &Timeout);
+
+  REQUIRE(Result == -EINTR);
+  REQUIRE(Handled);
+  CHECK(HandlerRegs[REG_RBX] == EXPECTED_RBX);
+  CHECK(HandlerRegs[REG_R12] == EXPECTED_R12);
+  CHECK(HandlerRegs[REG_R13] == EXPECTED_R13);
+  CHECK(HandlerRegs[REG_R14] == EXPECTED_R14);
+  CHECK(HandlerRegs[REG_R15] == EXPECTED_R15);
+}
+
+struct CalleeSaved {
+  uint64_t rbx, r12, r13, r14, r15;
+};
+
+// Issues a three argument syscall with known values in the callee saved registers and returns what they held afterwards
+static int64_t SyscallWithRegisters(uint64_t Number, uint64_t Arg0, uint64_t Arg1, uint64_t Arg2, CalleeSaved *After) {
+  register uint64_t rax asm("rax") = Number;
+  register uint64_t rdi asm("rdi") = Arg0;
+  register uint64_t rsi asm("rsi") = Arg1;
+  register uint64_t rdx asm("rdx") = Arg2;
+  register uint64_t r10 asm("r10") = 0;
+  register uint64_t r8 asm("r8") = 0;
+  register uint64_t r9 asm("r9") = 0;
+  register uint64_t rbx asm("rbx") = EXPECTED_RBX;
+  register uint64_t r12 asm("r12") = EXPECTED_R12;
+  register uint64_t r13 asm("r13") = EXPECTED_R13;
+  register uint64_t r14 asm("r14") = EXPECTED_R14;
+  register uint64_t r15 asm("r15") = EXPECTED_R15;
+
+  __asm volatile("syscall"
+    : "+r"(rax), "+r"(rbx), "+r"(r12), "+r"(r13), "+r"(r14), "+r"(r15)
+    : "r"(rdi), "r"(rsi), "r"(rdx), "r"(r10), "r"(r8), "r"(r9)
+    : "rcx", "r11", "memory");
+
+  *After = {rbx, r12, r13, r14, r15};
+  return rax;
+}
+
+static void CheckCalleeSaved(const CalleeSaved &After) {
+  CHECK(After.rbx == EXPECTED_RBX);
+  CHECK(After.r12 == EXPECTED_R12);
+  CHECK(After.r13 == EXPECTED_R13);
+  CHECK(After.r14 == EXPECTED_R14);
+  CHECK(After.r15 == EXPECTED_R15);
+}
+
+TEST_CASE("Direct syscall: futex wake") {
+  uint32_t Futex{};
+  CalleeSaved After{};
+
+  // Nothing is waiting, so this returns straight away
+  CHECK(SyscallWithRegisters(SYS_futex, reinterpret_cast<uint64_t>(&Futex), FUTEX_WAKE_PRIVATE, 1, &After) == 0);
+  CheckCalleeSaved(After);
+}
+
+TEST_CASE("Direct syscall: futex wait on a changed value") {
+  uint32_t Futex{1};
+  CalleeSaved After{};
+
+  // The value doesn't match, so this returns straight away
+  CHECK(SyscallWithRegisters(SYS_futex, reinterpret_cast<uint64_t>(&Futex), FUTEX_WAIT_PRIVATE, 0, &After) == -EAGAIN);
+  CheckCalleeSaved(After);
+}
+
+TEST_CASE("Direct syscall: epoll_wait") {
+  const int EPFD = epoll_create1(EPOLL_CLOEXEC);
+  REQUIRE(EPFD != -1);
+  int Pipe[2]{};
+  REQUIRE(pipe(Pipe) == 0);
+
+  epoll_event Event{};
+  Event.events = EPOLLIN;
+  Event.data.u64 = 0x1234'5678'9ABC'DEF0ULL;
+  REQUIRE(epoll_ctl(EPFD, EPOLL_CTL_ADD, Pipe[0], &Event) == 0);
+
+  // Nothing written yet, times out straight away
+  // x86-64 epoll_wait has its timeout in r10, which SyscallWithRegisters passes as 0
+  epoll_event Events[2]{};
+  CalleeSaved After{};
+  CHECK(SyscallWithRegisters(SYS_epoll_wait, EPFD, reinterpret_cast<uint64_t>(Events), 2, &After) == 0);
+  CheckCalleeSaved(After);
+
+  REQUIRE(write(Pipe[1], "x", 1) == 1);
+  CHECK(SyscallWithRegisters(SYS_epoll_wait, EPFD, reinterpret_cast<uint64_t>(Events), 2, &After) == 1);
+  CheckCalleeSaved(After);
+  CHECK(Events[0].events == EPOLLIN);
+  CHECK(Events[0].data.u64 == 0x1234'5678'9ABC'DEF0ULL);
+
+  close(Pipe[0]);
+  close(Pipe[1]);
+  close(EPFD);
+}
+
+TEST_CASE("Exit path syscall: mmap and munmap") {
+  const size_t PageSize = sysconf(_SC_PAGESIZE);
+
+  void *Page = mmap(nullptr, PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  REQUIRE(Page != MAP_FAILED);
+  *static_cast<volatile uint8_t*>(Page) = 1;
+  CHECK(*static_cast<volatile uint8_t*>(Page) == 1);
+
+  CalleeSaved After{};
+  CHECK(SyscallWithRegisters(SYS_munmap, reinterpret_cast<uint64_t>(Page), PageSize, 0, &After) == 0);
+  CheckCalleeSaved(After);
+}
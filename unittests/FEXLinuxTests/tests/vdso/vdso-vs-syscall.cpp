@@ -0,0 +1,68 @@
+// Time reads through the vDSO against the same reads as plain syscalls.
+// Under FEX the vDSO calls are thunked to the host vDSO, each is checked once against the syscall.
+// The throughput of both paths is measured by unittests/Benchmarks/Linux/vdso-rate.cpp.
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t ToNanoseconds(const timespec &Time) {
+  return static_cast<uint64_t>(Time.tv_sec) * 1'000'000'000ULL + Time.tv_nsec;
+}
+
+TEST_CASE("vdso vs syscall: clock_gettime(CLOCK_MONOTONIC)") {
+  timespec Before{}, VDSO{}, After{};
+
+  // glibc goes through the vDSO for this
+  REQUIRE(::syscall(SYS_clock_gettime, CLOCK_MONOTONIC, &Before) == 0);
+  REQUIRE(clock_gettime(CLOCK_MONOTONIC, &VDSO) == 0);
+  REQUIRE(::syscall(SYS_clock_gettime, CLOCK_MONOTONIC, &After) == 0);
+
+  CHECK(VDSO.tv_nsec < 1'000'000'000);
+  CHECK(ToNanoseconds(VDSO) >= ToNanoseconds(Before));
+  CHECK(ToNanoseconds(VDSO) <= ToNanoseconds(After));
+}
+
+TEST_CASE("vdso vs syscall: gettimeofday") {
+  timeval VDSO{}, Syscall{};
+
+  REQUIRE(gettimeofday(&VDSO, nullptr) == 0);
+  REQUIRE(::syscall(SYS_gettimeofday, &Syscall, nullptr) == 0);
+
+  CHECK(VDSO.tv_usec < 1'000'000);
+  CHECK(Syscall.tv_usec < 1'000'000);
+
+  // CLOCK_REALTIME is allowed to step backwards, only check the two agree to within a second
+  const int64_t VDSOMicroseconds = static_cast<int64_t>(VDSO.tv_sec) * 1'000'000 + VDSO.tv_usec;
+  const int64_t SyscallMicroseconds = static_cast<int64_t>(Syscall.tv_sec) * 1'000'000 + Syscall.tv_usec;
+  CHECK(VDSOMicroseconds != 0);
+  CHECK(SyscallMicroseconds - VDSOMicroseconds < 1'000'000);
+  CHECK(VDSOMicroseconds - SyscallMicroseconds < 1'000'000);
+}
+
+TEST_CASE("vdso vs syscall: time") {
+  const time_t Syscall = ::syscall(SYS_time, nullptr);
+  time_t Stored{};
+  const time_t VDSO = time(&Stored);
+
+  CHECK(VDSO == Stored);
+  CHECK(VDSO >= Syscall);
+  CHECK(VDSO - Syscall <= 1);
+}
+
+TEST_CASE("vdso vs syscall: getcpu") {
+  const long NumCPUs = sysconf(_SC_NPROCESSORS_CONF);
+
+  const int CPU = sched_getcpu();
+  CHECK(CPU >= 0);
+  CHECK(CPU < NumCPUs);
+
+  unsigned SyscallCPU{};
+  REQUIRE(::syscall(SYS_getcpu, &SyscallCPU, nullptr, nullptr) == 0);
+  CHECK(SyscallCPU < static_cast<unsigned long>(NumCPUs));
+}